@@ -1,101 +1,91 @@
 #include "Bullet.h"
-#include <cmath>
+#include "ProjectileSystem.h"
 #include <cassert>
 
-void Bullet::Initialize(KamataEngine::Model* model, KamataEngine::Camera* camera, const KamataEngine::Vector3& position, const KamataEngine::Vector3& direction) {
+// 中身はすべて ProjectileSystem の配列にある。ハンドルから並びの位置を引いて読み書きする
 
-	// NULLチェック
-	assert(model);
+bool Bullet::IsValid() const { return system_ && system_->Find(handle_) != SlotMap::kInvalid; }
 
-	// 引数として受け取ったデータをメンバ変数に格納
-	modelBullet_ = model;
-	camera_ = camera;
-
-	// ワールド変換の初期化
-	worldTransformBullet_.Initialize();
-
-	// 位置
-	worldTransformBullet_.translation_ = position;
-
-	// スケール
-	worldTransformBullet_.scale_ = {0.2f, 0.2f, 0.2f};
-
-	// 速度
-	velocity_ = direction * kBulletSpeed;
-
-	isShot_ = true;
-
-	// 追加: 初期位置での弾の傾き設定
-	SetRotationFromDirection(direction);
+KamataEngine::Vector3 Bullet::GetPosition() const {
+	assert(IsValid());
+	const uint32_t i = system_->Find(handle_);
+	return {system_->posX_[i], system_->posY_[i], system_->posZ_[i]};
 }
 
-void Bullet::Update() {
+KamataEngine::Vector3 Bullet::GetSpeed() const {
+	assert(IsValid());
+	const uint32_t i = system_->Find(handle_);
+	return {system_->velX_[i], system_->velY_[i], system_->velZ_[i]};
+}
 
-	if (!isShot_) {
-		return;
+bool Bullet::IsDead() const {
+	if (!IsValid()) {
+		return true;
 	}
+	return system_->flags_[system_->Find(handle_)] & ProjectileSystem::kDead;
+}
 
-	// 移動
-	worldTransformBullet_.translation_ += velocity_;
-
-	// 寿命減少
-	if (!persistent_) {
-		lifeTime_ -= 1.0f / 60.0f;
-		if (lifeTime_ <= 0.0f) {
-			isDead_ = true;
-		}
+void Bullet::Kill() {
+	if (!IsValid()) {
+		return;
 	}
+	system_->flags_[system_->Find(handle_)] |= ProjectileSystem::kDead;
+}
 
-	// マップ壁に当たったら消滅
-	if (mapChipField_) {
-
-		auto index = mapChipField_->GetMapChipIndexSetByPosition(worldTransformBullet_.translation_);
-
-		auto type = mapChipField_->GetMapChipTypeByIndex(index.xIndex, index.yIndex);
+void Bullet::SetPosition(const KamataEngine::Vector3& pos) {
+	assert(IsValid());
+	const uint32_t i = system_->Find(handle_);
+	system_->posX_[i] = pos.x;
+	system_->posY_[i] = pos.y;
+	system_->posZ_[i] = pos.z;
+}
 
-		if (type == MapChipType::kBlock) {
-			if (persistent_) {
-				// ワイヤー弾：ブロックに刺さって停止する（以後描画は残す）
-				velocity_ = {0.0f, 0.0f, 0.0f};
-				hooked_ = true;
-			} else {
-				// 通常弾は消える
-				isDead_ = true;
-			}
-		}
+void Bullet::SetPersistent(bool p) {
+	assert(IsValid());
+	const uint32_t i = system_->Find(handle_);
+	if (p) {
+		system_->flags_[i] |= ProjectileSystem::kPersistent;
+		system_->lifeDecay_[i] = 0.0f;
+	} else {
+		system_->flags_[i] &= static_cast<uint8_t>(~ProjectileSystem::kPersistent);
+		system_->lifeDecay_[i] = ProjectileSystem::kLifeDecay;
 	}
-
-	// 行列の変換と転送
-	worldTransformUpdate(worldTransformBullet_);
 }
 
-void Bullet::Draw() {
-
-	// モデルの描画
-	if (isShot_ && !isDead_) {
-
-		modelBullet_->Draw(worldTransformBullet_, *camera_);
+void Bullet::SetSwept(bool s) {
+	assert(IsValid());
+	const uint32_t i = system_->Find(handle_);
+	if (s) {
+		system_->flags_[i] |= ProjectileSystem::kSwept;
+	} else {
+		system_->flags_[i] &= static_cast<uint8_t>(~ProjectileSystem::kSwept);
 	}
 }
 
-void Bullet::worldTransformUpdate(KamataEngine::WorldTransform& worldtransfrom) {
+bool Bullet::IsHooked() const {
+	assert(IsValid());
+	return system_->flags_[system_->Find(handle_)] & ProjectileSystem::kHooked;
+}
 
-	// スケール、回転、平行移動を合成して変換
-	worldtransfrom.matWorld_ = math.MakeAffineMatrix(worldtransfrom.scale_, worldtransfrom.rotation_, worldtransfrom.translation_);
+void Bullet::SetVelocity(const KamataEngine::Vector3& v) {
+	assert(IsValid());
+	const uint32_t i = system_->Find(handle_);
+	system_->velX_[i] = v.x;
+	system_->velY_[i] = v.y;
+	system_->velZ_[i] = v.z;
+}
 
-	// 定数バッファに転送
-	worldtransfrom.TransferMatrix();
+void Bullet::SetScale(const KamataEngine::Vector3& s) {
+	assert(IsValid());
+	system_->scales_[system_->Find(handle_)] = s;
 }
 
-// 追加: 方向ベクトルに合わせて弾を傾ける
 void Bullet::SetRotationFromDirection(const KamataEngine::Vector3& dir) {
-	// ベクトル長がゼロに近い場合は処理しない
-	if (math.Length(dir) < 1e-6f) return;
-
-	// 正規化して角度を算出（XY平面を想定）
-	KamataEngine::Vector3 nd = math.Normalize(dir);
-	float angle = atan2f(nd.y, nd.x); // +x を基準に反時計回りの角度（ラジアン）
+	assert(IsValid());
+	system_->SetRotationFromDirection(system_->Find(handle_), dir);
+}
 
-	// モデルが +X 方向を前方としている想定で Z 回転を設定
-	worldTransformBullet_.rotation_.z = angle;
+KamataEngine::Model* Bullet::GetModel() const {
+	assert(IsValid());
+	return system_->models_[system_->Find(handle_)];
 }
@@ -1,97 +1,59 @@
 #pragma once
 #include "KamataEngine.h"
-#include "MapChipField.h"
-#include "Math.h"
+#include "SlotMap.h"
+#include <cstdint>
 
+class ProjectileSystem;
+
+/// <summary>
+/// 弾のハンドル（中身は ProjectileSystem の配列にあり、ここにはスロット番号と世代だけを持つ）
+/// 弾が返されると無効になる（スロットが別の弾に使い回されても世代が違うので、前の弾のハンドルは無効のまま）
+/// </summary>
 class Bullet {
 public:
-	/// <summary>
-	///	初期化
-	/// </summary>
-	/// <param name="model">モデル</param>
-	/// <param name="camera">カメラ</param>
-	/// <param name="position">位置</param>
-	void Initialize(KamataEngine::Model* model, KamataEngine::Camera* camera, const KamataEngine::Vector3& position, const KamataEngine::Vector3& direction);
-
-	/// <summary>
-	/// 更新処理
-	/// </summary>
-	void Update();
-
-	/// <summary>
-	/// 描画処理
-	/// </summary>
-	void Draw();
-
-	/// <summary>
-	/// ワールド変換の更新
-	/// </summary>
-	/// <param name="worldtransfrom"></param>
-	void worldTransformUpdate(KamataEngine::WorldTransform& worldtransfrom);
+	Bullet() = default;
+	Bullet(ProjectileSystem* system, const SlotHandle& handle) : system_(system), handle_(handle) {}
 
-	void SetMapChipField(MapChipField* m) { mapChipField_ = m; }
+	// 弾を指しているか（空きが無くて出せなかったとき、弾が返された後は false）
+	bool IsValid() const;
 
-	KamataEngine::Vector3 GetPosition() const { return worldTransformBullet_.translation_; }
+	bool operator==(const Bullet& other) const = default;
 
-	KamataEngine::Vector3 GetSpeed() { return velocity_; };
+	KamataEngine::Vector3 GetPosition() const;
 
-	bool GetIsShot() { return isShot_; };
+	KamataEngine::Vector3 GetSpeed() const;
 
-	bool IsDead() const { return isDead_; }
+	// 返された弾は死んでいる扱い
+	bool IsDead() const;
 
-	void Kill() { isDead_ = true; }
+	// 返された弾には何もしない
+	void Kill();
 
 	// 直接位置を設定
-	void SetPosition(const KamataEngine::Vector3& pos) { worldTransformBullet_.translation_ = pos; }
+	void SetPosition(const KamataEngine::Vector3& pos);
 
 	// ワイヤー用途でヒット後に残す
-	void SetPersistent(bool p) { persistent_ = p; }
+	void SetPersistent(bool p);
+
+	// マップとの当たりを移動した線分で調べる（速い弾のすり抜けを防ぎ、刺さった位置を正確にする）
+	void SetSwept(bool s);
 
 	// 当たり（ブロックに刺さった）フラグ
-	bool IsHooked() const { return hooked_; }
+	bool IsHooked() const;
 
-	void SetVelocity(const KamataEngine::Vector3& v) { velocity_ = v; }
+	void SetVelocity(const KamataEngine::Vector3& v);
 
-	void SetScale(const KamataEngine::Vector3& s) {
-		worldTransformBullet_.scale_ = s;
-	}
+	void SetScale(const KamataEngine::Vector3& s);
 
 	void SetRotationFromDirection(const KamataEngine::Vector3& dir);
 
-private:
-	// 弾のワールドトランスフォーム
-	KamataEngine::WorldTransform worldTransformBullet_;
-
-	// モデル
-	KamataEngine::Model* modelBullet_ = nullptr;
-
-	// カメラ
-	KamataEngine::Camera* camera_ = nullptr;
+	// モデルの getter
+	KamataEngine::Model* GetModel() const;
 
-	// 移動量
-	KamataEngine::Vector3 velocity_ = {};
-
-	// 速度
-	static inline const float kBulletSpeed = 0.6f;
-
-	// 撃ったかどうか
-	bool isShot_ = false;
-
-	// 5秒寿命
-	float lifeTime_ = 5.0f;
-
-	// 消滅フラグ
-	bool isDead_ = false;
-
-	// マップチップによるフィールド
-	MapChipField* mapChipField_ = nullptr;
-
-	//　ワイヤー用に当たり後に残すかどうか
-	bool persistent_ = false;
-
-	//　ブロックに刺さった（停止）したかどうか
-	bool hooked_ = false;
+private:
+	// 中身を持っているシステム
+	ProjectileSystem* system_ = nullptr;
 
-	/*--- 関数 ---*/
-	Math math;
+	// スロット番号と世代
+	SlotHandle handle_;
 };
@@ -66,6 +66,7 @@ void CameraController::Reset() {
 
 	// 追尾対象とオフセットからカメラ座標を計算
 	camera_->translation_ = targetWordTransform.translation_ + targetOffset_;
+	targetposition_ = camera_->translation_;
 }
 
 // マップ矩形を受け取り、ビューポートサイズ分だけ内側に縮めて可動範囲を設定する
@@ -98,6 +99,25 @@ void CameraController::SetmovaleArea(const Rect& area) {
 	movaleArea_ = shrunk;
 }
 
+// z = 0 の平面上でカメラに映る範囲
+RangeRect CameraController::GetVisibleRect(float margin) const {
+	// カメラから z = 0 の平面までの距離
+	float camDist = std::abs(camera_->translation_.z);
+
+	// 垂直半分のワールドサイズ： tan(fov/2) * distance
+	float halfVert = std::tan(camera_->fovAngleY * 0.5f) * camDist + margin;
+	// 水平方向はアスペクト比から計算
+	float halfHorz = std::tan(camera_->fovAngleY * 0.5f) * camDist * camera_->aspectRatio + margin;
+
+	RangeRect rect;
+	rect.left = camera_->translation_.x - halfHorz;
+	rect.right = camera_->translation_.x + halfHorz;
+	rect.bottom = camera_->translation_.y - halfVert;
+	rect.top = camera_->translation_.y + halfVert;
+
+	return rect;
+}
+
 // マップ情報を渡して「タイル単位のパディング」で可動範囲を設定する
 void CameraController::SetMapField(MapChipField* mapField, int paddingTiles) {
 	// 保存
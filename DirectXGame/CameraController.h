@@ -1,6 +1,7 @@
 #pragma once
 #include "Math.h"
 #include "KamataEngine.h"
+#include "MapChipField.h"
 
 // 矩形
 struct Rect {
@@ -15,7 +16,6 @@ struct Rect {
 };
 
 class Player;
-class MapChipField;
 
 class CameraController {
 public:
@@ -37,6 +37,9 @@ public:
 	// アクセッサ
 	void SetTarget(Player* target) { target_ = target; }
 
+	// カメラの目標座標（追尾対象の位置に、速度の分の先読みを足したもの）の getter
+	const KamataEngine::Vector3& GetTargetPosition() const { return targetposition_; }
+
 	// マップ全体の矩形を渡すと、ビューポートに合わせて内側に縮めた可動範囲を設定する
 	void SetmovaleArea(const Rect& area);
 
@@ -44,6 +47,12 @@ public:
 	// paddingTiles: カメラが止まる位置をマップ端から何タイル手前にするか（デフォルト 4）
 	void SetMapField(MapChipField* mapField, int paddingTiles = 4);
 
+	/// <summary>
+	/// z = 0 の平面上でカメラに映る範囲（カメラは回転せず +z 方向を向いている前提）
+	/// </summary>
+	/// <param name="margin">各辺を外側に広げる量（奥行きのあるモデルのはみ出し分）</param>
+	RangeRect GetVisibleRect(float margin = 0.0f) const;
+
 private:
 	/*-------------- カメラ --------------*/
 	// カメラ
@@ -0,0 +1,118 @@
+#include "EnemyArchetypeTable.h"
+#include "MappedFile.h"
+#include "TextToken.h"
+#include <cassert>
+#include <charconv>
+#include <string_view>
+
+namespace {
+
+// 種類名から種類（知らない名前なら kNone）
+inline EnemyType ParseEnemyType(std::string_view name) {
+	if (name == "slime") {
+		return EnemyType::kSlime;
+	}
+	if (name == "bat") {
+		return EnemyType::kBat;
+	}
+	return EnemyType::kNone;
+}
+
+// 1行分の数値を読む（数が足りない・数値でないなら false）
+inline bool ParseValues(std::string_view line, float* values, size_t count) {
+	for (size_t i = 0; i < count; ++i) {
+		const size_t comma = line.find(',');
+		const std::string_view word = TrimToken(line.substr(0, comma));
+		const auto result = std::from_chars(word.data(), word.data() + word.size(), values[i]);
+		if (result.ec != std::errc() || result.ptr != word.data() + word.size()) {
+			return false;
+		}
+		if (comma == std::string_view::npos) {
+			return i + 1 == count;
+		}
+		line.remove_prefix(comma + 1);
+	}
+	return true;
+}
+
+} // namespace
+
+EnemyArchetypeTable::EnemyArchetypeTable() {
+	const Archetype defaults;
+	walkSpeed_.assign(kTypeCount, defaults.walkSpeed);
+	halfWidth_.assign(kTypeCount, defaults.width / 2.0f);
+	halfHeight_.assign(kTypeCount, defaults.height / 2.0f);
+	walkSpin_.assign(kTypeCount, defaults.walkSpin);
+	defeatedTime_.assign(kTypeCount, defaults.defeatedTime);
+	defeatedSpin_.assign(kTypeCount, defaults.defeatedSpin);
+	defeatedAngleStart_.assign(kTypeCount, defaults.defeatedAngleStart);
+	defeatedAngleEnd_.assign(kTypeCount, defaults.defeatedAngleEnd);
+}
+
+void EnemyArchetypeTable::Load(const std::string& filePath) {
+
+	MappedFile file;
+	bool isOpen = file.Open(filePath);
+	// ファイルが開けなかった場合の処理（既定値のまま）
+	assert(isOpen);
+	if (!isOpen) {
+		return;
+	}
+
+	std::string_view csv(reinterpret_cast<const char*>(file.GetData()), file.GetSize());
+
+	// 1行目は見出しなので読まない
+	size_t lineBegin = csv.find('\n');
+	while (lineBegin != std::string_view::npos && lineBegin < csv.size()) {
+		++lineBegin;
+		size_t lineEnd = csv.find('\n', lineBegin);
+		std::string_view line = TrimToken(csv.substr(lineBegin, (lineEnd == std::string_view::npos) ? std::string_view::npos : lineEnd - lineBegin));
+		lineBegin = lineEnd;
+
+		if (line.empty()) {
+			continue;
+		}
+
+		// 種類名
+		const size_t comma = line.find(',');
+		if (comma == std::string_view::npos) {
+			continue;
+		}
+		const EnemyType type = ParseEnemyType(TrimToken(line.substr(0, comma)));
+		if (type == EnemyType::kNone) {
+			continue;
+		}
+
+		// パラメータ（Archetype の並び順）
+		float values[8];
+		if (!ParseValues(line.substr(comma + 1), values, 8)) {
+			continue;
+		}
+		// 大きさとやられ時間は正の値だけ（やられ時間で割るので 0 以下は読めなかった行と同じく飛ばす。NaN もここで落ちる）
+		if (!(values[1] > 0.0f && values[2] > 0.0f && values[4] > 0.0f)) {
+			continue;
+		}
+		Set(type, {values[0], values[1], values[2], values[3], values[4], values[5], values[6], values[7]});
+	}
+}
+
+void EnemyArchetypeTable::Set(EnemyType type, const Archetype& archetype) {
+	const uint32_t id = static_cast<uint32_t>(type);
+	assert(id < kTypeCount);
+
+	walkSpeed_[id] = archetype.walkSpeed;
+	halfWidth_[id] = archetype.width / 2.0f;
+	halfHeight_[id] = archetype.height / 2.0f;
+	walkSpin_[id] = archetype.walkSpin;
+	defeatedTime_[id] = archetype.defeatedTime;
+	defeatedSpin_[id] = archetype.defeatedSpin;
+	defeatedAngleStart_[id] = archetype.defeatedAngleStart;
+	defeatedAngleEnd_[id] = archetype.defeatedAngleEnd;
+}
+
+EnemyArchetypeTable::Archetype EnemyArchetypeTable::Get(EnemyType type) const {
+	const uint32_t id = static_cast<uint32_t>(type);
+	assert(id < kTypeCount);
+
+	return {walkSpeed_[id], halfWidth_[id] * 2.0f, halfHeight_[id] * 2.0f, walkSpin_[id], defeatedTime_[id], defeatedSpin_[id], defeatedAngleStart_[id], defeatedAngleEnd_[id]};
+}
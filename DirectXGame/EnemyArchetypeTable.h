@@ -0,0 +1,72 @@
+#pragma once
+#include "MapChipField.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// 敵の種類（EnemyType）ごとのパラメータの表
+/// CSV から読み込み、パラメータごとの配列に種類の番号で並べる（敵は種類の番号だけを持ち、更新のときに表を引く）
+/// CSV に無い種類は既定値（スライムと同じ）のまま
+/// </summary>
+class EnemyArchetypeTable {
+public:
+	// 1種類分のパラメータ（CSV の1行）
+	struct Archetype {
+		float walkSpeed = 0.02f;          // 歩行速度
+		float width = 1.6f;               // 当たり判定の幅
+		float height = 1.5f;              // 当たり判定の高さ
+		float walkSpin = 0.1f;            // 歩行中の1フレームの Y 回転
+		float defeatedTime = 0.6f;        // やられ演出の時間（秒）
+		float defeatedSpin = 0.3f;        // やられ演出中の1フレームの Y 回転
+		float defeatedAngleStart = 0.0f;  // やられ演出の X 回転の始め
+		float defeatedAngleEnd = -60.0f;  // やられ演出の X 回転の終わり
+	};
+
+	/// <summary>
+	/// すべての種類を既定値にする
+	/// </summary>
+	EnemyArchetypeTable();
+
+	/// <summary>
+	/// CSV の読み込み（1行目は見出し。以降「種類名,歩行速度,幅,高さ,歩行回転,やられ時間,やられ回転,やられ角度始め,やられ角度終わり」）
+	/// 種類名は slime / bat。読めなかった行と、幅・高さ・やられ時間が 0 以下の行は飛ばす
+	/// </summary>
+	/// <param name="filePath">ファイルパス</param>
+	void Load(const std::string& filePath);
+
+	/// <summary>
+	/// 種類のパラメータを設定する
+	/// </summary>
+	void Set(EnemyType type, const Archetype& archetype);
+
+	/// <summary>
+	/// 種類のパラメータを取得する
+	/// </summary>
+	Archetype Get(EnemyType type) const;
+
+	// 種類の数
+	static inline const uint32_t kTypeCount = static_cast<uint32_t>(EnemyType::kBat) + 1;
+
+	/*-------------- 種類の番号で引く表（更新用） --------------*/
+
+	float GetWalkSpeed(uint8_t id) const { return walkSpeed_[id]; }
+	float GetHalfWidth(uint8_t id) const { return halfWidth_[id]; }
+	float GetHalfHeight(uint8_t id) const { return halfHeight_[id]; }
+	float GetWalkSpin(uint8_t id) const { return walkSpin_[id]; }
+	float GetDefeatedTime(uint8_t id) const { return defeatedTime_[id]; }
+	float GetDefeatedSpin(uint8_t id) const { return defeatedSpin_[id]; }
+	float GetDefeatedAngleStart(uint8_t id) const { return defeatedAngleStart_[id]; }
+	float GetDefeatedAngleEnd(uint8_t id) const { return defeatedAngleEnd_[id]; }
+
+private:
+	// パラメータごとの表（種類の番号順。当たり判定は半分の大きさで持つ）
+	std::vector<float> walkSpeed_;
+	std::vector<float> halfWidth_;
+	std::vector<float> halfHeight_;
+	std::vector<float> walkSpin_;
+	std::vector<float> defeatedTime_;
+	std::vector<float> defeatedSpin_;
+	std::vector<float> defeatedAngleStart_;
+	std::vector<float> defeatedAngleEnd_;
+};
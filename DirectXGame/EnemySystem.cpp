@@ -0,0 +1,482 @@
+#include "EnemySystem.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+using namespace KamataEngine;
+
+void EnemySystem::Initialize(uint32_t capacity) {
+
+	posX_.assign(capacity, 0.0f);
+	posY_.assign(capacity, 0.0f);
+	posZ_.assign(capacity, 0.0f);
+	rotX_.assign(capacity, 0.0f);
+	rotY_.assign(capacity, 0.0f);
+	scale_.assign(capacity, 1.0f);
+
+	velX_.assign(capacity, 0.0f);
+	velY_.assign(capacity, 0.0f);
+	velZ_.assign(capacity, 0.0f);
+
+	halfWidth_.assign(capacity, 0.0f);
+	halfHeight_.assign(capacity, 0.0f);
+
+	behavior_.assign(capacity, Enemy::Behavior::kWalk);
+	archetype_.assign(capacity, 0);
+	counter_.assign(capacity, 0.0f);
+	walkTimer_.assign(capacity, 0.0f);
+	flags_.assign(capacity, 0);
+
+	models_.assign(capacity, nullptr);
+
+	slots_.Initialize(capacity);
+	awakeCount_ = 0;
+	walkerCount_ = 0;
+	aliveCount_ = 0;
+	behaviorRequests_.clear();
+
+	// 起こす区画（マップが無ければ区画を作らず、出した敵をすべて起こす）
+	cellEnemies_.clear();
+	numCellHorizontal_ = 0;
+	numCellVertical_ = 0;
+	if (mapChipField_) {
+		numCellHorizontal_ = (mapChipField_->GetNumBlockHorizontal() + kActivationCellSize - 1) / kActivationCellSize;
+		numCellVertical_ = (mapChipField_->GetNumBlockVirtical() + kActivationCellSize - 1) / kActivationCellSize;
+		cellEnemies_.resize(numCellHorizontal_ * numCellVertical_);
+	}
+	activeCells_ = {};
+
+	stats_ = {};
+	stats_.capacity = capacity;
+}
+
+Enemy EnemySystem::Spawn(Model* model, const Vector3& position, const IndexSet& spawnIndex, EnemyType type) {
+
+	// NUllチェック
+	assert(model);
+
+	// 使用中の並びの末尾に置く
+	const SlotHandle handle = slots_.Allocate();
+	if (handle.generation == 0) {
+		return {};
+	}
+	const uint32_t i = slots_.GetCount() - 1;
+
+	posX_[i] = position.x;
+	posY_[i] = position.y;
+	posZ_[i] = position.z;
+	rotX_[i] = 0.0f;
+	rotY_[i] = 0.0f;
+	scale_[i] = 1.0f;
+
+	// 種類ごとのパラメータ
+	const uint8_t id = static_cast<uint8_t>(type);
+	assert(id < EnemyArchetypeTable::kTypeCount);
+	archetype_[i] = id;
+
+	// 速度設定
+	velX_[i] = -archetypes_.GetWalkSpeed(id);
+	velY_[i] = 0.0f;
+	velZ_[i] = 0.0f;
+
+	halfWidth_[i] = archetypes_.GetHalfWidth(id);
+	halfHeight_[i] = archetypes_.GetHalfHeight(id);
+
+	behavior_[i] = Enemy::Behavior::kWalk;
+	counter_[i] = 0.0f;
+	walkTimer_[i] = 0.0f;
+	flags_[i] = 0;
+
+	models_[i] = model;
+
+	++aliveCount_;
+
+	// 出した時点では眠っている（並びの末尾）。起こす範囲の区画なら起こす
+	if (!mapChipField_) {
+		Wake(i);
+	} else {
+		const uint32_t cellX = spawnIndex.xIndex / kActivationCellSize;
+		const uint32_t cellY = spawnIndex.yIndex / kActivationCellSize;
+		assert(cellX < numCellHorizontal_ && cellY < numCellVertical_);
+		cellEnemies_[cellY * numCellHorizontal_ + cellX].push_back(handle);
+		if (activeCells_.Contains(cellX, cellY)) {
+			Wake(i);
+		}
+	}
+
+	UpdateCountStats();
+
+	return Enemy(this, handle);
+}
+
+void EnemySystem::UpdateActivation(const RangeRect& visibleRect) {
+
+	stats_.wokenCount = 0;
+	stats_.sleptCount = 0;
+
+	if (!mapChipField_) {
+		return;
+	}
+
+	// 余白を足した範囲にかかる区画（マップの外なら区画なし）
+	const RangeRect rect = {visibleRect.left - activationMargin_, visibleRect.right + activationMargin_, visibleRect.bottom - activationMargin_, visibleRect.top + activationMargin_};
+	CellRange cells;
+	IndexSet minIndex;
+	IndexSet maxIndex;
+	if (mapChipField_->GetIndexRangeInRect(rect, minIndex, maxIndex)) {
+		cells = {minIndex.xIndex / kActivationCellSize, minIndex.yIndex / kActivationCellSize, maxIndex.xIndex / kActivationCellSize, maxIndex.yIndex / kActivationCellSize, false};
+	}
+
+	// 区画が変わらなければ何もしない（ほとんどのフレームはここで終わる）
+	if (cells == activeCells_) {
+		return;
+	}
+
+	// 外れた区画を眠らせてから、新しく入った区画を起こす
+	if (!activeCells_.empty) {
+		for (uint32_t cellY = activeCells_.y0; cellY <= activeCells_.y1; ++cellY) {
+			for (uint32_t cellX = activeCells_.x0; cellX <= activeCells_.x1; ++cellX) {
+				if (!cells.Contains(cellX, cellY)) {
+					SleepCell(cellX, cellY);
+				}
+			}
+		}
+	}
+	if (!cells.empty) {
+		for (uint32_t cellY = cells.y0; cellY <= cells.y1; ++cellY) {
+			for (uint32_t cellX = cells.x0; cellX <= cells.x1; ++cellX) {
+				if (!activeCells_.Contains(cellX, cellY)) {
+					WakeCell(cellX, cellY);
+				}
+			}
+		}
+	}
+
+	activeCells_ = cells;
+	UpdateCountStats();
+}
+
+void EnemySystem::Update() {
+
+	// 振るまいを変更する（変わった敵は振る舞いごとの並びに移る）
+	ApplyBehaviorRequests();
+
+	// 振る舞いごとにまとめて動かす（眠っている敵 awakeCount_ 以降は状態を止めたままにする）
+	UpdateWalkers();
+	UpdateDefeated();
+}
+
+void EnemySystem::ApplyBehaviorRequests() {
+
+	size_t kept = 0;
+	for (size_t r = 0; r < behaviorRequests_.size(); ++r) {
+		const auto& [handle, behavior] = behaviorRequests_[r];
+		const uint32_t i = slots_.Find(handle);
+		if (i == SlotMap::kInvalid) {
+			// 返された敵のリクエストは捨てる
+			continue;
+		}
+		if (i >= awakeCount_) {
+			// 眠っている敵は起きてから変える
+			behaviorRequests_[kept++] = behaviorRequests_[r];
+			continue;
+		}
+		ChangeBehavior(i, behavior);
+	}
+	behaviorRequests_.resize(kept);
+}
+
+void EnemySystem::ChangeBehavior(uint32_t i, Enemy::Behavior behavior) {
+	assert(i < awakeCount_);
+
+	behavior_[i] = behavior;
+
+	// 各振るまいごとの初期化と、振る舞いごとの並びへの移動
+	switch (behavior) {
+	case Enemy::Behavior::kWalk:
+		if (i >= walkerCount_) {
+			if (i != walkerCount_) {
+				Swap(i, walkerCount_);
+			}
+			++walkerCount_;
+		}
+		break;
+	case Enemy::Behavior::kDefeated:
+	default:
+		counter_[i] = 0;
+		if (i < walkerCount_) {
+			--walkerCount_;
+			if (i != walkerCount_) {
+				Swap(i, walkerCount_);
+			}
+		}
+		break;
+	}
+
+	stats_.walkerCount = walkerCount_;
+}
+
+void EnemySystem::UpdateWalkers() {
+	/*---　歩き　---*/
+	for (uint32_t i = 0; i < walkerCount_; ++i) {
+
+		// 移動
+		/*posX_[i] += velX_[i];*/
+
+		// タイマーの加算
+		walkTimer_[i] += 1.0f / 60.0f;
+
+		rotY_[i] += archetypes_.GetWalkSpin(archetype_[i]);
+	}
+}
+
+void EnemySystem::UpdateDefeated() {
+	/*---　やられ状態　---*/
+	for (uint32_t i = walkerCount_; i < awakeCount_; ++i) {
+		// 演出が終わったものは止めておく
+		if (flags_[i] & kDead) {
+			continue;
+		}
+
+		const uint8_t id = archetype_[i];
+		const float defeatedTime = archetypes_.GetDefeatedTime(id);
+
+		// タイマー
+		counter_[i] += 1.0f / 60.0f;
+
+		rotY_[i] += archetypes_.GetDefeatedSpin(id);
+		rotX_[i] = math.EaseOut(counter_[i] / defeatedTime, archetypes_.GetDefeatedAngleStart(id), archetypes_.GetDefeatedAngleEnd(id));
+
+		// スケールを徐々に小さくして消す（イージングで自然に縮む）
+		scale_[i] = math.EaseOut(std::min(counter_[i] / defeatedTime, 1.0f), 1.0f, 0.0f);
+
+		// 演出が終わったら死亡にして、倒されていない敵の数を減らす
+		if (counter_[i] >= defeatedTime) {
+			flags_[i] |= kDead;
+			--aliveCount_;
+			stats_.aliveCount = aliveCount_;
+		}
+	}
+}
+
+void EnemySystem::Release(const SlotHandle& handle) {
+	const uint32_t i = slots_.Find(handle);
+	if (i == SlotMap::kInvalid) {
+		return;
+	}
+	ReleaseAt(i);
+}
+
+void EnemySystem::ReleaseAt(uint32_t i) {
+	// 死亡になる前に返した敵も、倒されていない敵の数から外す
+	if (!(flags_[i] & kDead)) {
+		--aliveCount_;
+	}
+
+	// 起きている敵なら、先に眠っている側の先頭に移しておく
+	if (i < awakeCount_) {
+		Sleep(i);
+		i = awakeCount_;
+	}
+
+	// 末尾の敵を空いた位置に移して詰める
+	const uint32_t last = slots_.Release(i);
+	if (i != last) {
+		Move(last, i);
+	}
+
+	UpdateCountStats();
+}
+
+void EnemySystem::ReleaseAll() {
+	while (slots_.GetCount() > 0) {
+		ReleaseAt(slots_.GetCount() - 1);
+	}
+
+	for (std::vector<SlotHandle>& handles : cellEnemies_) {
+		handles.clear();
+	}
+}
+
+void EnemySystem::Defeat(uint32_t i) {
+	// 既に倒されている（やられ状態か、そのリクエスト済み）なら何もしない
+	if ((flags_[i] & kCollisionDisabled) || behavior_[i] == Enemy::Behavior::kDefeated) {
+		return;
+	}
+
+	// 衝突を無効化し、やられ演出を続けて最終的に死亡にするためのリクエストを出す
+	flags_[i] |= kCollisionDisabled;
+	behaviorRequests_.emplace_back(slots_.GetHandle(i), Enemy::Behavior::kDefeated);
+}
+
+void EnemySystem::WakeCell(uint32_t cellX, uint32_t cellY) {
+	for (const SlotHandle& handle : cellEnemies_[cellY * numCellHorizontal_ + cellX]) {
+		const uint32_t i = slots_.Find(handle);
+		if (i == SlotMap::kInvalid || i < awakeCount_) {
+			continue;
+		}
+		Wake(i);
+		++stats_.wokenCount;
+	}
+}
+
+void EnemySystem::SleepCell(uint32_t cellX, uint32_t cellY) {
+	for (const SlotHandle& handle : cellEnemies_[cellY * numCellHorizontal_ + cellX]) {
+		const uint32_t i = slots_.Find(handle);
+		if (i == SlotMap::kInvalid || i >= awakeCount_) {
+			continue;
+		}
+		// やられ演出の途中（リクエスト済みも含む）の敵は、死亡になるまで起こしておく
+		if ((flags_[i] & (kCollisionDisabled | kDead)) == kCollisionDisabled) {
+			continue;
+		}
+		Sleep(i);
+		++stats_.sleptCount;
+	}
+}
+
+void EnemySystem::Wake(uint32_t i) {
+	assert(i >= awakeCount_ && i < slots_.GetCount());
+
+	// 眠っている側の先頭と入れ替えて、起きている側を1つ伸ばす（やられ中の並びの末尾に入る）
+	if (i != awakeCount_) {
+		Swap(i, awakeCount_);
+	}
+	i = awakeCount_++;
+
+	// 歩行中なら、やられ中の並びの先頭と入れ替えて歩行中の並びを1つ伸ばす
+	if (behavior_[i] == Enemy::Behavior::kWalk) {
+		if (i != walkerCount_) {
+			Swap(i, walkerCount_);
+		}
+		++walkerCount_;
+	}
+}
+
+void EnemySystem::Sleep(uint32_t i) {
+	assert(i < awakeCount_);
+
+	// 歩行中なら、歩行中の並びの末尾と入れ替えて、やられ中の並びの先頭に出す
+	if (i < walkerCount_) {
+		--walkerCount_;
+		if (i != walkerCount_) {
+			Swap(i, walkerCount_);
+		}
+		i = walkerCount_;
+	}
+
+	// 起きている側の末尾と入れ替えて、起きている側を1つ縮める
+	--awakeCount_;
+	if (i != awakeCount_) {
+		Swap(i, awakeCount_);
+	}
+}
+
+void EnemySystem::UpdateCountStats() {
+	stats_.activeCount = slots_.GetCount();
+	stats_.aliveCount = aliveCount_;
+	stats_.awakeCount = awakeCount_;
+	stats_.walkerCount = walkerCount_;
+	stats_.asleepCount = slots_.GetCount() - awakeCount_;
+}
+
+void EnemySystem::Draw(RenderQueue& queue, InstancedModelRenderer& renderer, FrameRingBuffer& frameRing, const RangeRect& visibleRect) {
+
+	stats_.drawnEnemies = 0;
+	for (DrawBatch& batch : drawBatches_) {
+		batch.worldMatrices.clear();
+	}
+
+	// モデルごとに、起きている敵のうちカメラに映る範囲と重なるものの行列を集める
+	for (uint32_t i = 0; i < awakeCount_; ++i) {
+		if (flags_[i] & kDead) {
+			continue;
+		}
+
+		const AABB aabb = GetActiveAABB(i);
+		if (aabb.max.x < visibleRect.left || aabb.min.x > visibleRect.right || aabb.max.y < visibleRect.bottom || aabb.min.y > visibleRect.top) {
+			continue;
+		}
+
+		Model* model = models_[i];
+		auto batch = std::find_if(drawBatches_.begin(), drawBatches_.end(), [model](const DrawBatch& b) { return b.model == model; });
+		if (batch == drawBatches_.end()) {
+			drawBatches_.push_back({model, {}});
+			batch = drawBatches_.end() - 1;
+		}
+		batch->worldMatrices.push_back(MakeActiveWorldMatrix(i));
+		++stats_.drawnEnemies;
+	}
+
+	// モデル1つにつき1回の描画
+	for (const DrawBatch& batch : drawBatches_) {
+		if (batch.worldMatrices.empty()) {
+			continue;
+		}
+
+		FrameRingBuffer::Allocation allocation;
+		if (!frameRing.Write(batch.worldMatrices.data(), batch.worldMatrices.size(), allocation)) {
+			// リングバッファが足りないフレームは描画しない（失敗回数はリングバッファの統計に残る）
+			continue;
+		}
+
+		// 深度は先頭の敵の位置で代表する
+		const Matrix4x4& front = batch.worldMatrices.front();
+		queue.SubmitInstanced(renderer, *batch.model, allocation.gpuAddress, static_cast<uint32_t>(batch.worldMatrices.size()), {front.m[3][0], front.m[3][1], front.m[3][2]});
+	}
+}
+
+Matrix4x4 EnemySystem::MakeActiveWorldMatrix(uint32_t i) const {
+	// Math::MakeAffineMatrix({s, s, s}, {x, y, 0}, translate) と同じ行列（S * Rx * Ry * T）
+	const float s = scale_[i];
+	const float cx = std::cos(rotX_[i]);
+	const float sx = std::sin(rotX_[i]);
+	const float cy = std::cos(rotY_[i]);
+	const float sy = std::sin(rotY_[i]);
+	return {
+	    {{s * cy, 0.0f, -s * sy, 0.0f}, {s * sx * sy, s * cx, s * sx * cy, 0.0f}, {s * cx * sy, -s * sx, s * cx * cy, 0.0f}, {posX_[i], posY_[i], posZ_[i], 1.0f}}
+    };
+}
+
+void EnemySystem::Move(uint32_t from, uint32_t to) {
+	posX_[to] = posX_[from];
+	posY_[to] = posY_[from];
+	posZ_[to] = posZ_[from];
+	rotX_[to] = rotX_[from];
+	rotY_[to] = rotY_[from];
+	scale_[to] = scale_[from];
+	velX_[to] = velX_[from];
+	velY_[to] = velY_[from];
+	velZ_[to] = velZ_[from];
+	halfWidth_[to] = halfWidth_[from];
+	halfHeight_[to] = halfHeight_[from];
+	behavior_[to] = behavior_[from];
+	archetype_[to] = archetype_[from];
+	counter_[to] = counter_[from];
+	walkTimer_[to] = walkTimer_[from];
+	flags_[to] = flags_[from];
+	models_[to] = models_[from];
+}
+
+void EnemySystem::Swap(uint32_t a, uint32_t b) {
+	std::swap(posX_[a], posX_[b]);
+	std::swap(posY_[a], posY_[b]);
+	std::swap(posZ_[a], posZ_[b]);
+	std::swap(rotX_[a], rotX_[b]);
+	std::swap(rotY_[a], rotY_[b]);
+	std::swap(scale_[a], scale_[b]);
+	std::swap(velX_[a], velX_[b]);
+	std::swap(velY_[a], velY_[b]);
+	std::swap(velZ_[a], velZ_[b]);
+	std::swap(halfWidth_[a], halfWidth_[b]);
+	std::swap(halfHeight_[a], halfHeight_[b]);
+	std::swap(behavior_[a], behavior_[b]);
+	std::swap(archetype_[a], archetype_[b]);
+	std::swap(counter_[a], counter_[b]);
+	std::swap(walkTimer_[a], walkTimer_[b]);
+	std::swap(flags_[a], flags_[b]);
+	std::swap(models_[a], models_[b]);
+
+	slots_.Swap(a, b);
+}
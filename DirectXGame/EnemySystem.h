@@ -0,0 +1,277 @@
+#pragma once
+#include "EnemyArchetypeTable.h"
+#include "FrameRingBuffer.h"
+#include "InstancedModelRenderer.h"
+#include "KamataEngine.h"
+#include "MapChipField.h"
+#include "Math.h"
+#include "RenderQueue.h"
+#include "SlotMap.h"
+#include "enemy.h"
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// 敵の中身をまとめて持つ（変換・速度・当たり判定の大きさ・振る舞い・モデルを成分ごとの配列に並べる）
+/// 更新と描画は配列を先頭から順に回すだけで、敵ごとのワールド変換や定数バッファは持たない
+/// 描画は映っている敵の行列をフレームのリングバッファに書き、モデル1つにつき1回のインスタンス描画にする
+/// カメラから離れた敵は眠らせて、更新・描画・当たり判定から外す（起きている敵を並びの先頭に詰めておき、そこだけを回す）
+/// 眠っている間は状態をそのまま止め、カメラの範囲（＋余白）にかかる区画に入った時点で止めた状態から続ける
+/// やられ演出の途中の敵は眠らせず、範囲の外でも死亡になるまで演出を進める
+/// 起きている敵はさらに振る舞いごとに並べ（歩行 → やられ → 眠り）、更新は振る舞いごとのループで回す（敵ごとに振る舞いで分岐しない）
+/// 速さ・大きさ・演出のパラメータは敵の種類ごとの表（EnemyArchetypeTable）から引く
+/// 外からは Enemy（スロット番号と世代だけを持つハンドル）で触る
+/// </summary>
+class EnemySystem {
+public:
+	// 状態のビット
+	enum Flag : uint8_t {
+		kDead = 1 << 0,              // やられ演出が終わった（描画しない）
+		kCollisionDisabled = 1 << 1, // 弾が当たった（以後の当たり判定から外す）
+	};
+
+	// 使用状況
+	struct Stats {
+		uint32_t capacity = 0;     // 容量
+		uint32_t activeCount = 0;  // 使用中の敵の数
+		uint32_t aliveCount = 0;   // 倒されていない敵の数
+		uint32_t awakeCount = 0;   // 起きている敵の数
+		uint32_t walkerCount = 0;  // 起きている敵のうち歩行中の数
+		uint32_t asleepCount = 0;  // 眠っている敵の数
+		uint32_t wokenCount = 0;   // 直近の UpdateActivation で起こした敵の数
+		uint32_t sleptCount = 0;   // 直近の UpdateActivation で眠らせた敵の数
+		uint32_t drawnEnemies = 0; // 直近の描画で描いた敵の数
+	};
+
+	// マップチップフィールドの setter（Initialize の前に呼ぶ。nullptr なら眠らせず、出した敵はすべて起きている）
+	void SetMapChipField(const MapChipField* mapChipField) { mapChipField_ = mapChipField; }
+
+	// 起こす範囲の余白の setter（カメラに映る範囲をこれだけ広げた範囲にかかる区画の敵を起こす）
+	void SetActivationMargin(float margin) { activationMargin_ = margin; }
+
+	// 敵の種類ごとのパラメータの表の setter（表は写して持つ。出した後の敵にも速さ以外の演出のパラメータは反映される）
+	void SetArchetypes(const EnemyArchetypeTable& archetypes) { archetypes_ = archetypes; }
+
+	/// <summary>
+	/// 初期化（配列をすべて確保し、以前の敵はすべて捨てる）
+	/// </summary>
+	/// <param name="capacity">容量</param>
+	void Initialize(uint32_t capacity);
+
+	/// <summary>
+	/// 敵を出す（O(1)。起こす範囲の外なら眠った状態で出す）
+	/// </summary>
+	/// <param name="model">モデル</param>
+	/// <param name="position">位置</param>
+	/// <param name="spawnIndex">出したマップチップの番号（起こす区画を決める）</param>
+	/// <param name="type">敵の種類（パラメータの表の行）</param>
+	/// <returns>空きが無ければ無効なハンドル</returns>
+	Enemy Spawn(KamataEngine::Model* model, const KamataEngine::Vector3& position, const IndexSet& spawnIndex, EnemyType type);
+
+	/// <summary>
+	/// 起きている敵を選び直す（範囲にかかる区画が前回から変わったときだけ、出入りした区画の敵を起こす・眠らせる）
+	/// </summary>
+	/// <param name="visibleRect">カメラに映る範囲</param>
+	void UpdateActivation(const RangeRect& visibleRect);
+
+	/// <summary>
+	/// 更新（起きている敵だけ。振る舞いのリクエストを反映してから、歩行中の敵、やられ中の敵の順にまとめて動かす）
+	/// </summary>
+	void Update();
+
+	/// <summary>
+	/// 敵を返す（O(1)。返した後のハンドルは無効になる。無効なハンドルなら何もしない）
+	/// </summary>
+	/// <param name="handle">敵のハンドル</param>
+	void Release(const SlotHandle& handle);
+
+	/// <summary>
+	/// すべての敵を返す
+	/// </summary>
+	void ReleaseAll();
+
+	/// <summary>
+	/// 描画を積む（起きている敵のうちカメラに映る範囲と重なるものの行列をフレームのリングバッファに書き、モデルごとに1回のインスタンス描画にする）
+	/// </summary>
+	/// <param name="queue">描画キュー</param>
+	/// <param name="renderer">インスタンス描画</param>
+	/// <param name="frameRing">フレームのリングバッファ</param>
+	/// <param name="visibleRect">カメラに映る範囲</param>
+	void Draw(RenderQueue& queue, InstancedModelRenderer& renderer, FrameRingBuffer& frameRing, const RangeRect& visibleRect);
+
+	// 使用中の敵の数の getter
+	uint32_t GetActiveCount() const { return slots_.GetCount(); }
+
+	// 倒されていない敵の数の getter（出したときに増やし、やられ演出が終わって死亡になったとき・死亡になる前に返したときに減らす。数え直さない）
+	// やられ演出の途中の敵は眠らないので、範囲の外で倒した敵もいずれ死亡になって数から外れる
+	uint32_t GetAliveCount() const { return aliveCount_; }
+
+	// 起きている敵の数の getter（使用中の並びの先頭から GetAwakeCount() 個が起きている）
+	uint32_t GetAwakeCount() const { return awakeCount_; }
+
+	// 起きている敵のうち歩行中の数の getter（使用中の並びの先頭から GetWalkerCount() 個が歩行中）
+	uint32_t GetWalkerCount() const { return walkerCount_; }
+
+	// 使用中の i 番目（0～GetActiveCount()-1）の敵のハンドル（順番は返すたびに入れ替わる。走査中に Spawn / Release しないこと）
+	Enemy GetActive(uint32_t i) { return Enemy(this, slots_.GetHandle(i)); }
+
+	// 使用中の i 番目の敵の AABB
+	AABB GetActiveAABB(uint32_t i) const {
+		return {
+		    {posX_[i] - halfWidth_[i], posY_[i] - halfHeight_[i], posZ_[i] - halfWidth_[i]},
+		    {posX_[i] + halfWidth_[i], posY_[i] + halfHeight_[i], posZ_[i] + halfWidth_[i]}
+        };
+	}
+
+	// 使用中の i 番目の敵の状態のビット
+	uint8_t GetActiveFlags(uint32_t i) const { return flags_[i]; }
+
+	/// <summary>
+	/// 使用中の i 番目の敵のワールド行列を作る（回転は X と Y だけなので、拡大縮小・回転・平行移動を直接並べる）
+	/// </summary>
+	KamataEngine::Matrix4x4 MakeActiveWorldMatrix(uint32_t i) const;
+
+	// 使用状況の getter
+	const Stats& GetStats() const { return stats_; }
+
+	// 起こす区画の大きさ（マップチップの数。チャンクより細かくして、余白が大きくなりすぎないようにする）
+	static inline const uint32_t kActivationCellSize = 8;
+
+	// 起こす範囲の余白の既定値
+	static inline const float kDefaultActivationMargin = 4.0f;
+
+private:
+	friend class Enemy;
+
+	// モデルごとの描画の行列
+	struct DrawBatch {
+		KamataEngine::Model* model = nullptr;
+		std::vector<KamataEngine::Matrix4x4> worldMatrices;
+	};
+
+	// ハンドルの使用中の並びでの位置（返された敵のハンドルなら SlotMap::kInvalid）
+	uint32_t Find(const SlotHandle& handle) const { return slots_.Find(handle); }
+
+	// 並びの位置 i の敵を返す
+	void ReleaseAt(uint32_t i);
+
+	// 並びの位置 i の敵を倒す（当たり判定から外してやられ状態をリクエストする。倒されていない敵の数は死亡になったときに減らす）
+	void Defeat(uint32_t i);
+
+	// 並びの位置 from の中身を to に移す（詰めるとき用）
+	void Move(uint32_t from, uint32_t to);
+
+	// 並びの位置 a と b の中身を入れ替える（起きている敵・歩行中の敵を先頭に集めるとき用）
+	void Swap(uint32_t a, uint32_t b);
+
+	// 振る舞いのリクエストを反映する（眠っている敵のリクエストは起きるまで残す）
+	void ApplyBehaviorRequests();
+
+	// 並びの位置 i の起きている敵の振る舞いを変える（歩行中の並びとやられ中の並びの間で移す）
+	void ChangeBehavior(uint32_t i, Enemy::Behavior behavior);
+
+	// 振る舞いごとの更新
+	void UpdateWalkers();
+	void UpdateDefeated();
+
+	// 起こす区画の範囲（区画の番号。empty なら区画なし）
+	struct CellRange {
+		uint32_t x0 = 0;
+		uint32_t y0 = 0;
+		uint32_t x1 = 0;
+		uint32_t y1 = 0;
+		bool empty = true;
+
+		bool Contains(uint32_t x, uint32_t y) const { return !empty && x >= x0 && x <= x1 && y >= y0 && y <= y1; }
+
+		bool operator==(const CellRange& other) const = default;
+	};
+
+	// 区画の敵をすべて起こす / 眠らせる（やられ演出の途中の敵は眠らせない）
+	void WakeCell(uint32_t cellX, uint32_t cellY);
+	void SleepCell(uint32_t cellX, uint32_t cellY);
+
+	// 並びの位置 i の敵を起こす / 眠らせる（起きている敵の末尾と入れ替え、歩行中なら歩行中の並びに入れる / から出す）
+	void Wake(uint32_t i);
+	void Sleep(uint32_t i);
+
+	// 起きている数・眠っている数の統計を合わせる
+	void UpdateCountStats();
+
+	/*-------------- 使用中の敵（先頭から GetActiveCount() 個を詰めて並べる） --------------*/
+	// [0, walkerCount_) 歩行中 / [walkerCount_, awakeCount_) やられ中 / [awakeCount_, GetActiveCount()) 眠っている
+
+	// 変換（拡大縮小は縦横奥で同じ）
+	std::vector<float> posX_;
+	std::vector<float> posY_;
+	std::vector<float> posZ_;
+	std::vector<float> rotX_;
+	std::vector<float> rotY_;
+	std::vector<float> scale_;
+
+	// 速度
+	std::vector<float> velX_;
+	std::vector<float> velY_;
+	std::vector<float> velZ_;
+
+	// 当たり判定の大きさの半分
+	std::vector<float> halfWidth_;
+	std::vector<float> halfHeight_;
+
+	// 振る舞い
+	std::vector<Enemy::Behavior> behavior_;
+	// 種類（パラメータの表の行）
+	std::vector<uint8_t> archetype_;
+	// やられ演出のタイマー
+	std::vector<float> counter_;
+	// 歩行のタイマー
+	std::vector<float> walkTimer_;
+	std::vector<uint8_t> flags_;
+
+	// モデル
+	std::vector<KamataEngine::Model*> models_;
+
+	// スロットと並びの位置の対応（世代付き）
+	SlotMap slots_;
+
+	// 起きている敵の数
+	uint32_t awakeCount_ = 0;
+
+	// 起きている敵のうち歩行中の数
+	uint32_t walkerCount_ = 0;
+
+	// 振る舞いのリクエスト（敵のハンドルと次の振る舞い。倒されたときくらいなので、敵ごとには持たない）
+	std::vector<std::pair<SlotHandle, Enemy::Behavior>> behaviorRequests_;
+
+	// 敵の種類ごとのパラメータ
+	EnemyArchetypeTable archetypes_;
+
+	// 倒されていない敵の数
+	uint32_t aliveCount_ = 0;
+
+	/*-------------- 起こす区画 --------------*/
+
+	// 区画ごとの敵のハンドル（cellY * numCellHorizontal_ + cellX 番目。返された敵のハンドルは無効なまま残る）
+	std::vector<std::vector<SlotHandle>> cellEnemies_;
+
+	// 区画の数
+	uint32_t numCellHorizontal_ = 0;
+	uint32_t numCellVertical_ = 0;
+
+	// 今起こしている区画の範囲
+	CellRange activeCells_;
+
+	// 起こす範囲の余白
+	float activationMargin_ = kDefaultActivationMargin;
+
+	// マップチップによるフィールド
+	const MapChipField* mapChipField_ = nullptr;
+
+	// モデルごとの描画の行列（モデルは数種類だけなので線形に探す。容量は使い回す）
+	std::vector<DrawBatch> drawBatches_;
+
+	// 使用状況
+	Stats stats_;
+
+	Math math;
+};
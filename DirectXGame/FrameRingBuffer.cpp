@@ -0,0 +1,75 @@
+#include "FrameRingBuffer.h"
+#include <cassert>
+
+using namespace KamataEngine;
+
+void FrameRingBuffer::Initialize(size_t capacity, uint32_t framesInFlight) {
+	allocator_.Initialize(capacity);
+	resource_.Reset();
+	mapped_ = nullptr;
+	cpuMemory_.clear();
+	frameIndex_ = 0;
+	framesInFlight_ = framesInFlight;
+
+	// デバイスが無い環境（描画を記録するだけの場合）では CPU 側のメモリに書き込む
+	ID3D12Device* device = DirectXCommon::GetInstance()->GetDevice();
+	if (!device) {
+		cpuMemory_.resize(capacity);
+		mapped_ = cpuMemory_.data();
+		return;
+	}
+
+	// 毎フレーム書き換えるので、アップロードヒープに置いてマップしたままにする
+	D3D12_HEAP_PROPERTIES heapProperties{};
+	heapProperties.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+	D3D12_RESOURCE_DESC resourceDesc{};
+	resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+	resourceDesc.Width = capacity;
+	resourceDesc.Height = 1;
+	resourceDesc.DepthOrArraySize = 1;
+	resourceDesc.MipLevels = 1;
+	resourceDesc.SampleDesc.Count = 1;
+	resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+	HRESULT result = device->CreateCommittedResource(
+	    &heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&resource_));
+	void* mapped = nullptr;
+	if (SUCCEEDED(result)) {
+		result = resource_->Map(0, nullptr, &mapped);
+	}
+	if (FAILED(result)) {
+		// 作れなかったらデバイスが無いときと同じく CPU 側のメモリに書き込む（GPU アドレスは 0 になり、描画されない）
+		assert(false && "フレームのリングバッファを作れなかった");
+		resource_.Reset();
+		cpuMemory_.resize(capacity);
+		mapped_ = cpuMemory_.data();
+		return;
+	}
+	mapped_ = static_cast<uint8_t*>(mapped);
+}
+
+void FrameRingBuffer::BeginFrame() {
+	// エンジンのフェンスは外から見えないので、直近 framesInFlight_ フレームは GPU が使っているものとして扱う
+	if (frameIndex_ > framesInFlight_) {
+		allocator_.Retire(frameIndex_ - framesInFlight_ - 1);
+	}
+}
+
+void FrameRingBuffer::EndFrame() {
+	allocator_.FinishFrame(frameIndex_);
+	++frameIndex_;
+}
+
+bool FrameRingBuffer::Allocate(size_t size, Allocation& allocation) {
+	const size_t offset = allocator_.Allocate(size, kConstantBufferAlignment);
+	if (offset == LinearRingAllocator::kInvalidOffset) {
+		allocation = {};
+		return false;
+	}
+
+	allocation.cpuAddress = mapped_ + offset;
+	allocation.gpuAddress = resource_ ? resource_->GetGPUVirtualAddress() + offset : 0;
+	allocation.size = size;
+	return true;
+}
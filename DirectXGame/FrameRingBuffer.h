@@ -0,0 +1,87 @@
+#pragma once
+#include "KamataEngine.h"
+#include "LinearRingAllocator.h"
+#include <cstring>
+#include <vector>
+
+/// <summary>
+/// フレームごとに使い捨てる定数・行列用のアップロードバッファ
+/// オブジェクトごとにリソースを作らず、1つのバッファから切り出して GPU アドレスで渡す
+/// </summary>
+class FrameRingBuffer {
+public:
+	// 切り出した領域
+	struct Allocation {
+		void* cpuAddress = nullptr;                // 書き込み先
+		D3D12_GPU_VIRTUAL_ADDRESS gpuAddress = 0; // シェーダーに渡すアドレス（GPU バッファが無ければ 0）
+		size_t size = 0;                           // バイト数
+	};
+
+	// 定数バッファビューに要るアラインメント
+	static inline const size_t kConstantBufferAlignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT;
+
+	/// <summary>
+	/// 初期化
+	/// デバイスが無い環境では CPU 側のメモリだけで同じように割り当てる
+	/// </summary>
+	/// <param name="capacity">全体のバイト数</param>
+	/// <param name="framesInFlight">GPU が同時に使っている可能性のあるフレーム数</param>
+	void Initialize(size_t capacity, uint32_t framesInFlight);
+
+	/// <summary>
+	/// フレームの始め。GPU が使い終わったフレームの領域を解放する
+	/// </summary>
+	void BeginFrame();
+
+	/// <summary>
+	/// フレームの終わり。このフレームの割り当てを解放待ちにする
+	/// </summary>
+	void EndFrame();
+
+	/// <summary>
+	/// 領域を切り出す
+	/// </summary>
+	/// <param name="size">バイト数</param>
+	/// <param name="allocation">切り出した領域</param>
+	/// <returns>空きが足りなければ false</returns>
+	bool Allocate(size_t size, Allocation& allocation);
+
+	/// <summary>
+	/// 配列を書き込んで GPU アドレスを返す
+	/// </summary>
+	/// <param name="data">先頭</param>
+	/// <param name="count">要素数</param>
+	/// <param name="allocation">切り出した領域</param>
+	/// <returns>空きが足りなければ false</returns>
+	template<typename T> bool Write(const T* data, size_t count, Allocation& allocation);
+
+	// 使用状況の getter
+	const LinearRingAllocator::Stats& GetStats() const { return allocator_.GetStats(); }
+
+private:
+	// 割り当ての計算
+	LinearRingAllocator allocator_;
+
+	// GPU 上のバッファ（アップロードヒープに置き、マップしたままにする）
+	Microsoft::WRL::ComPtr<ID3D12Resource> resource_;
+
+	// 書き込み先の先頭
+	uint8_t* mapped_ = nullptr;
+
+	// デバイスが無いときの書き込み先
+	std::vector<uint8_t> cpuMemory_;
+
+	// 今のフレーム番号（フェンス値として使う）
+	uint64_t frameIndex_ = 0;
+
+	// GPU が同時に使っている可能性のあるフレーム数
+	uint32_t framesInFlight_ = 1;
+};
+
+template<typename T> bool FrameRingBuffer::Write(const T* data, size_t count, Allocation& allocation) {
+	if (!Allocate(sizeof(T) * count, allocation)) {
+		return false;
+	}
+	std::memcpy(allocation.cpuAddress, data, sizeof(T) * count);
+	return true;
+}
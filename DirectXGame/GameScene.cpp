@@ -1,6 +1,7 @@
 #define NOMINMAX
 #include "GameScene.h"
 #include <algorithm>
+#include <cfloat>
 #include <cmath>
 
 using namespace KamataEngine;
@@ -8,10 +9,18 @@ using namespace KamataEngine;
 // ゲームシーンの初期化
 void GameScene::Initialize() {
 
+	// ワールド変換の更新をまとめて行う
+	worldTransformSystem_ = new WorldTransformSystem();
+
+	// 毎フレーム書き換える行列の置き場（GPU が使っている可能性のあるバックバッファ分のフレームは解放を待つ）
+	frameRing_.Initialize(kFrameRingCapacity, static_cast<uint32_t>(DirectXCommon::GetInstance()->GetBackBufferCount()));
+
 #pragma region "マップチップ"
 	/*-------------- マップチップの初期化 --------------*/
 	mapchipField_ = new MapChipField;
-	mapchipField_->LoadMapChipCsv("Resources/maps/maps.csv");
+	// ベイク済みマップ（無い・古い場合は CSV からベイクする）からカメラの周辺のチャンクだけをストリーミングする
+	// ベイクできなかった場合は CSV から全体を読み込む
+	mapchipField_->LoadMapChip("Resources/maps/maps.mapbin", "Resources/maps/maps.csv", true);
 
 #pragma endregion
 
@@ -27,6 +36,9 @@ void GameScene::Initialize() {
 	// 座標をマップチップ番号で取得
 	Vector3 playerPosition = mapchipField_->GetMapChipPositionByIndex(5, 18);
 
+	// 開始地点周辺のチャンクは読み込み完了まで待つ（カメラはプレイヤーを追尾して始まるので、同じ位置を中心にする）
+	mapchipField_->UpdateStreaming(playerPosition, true);
+
 	// プレイヤーの初期化
 	player_->Initialize(modelPlayer_, &camera_, playerPosition);
 
@@ -40,6 +52,11 @@ void GameScene::Initialize() {
 	player_->SetWireSegmentSpacing(0.6f);
 	player_->SetWirePullSpeed(0.5f);
 
+	// 弾は定数バッファを持たず、フレームのリングバッファに行列を書き込んでまとめて描画する
+	bulletRenderer_ = new InstancedModelRenderer();
+	bulletRenderer_->Initialize();
+	player_->SetBulletRenderer(bulletRenderer_, &frameRing_);
+
 #pragma endregion
 
 #pragma region "敵"
@@ -48,25 +65,34 @@ void GameScene::Initialize() {
 	// 3Dモデルの生成
 	modelEnemy_ = Model::CreateFromOBJ("target", true);
 
+	// 敵は定数バッファを持たず、弾と同じくフレームのリングバッファに行列を書き込んでまとめて描画する
+	enemyRenderer_ = new InstancedModelRenderer();
+	enemyRenderer_->Initialize();
+
 	// 敵の生成（CSVのスポーン情報を使用）
 	if (mapchipField_) {
 		const auto& spawns = mapchipField_->GetEnemySpawns();
-		for (const auto& spawn : spawns) {
-			Enemy* newEnemy = new Enemy();
 
+		// 敵の種類ごとのパラメータ（速さ・大きさ・演出）
+		EnemyArchetypeTable archetypes;
+		archetypes.Load("Resources/maps/enemies.csv");
+		enemies_.SetArchetypes(archetypes);
+
+		// カメラから離れた敵は、スポーン位置の区画ごとに眠らせる
+		enemies_.SetMapChipField(mapchipField_);
+		enemies_.Initialize(static_cast<uint32_t>(spawns.size()));
+		for (const auto& spawn : spawns) {
 			// マップチップ座標をワールド座標に変換して初期位置とする
 			Vector3 enemyPosition = mapchipField_->GetMapChipPositionByIndex(spawn.index.xIndex, spawn.index.yIndex);
 
-			// 敵の初期化
-			newEnemy->Initialize(modelEnemy_, &camera_, enemyPosition);
-
-			// 将来的に spawn.type に応じた初期設定を行う場合はここで switch する
-			// switch (spawn.type) { ... }
-
-			enemies_.push_back(newEnemy);
+			// 敵の生成（種類ごとのパラメータは表から引く）
+			enemies_.Spawn(modelEnemy_, enemyPosition, spawn.index, spawn.type);
 		}
 	}
 
+	// 弾との当たり判定の空間ハッシュ
+	enemyGrid_.Initialize(MapChipField::kBlockWidth, kEnemyGridBuckets);
+
 #pragma endregion
 
 #pragma region "ブロック"
@@ -75,9 +101,20 @@ void GameScene::Initialize() {
 	// 3Dモデルの生成
 	modelBlock_ = Model::CreateFromOBJ("Block", true);
 
+	// ブロックのメッシュの描画の初期化
+	blockRenderer_ = new InstancedModelRenderer();
+	blockRenderer_->Initialize(L"Resources/shaders/LevelMeshVS.hlsl", L"Resources/shaders/LevelMeshPS.hlsl");
+
+	// まとめた面にもブロック1つ分ずつテクスチャを貼れるように、モデルの面ごとの UV を取り出しておく
+	blockFaceUVs_.Create(MapChipMeshBuilder::MakeFaceUVTransforms(*modelBlock_->GetMeshes().front()));
+
 	// ブロックの生成
 	GenetateBlocks();
 
+	// 生成済みのチャンクのイベントは不要なので捨てる
+	mapchipField_->TakeChunkEvents(chunkEvents_);
+	chunkEvents_.clear();
+
 #pragma endregion
 
 #pragma region "スカイドーム"
@@ -92,6 +129,9 @@ void GameScene::Initialize() {
 	// スカイドームの初期化
 	skydome_->Initialize(modelSkydome_, &camera_);
 
+	// スカイドームは動かないので、行列は最初の1回だけ作られる
+	worldTransformSystem_->Register(skydome_->GetWorldTransform());
+
 #pragma endregion
 
 #pragma region "カメラ"
@@ -210,6 +250,9 @@ void GameScene::Initialize() {
 	fade_ = new Fade();
 	fade_->Initialize();
 	fade_->Start(Fade::Status::FadeIn, 1.0f);
+
+	// 最初のフレームの判定で使えるように行列を作っておく
+	worldTransformSystem_->Update();
 }
 
 // ゲームシーンの更新
@@ -217,6 +260,9 @@ void GameScene::Update() {
 
 	ChangePhase();
 
+	// カメラの周りの敵だけを起こす（眠っている敵は更新・描画・当たり判定をしない）
+	enemies_.UpdateActivation(cameraController_->GetVisibleRect(0.0f));
+
 	switch (phase_) {
 	case Phase::kFadeIn:
 		// フェードインの更新
@@ -228,9 +274,6 @@ void GameScene::Update() {
 			phase_ = Phase::kPlay;
 		}
 
-		// スカイドームの更新
-		skydome_->Update();
-
 		// カメラコントローラーの更新
 		cameraController_->Update();
 
@@ -238,50 +281,115 @@ void GameScene::Update() {
 		player_->Update();
 
 		// 敵の更新
-		for (Enemy* enemy : enemies_) {
-			enemy->Update();
-		}
-
-		// ブロックの更新
-		for (std::vector<WorldTransform*>& worldTransBlockLine : worldTransformBlocks_) {
-			for (WorldTransform* worldTransformBlock : worldTransBlockLine) {
-				if (!worldTransformBlock) {
-					continue;
-				}
-
-				math->worldTransformUpdate(*worldTransformBlock);
-			}
-		}
+		enemies_.Update();
 
 		break;
 	case Phase::kPlay:
 		// ゲームプレイフェーズの処理
 
-		// スカイドームの更新
-		skydome_->Update();
-
 		// プレイヤーの更新
 		player_->Update();
 
 		// 敵の更新
-		for (Enemy* enemy : enemies_) {
-			enemy->Update();
-		}
+		enemies_.Update();
 
 		// カメラコントローラーの更新
 		cameraController_->Update();
 
-		// ブロックの更新
-		for (std::vector<WorldTransform*>& worldTransBlockLine : worldTransformBlocks_) {
-			for (WorldTransform* worldTransformBlock : worldTransBlockLine) {
-				if (!worldTransformBlock) {
-					continue;
-				}
+#ifdef USE_IMGUI
+		// ストリーミングの状況
+		{
+			const MapChipStreamingStats& stats = mapchipField_->GetStreamingStats();
+			ImGui::Begin("MapStreaming");
+			ImGui::Text("resident chunks : %u", stats.residentChunks);
+			ImGui::Text("pending chunks  : %u", stats.pendingChunks);
+			ImGui::Text("loaded total    : %u", stats.loadedChunksTotal);
+			ImGui::Text("latency last/avg: %.3f / %.3f ms", stats.lastLoadLatencyMs, stats.averageLoadLatencyMs);
+			ImGui::Text("block draw calls: %u", blockRenderer_->GetDrawCallCount());
+			ImGui::End();
+		}
 
-				math->worldTransformUpdate(*worldTransformBlock);
-			}
+		// カリングの状況（直近の描画）
+		{
+			ImGui::Begin("Culling");
+			ImGui::Text("blocks : %u / %u", drawStats_.drawnBlocks, drawStats_.totalBlocks);
+			ImGui::Text("block triangles: %u / %u (cubes: %u)", drawStats_.drawnBlockTriangles, drawStats_.totalBlockTriangles, drawStats_.totalBlocks * MapChipMeshBuilder::kTrianglesPerBlock);
+			ImGui::Text("enemies: %u / %u", drawStats_.drawnEnemies, drawStats_.totalEnemies);
+			ImGui::Text("bullets: %u / %u", drawStats_.drawnBullets, drawStats_.totalBullets);
+			ImGui::End();
 		}
 
+		// 行列の更新の状況
+		{
+			const WorldTransformStats& stats = worldTransformSystem_->GetStats();
+			ImGui::Begin("WorldTransform");
+			ImGui::Text("registered      : %u", stats.registeredTransforms);
+			ImGui::Text("rebuilt matrices: %u", stats.rebuiltMatrices);
+			ImGui::Text("uploaded bytes  : %u", stats.uploadedBytes);
+			ImGui::End();
+		}
+
+		// フレームのリングバッファの使用状況（直近の描画）
+		{
+			const LinearRingAllocator::Stats& stats = frameRing_.GetStats();
+			ImGui::Begin("FrameRing");
+			ImGui::Text("used / capacity : %zu / %zu", stats.usedBytes, stats.capacity);
+			ImGui::Text("peak used       : %zu", stats.peakUsedBytes);
+			ImGui::Text("frames in flight: %u", stats.framesInFlight);
+			ImGui::Text("failed allocs   : %u", stats.failedAllocations);
+			ImGui::Text("bullet draw calls: %u", bulletRenderer_->GetDrawCallCount());
+			ImGui::End();
+		}
+
+		// 弾の使用状況
+		{
+			const ProjectileSystem::Stats& stats = player_->GetProjectileSystem().GetStats();
+			ImGui::Begin("Projectiles");
+			ImGui::Text("active / capacity: %u / %u", stats.activeCount, stats.capacity);
+			ImGui::Text("peak active      : %u", stats.peakActiveCount);
+			ImGui::Text("spawn / release  : %u / %u", stats.spawnCount, stats.releaseCount);
+			ImGui::Text("failed spawns    : %u", stats.failedSpawnCount);
+			ImGui::Text("tile tests       : %u", stats.tileTests);
+			ImGui::Text("swept tests      : %u", stats.sweptTests);
+			const WireRenderer::Stats& wireStats = player_->GetWireChain().GetStats();
+			ImGui::Text("wire segments    : %u drawn / %u / %u", wireStats.drawnSegments, wireStats.segmentCount, wireStats.capacity);
+			ImGui::Text("wire truncated   : %u", wireStats.truncatedSegments);
+			ImGui::End();
+		}
+
+		// 敵の起きている・眠っている数
+		{
+			const EnemySystem::Stats& stats = enemies_.GetStats();
+			ImGui::Begin("Enemies");
+			ImGui::Text("alive          : %u / %u", stats.aliveCount, stats.activeCount);
+			ImGui::Text("awake / asleep : %u / %u", stats.awakeCount, stats.asleepCount);
+			ImGui::Text("walk / defeated: %u / %u", stats.walkerCount, stats.awakeCount - stats.walkerCount);
+			ImGui::Text("woken / slept  : %u / %u", stats.wokenCount, stats.sleptCount);
+			ImGui::End();
+		}
+
+		// 弾と敵の当たり判定の状況（直近の判定）
+		{
+			const SpatialHashGrid::Stats& stats = enemyGrid_.GetStats();
+			ImGui::Begin("Broadphase");
+			ImGui::Text("enemies / cell entries: %u / %u", stats.objects, stats.cellEntries);
+			ImGui::Text("bullets tested        : %u", stats.queries);
+			ImGui::Text("pair tests            : %u", stats.candidates);
+			ImGui::Text("pair tests (all pairs): %u", stats.objects * stats.queries);
+			ImGui::End();
+		}
+
+		// 描画キューの状況（直近の描画）
+		{
+			const RenderQueue::Stats& stats = renderQueue_.GetStats();
+			ImGui::Begin("RenderQueue");
+			ImGui::Text("packets          : %u", stats.packets);
+			ImGui::Text("passes           : %u", stats.passes);
+			ImGui::Text("pipeline switches: %u (unsorted: %u)", stats.pipelineSwitches, stats.unsortedPipelineSwitches);
+			ImGui::End();
+		}
+#endif
+
 #ifdef _DEBUG
 
 		if (Input::GetInstance()->TriggerKey(DIK_TAB)) {
@@ -313,17 +421,9 @@ void GameScene::Update() {
 		// 全ての当たり判定を行う
 		CheckAllCollisions();
 
-		// --- 全敵が死亡しているかチェック ---
+		// --- 全敵が倒されたかチェック（倒されていない敵の数は敵が死亡になったときに減らしてあるので、数え直さない） ---
 		{
-			bool allDead = true;
-			for (Enemy* enemy : enemies_) {
-				if (enemy && !enemy->IsDead()) {
-					allDead = false;
-					break;
-				}
-			}
-
-			if (allDead) {
+			if (enemies_.GetAliveCount() == 0) {
 				// フェードアウトしてタイトルへ戻る
 				if (fade_) {
 					fade_->Start(Fade::Status::FadeOut, 1.0f);
@@ -337,16 +437,11 @@ void GameScene::Update() {
 	case Phase::kDeath:
 		// デス演出フェーズの処理
 
-		// スカイドームの更新
-		skydome_->Update();
-
 		// カメラコントローラーの更新
 		cameraController_->Update();
 
 		// 敵の更新
-		for (Enemy* enemy : enemies_) {
-			enemy->Update();
-		}
+		enemies_.Update();
 
 		break;
 	case Phase::kFadeOut:
@@ -359,70 +454,87 @@ void GameScene::Update() {
 			finished_ = true;
 		}
 
-		// スカイドームの更新
-		skydome_->Update();
-
 		// 敵の更新
-		for (Enemy* enemy : enemies_) {
-			enemy->Update();
-		}
+		enemies_.Update();
 
 		// カメラコントローラーの更新
 		cameraController_->Update();
 
 		break;
 	}
+
+	// マップのストリーミング更新（どのフェーズでもカメラの周辺を読み込む）
+	UpdateMapStreaming();
+
+	// 動いたものだけ行列を作り直して転送
+	worldTransformSystem_->Update();
 }
 
 // ゲームシーンの描画
 void GameScene::Draw() {
-	// 3Dモデル描画前処理
-	Model::PreDraw(Model::CullingMode::kBack, Model::BlendMode::kNone, Model::DepthTestMode::kOn);
+	// GPU が使い終わったフレームの行列の領域を解放する
+	frameRing_.BeginFrame();
 
-	// スカイドームの描画
-	skydome_->Draw();
+	// カメラに映る範囲（デバックカメラのときは全て描く）
+	RangeRect visibleRect = cameraController_->GetVisibleRect(kCullingMargin);
+	if (isDebugCameraActive_) {
+		visibleRect = {-FLT_MAX, FLT_MAX, -FLT_MAX, FLT_MAX};
+	}
 
-	// 3Dモデルの後処理
-	Model::PostDraw();
+	drawStats_ = {};
 
-	// 3Dモデル描画前処理
-	Model::PreDraw(Model::CullingMode::kBack, Model::BlendMode::kNone, Model::DepthTestMode::kOn);
+	// 3D の描画はすべて描画キューに積み、最後にまとめて並べ替えて描く
+	renderQueue_.Begin(camera_);
 
-	// ブロックの描画
-	for (std::vector<WorldTransform*>& worldTransBlockLine : worldTransformBlocks_) {
-		for (WorldTransform* worldTransformBlock : worldTransBlockLine) {
+	// ブロックの描画（映っているチャンクだけを、チャンクのメッシュ1つにつき1回の描画で描く）
+	blockRenderer_->ClearDrawRecords();
+	for (const MapChipChunkMesh& blocks : blockMeshes_) {
+		drawStats_.totalBlocks += blocks.GetBlockCount();
+		drawStats_.totalBlockTriangles += blocks.GetTriangleCount();
+	}
 
-			if (!worldTransformBlock) {
-				continue;
+	Material* blockMaterial = modelBlock_->GetMeshes().front()->GetMaterial();
+	IndexSet minIndex;
+	IndexSet maxIndex;
+	if (mapchipField_->GetIndexRangeInRect(visibleRect, minIndex, maxIndex)) {
+		const uint32_t numChunkHorizontal = mapchipField_->GetNumChunkHorizontal();
+		for (uint32_t chunkY = minIndex.yIndex / MapChipField::kChunkSize; chunkY <= maxIndex.yIndex / MapChipField::kChunkSize; ++chunkY) {
+			for (uint32_t chunkX = minIndex.xIndex / MapChipField::kChunkSize; chunkX <= maxIndex.xIndex / MapChipField::kChunkSize; ++chunkX) {
+				const MapChipChunkMesh& blocks = blockMeshes_[chunkY * numChunkHorizontal + chunkX];
+
+				// 深度はチャンクの中心で代表する
+				const Vector3 center = mapchipField_->GetMapChipPositionByIndex(
+				    chunkX * MapChipField::kChunkSize + MapChipField::kChunkSize / 2, chunkY * MapChipField::kChunkSize + MapChipField::kChunkSize / 2);
+				renderQueue_.SubmitInstancedIndexed(*blockRenderer_, blocks.GetVBView(), blocks.GetIBView(), blocks.GetIndexCount(), *blockMaterial, blockFaceUVs_, 1, center);
+				drawStats_.drawnBlocks += blocks.GetBlockCount();
+				drawStats_.drawnBlockTriangles += blocks.GetTriangleCount();
 			}
-
-			modelBlock_->Draw(*worldTransformBlock, camera_);
 		}
 	}
 
-	// 3Dモデルの後処理
-	Model::PostDraw();
-
-	// 3Dモデル描画前処理
-	Model::PreDraw(Model::CullingMode::kBack, Model::BlendMode::kNone, Model::DepthTestMode::kOn);
-
 	// プレイヤーの描画
-	player_->Draw();
+	bulletRenderer_->ClearDrawRecords();
+	player_->Draw(renderQueue_, visibleRect);
+	drawStats_.drawnBullets = player_->GetDrawnBulletCount();
+	drawStats_.totalBullets = player_->GetProjectileSystem().GetActiveCount();
 
-	// 3Dモデルの後処理
-	Model::PostDraw();
+	// 敵の描画（カメラに映る範囲と重なるものだけ）
+	enemyRenderer_->ClearDrawRecords();
+	enemies_.Draw(renderQueue_, *enemyRenderer_, frameRing_, visibleRect);
+	drawStats_.drawnEnemies = enemies_.GetStats().drawnEnemies;
+	drawStats_.totalEnemies = enemies_.GetActiveCount();
 
-	Model::PreDraw(Model::CullingMode::kBack, Model::BlendMode::kNone, Model::DepthTestMode::kOn);
+	// スカイドームの描画（最後の層に積まれる）
+	skydome_->Draw(renderQueue_);
 
-	// 敵の描画
-	for (Enemy* enemy : enemies_) {
-		enemy->Draw();
-	}
+	// 並べ替えて描画
+	renderBackend_.SetCamera(camera_);
+	renderQueue_.Execute(renderBackend_);
 
-	fade_->Draw();
+	// ワイヤー狙い用の矢印
+	player_->DrawAim();
 
-	// 3Dモデルの後処理
-	Model::PostDraw();
+	fade_->Draw();
 
 	Sprite::PreDraw();
 
@@ -474,12 +586,7 @@ void GameScene::Draw() {
 
 	// --- 追加: 敵数表示 (右上) ---
 	{
-		int alive = 0;
-		for (Enemy* e : enemies_) {
-			if (e && !e->IsDead()) {
-				++alive;
-			}
-		}
+		int alive = static_cast<int>(enemies_.GetAliveCount());
 
 		// 右上配置
 		Vector2 enemyBasePos = {540.0f, 25.0f};
@@ -501,6 +608,9 @@ void GameScene::Draw() {
 	}
 
 	Sprite::PostDraw();
+
+	// このフレームで書き込んだ行列の領域を解放待ちにする
+	frameRing_.EndFrame();
 }
 
 // デストラクタ
@@ -514,15 +624,11 @@ GameScene::~GameScene() {
 	// プレイヤーの解放
 	delete player_;
 	delete modelPlayer_;
+	delete bulletRenderer_;
 
 	// ブロックの解放
-	for (std::vector<WorldTransform*>& worldTransBlockLine : worldTransformBlocks_) {
-		for (WorldTransform* worldTransformBlock : worldTransBlockLine) {
-			delete worldTransformBlock;
-		}
-	}
-	worldTransformBlocks_.clear();
-
+	blockMeshes_.clear();
+	delete blockRenderer_;
 	delete modelBlock_;
 
 	// スカイドームの解放
@@ -530,12 +636,14 @@ GameScene::~GameScene() {
 	delete modelSkydome_;
 
 	// 敵の解放
-	for (Enemy* enemy : enemies_) {
-		delete enemy;
-	}
+	enemies_.ReleaseAll();
+	delete enemyRenderer_;
 	// 敵モデルの解放（CreateFromOBJ で取得しているため解放する）
 	delete modelEnemy_;
 
+	// ワールド変換の更新の解放
+	delete worldTransformSystem_;
+
 	// フェードの解放（new しているため解放する）
 	delete fade_;
 
@@ -561,33 +669,67 @@ GameScene::~GameScene() {
 
 void GameScene::GenetateBlocks() {
 
-	// 要素数
-	uint32_t numBlockVertical = mapchipField_->GetNumBlockVirtical();
-	uint32_t numBlockHorizontal = mapchipField_->GetNumBlockHorizontal();
+	// チャンク数
+	uint32_t numChunkHorizontal = mapchipField_->GetNumChunkHorizontal();
+	uint32_t numChunkVertical = mapchipField_->GetNumChunkVirtical();
 
 	/*---要素数の変更---*/
-	// 列数の設定
-	worldTransformBlocks_.resize(numBlockVertical);
-	// 行数の設定
-	for (uint32_t x = 0; x < numBlockVertical; ++x) {
-		worldTransformBlocks_[x].resize(numBlockHorizontal);
+	blockMeshes_.resize(numChunkVertical * numChunkHorizontal);
+
+	// 読み込み済みのチャンクのブロックを生成
+	for (uint32_t chunkY = 0; chunkY < numChunkVertical; ++chunkY) {
+		for (uint32_t chunkX = 0; chunkX < numChunkHorizontal; ++chunkX) {
+			if (mapchipField_->IsChunkResident(chunkX, chunkY)) {
+				GenerateChunkBlocks(chunkX, chunkY);
+			}
+		}
 	}
+}
 
-	// ブロックの生成
-	for (uint32_t y = 0; y < numBlockVertical; ++y) {
-		for (uint32_t x = 0; x < numBlockHorizontal; ++x) {
+void GameScene::GenerateChunkBlocks(uint32_t chunkX, uint32_t chunkY) {
+
+	// 見えている面だけをまとめたメッシュを作る
+	MapChipMeshBuilder::BuildChunk(*mapchipField_, chunkX, chunkY, blockMeshScratch_);
+	blockMeshes_[chunkY * mapchipField_->GetNumChunkHorizontal() + chunkX].Create(blockMeshScratch_);
+}
+
+void GameScene::ReleaseChunkBlocks(uint32_t chunkX, uint32_t chunkY) {
+
+	blockMeshes_[chunkY * mapchipField_->GetNumChunkHorizontal() + chunkX].Release();
+}
+
+void GameScene::UpdateMapStreaming() {
 
-			// マップチップデータに沿って、ワールド変換データの生成、初期化、配置
-			if (mapchipField_->GetMapChipTypeByIndex(x, y) == MapChipType::kBlock) {
-				// ワールド変換データの生成
-				WorldTransform* worldTransformBlock = new WorldTransform();
+	// カメラの目標座標の周辺を読み込む
+	if (mapchipField_->IsStreaming()) {
+		mapchipField_->UpdateStreaming(cameraController_->GetTargetPosition());
+	}
+
+	// 読み込み・解放・変更されたチャンクのブロックを作り直す
+	mapchipField_->TakeChunkEvents(chunkEvents_);
+	for (const MapChipChunkEvent& event : chunkEvents_) {
+		ReleaseChunkBlocks(event.chunkX, event.chunkY);
 
-				// ワールド変換データの初期化
-				worldTransformBlock->Initialize();
+		if (event.type != MapChipChunkEventType::kUnloaded) {
+			GenerateChunkBlocks(event.chunkX, event.chunkY);
+		}
+	}
 
-				// ワールド変換データの位置を設定
-				worldTransformBlocks_[y][x] = worldTransformBlock;
-				worldTransformBlocks_[y][x]->translation_ = mapchipField_->GetMapChipPositionByIndex(x, y);
+	// 読み込み・解放では境目の面が出たり隠れたりするので、隣の読み込み済みチャンクも作り直す
+	// （変更では、見た目が変わる隣のチャンクにも変更イベントが出ている）
+	const uint32_t numChunkHorizontal = mapchipField_->GetNumChunkHorizontal();
+	const uint32_t numChunkVertical = mapchipField_->GetNumChunkVirtical();
+	for (const MapChipChunkEvent& event : chunkEvents_) {
+		if (event.type == MapChipChunkEventType::kModified) {
+			continue;
+		}
+		const int32_t offsets[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+		for (const auto& offset : offsets) {
+			// マップの外（-1）は大きな値になって範囲外になる
+			const uint32_t neighborX = static_cast<uint32_t>(static_cast<int32_t>(event.chunkX) + offset[0]);
+			const uint32_t neighborY = static_cast<uint32_t>(static_cast<int32_t>(event.chunkY) + offset[1]);
+			if (neighborX < numChunkHorizontal && neighborY < numChunkVertical && mapchipField_->IsChunkResident(neighborX, neighborY)) {
+				GenerateChunkBlocks(neighborX, neighborY);
 			}
 		}
 	}
@@ -628,43 +770,49 @@ void GameScene::CheckAllCollisions() {
 
 #pragma region 自弾(通常弾)と敵キャラの当たり判定
 	{
-		// プレイヤーの弾リストを取得
-		const std::list<Bullet*>& bullets = player_->GetBullets();
-
-		// 各敵に対して当たり判定
-		for (Enemy* enemy : enemies_) {
-			if (!enemy)
+		// 当たり判定の対象になる敵を、重なるタイルのセルに登録する（AABB もここで1回だけ計算する）
+		// 番号は敵の並びの位置（判定中は敵を出し入れしないので変わらない）。眠っている敵は判定しない
+		enemyGrid_.Clear();
+		for (uint32_t i = 0; i < enemies_.GetAwakeCount(); ++i) {
+			if (enemies_.GetActiveFlags(i) & (EnemySystem::kDead | EnemySystem::kCollisionDisabled))
 				continue;
-			if (enemy->IsDead())
-				continue;
-			if (enemy->IsCollisionDisabled())
+
+			enemyGrid_.Insert(i, enemies_.GetActiveAABB(i));
+		}
+		enemyGrid_.Build();
+
+		// プレイヤーの弾を取得
+		ProjectileSystem& projectiles = player_->GetProjectileSystem();
+
+		// 各弾は、自分のいるセルに重なる敵とだけ判定する
+		for (uint32_t i = 0; i < projectiles.GetActiveCount(); ++i) {
+			Bullet bullet = projectiles.GetActive(i);
+			if (bullet.IsDead())
 				continue;
 
-			AABB enemyAabb = enemy->GetAABB();
+			KamataEngine::Vector3 pos = bullet.GetPosition();
 
-			for (Bullet* bullet : bullets) {
-				if (!bullet)
-					continue;
-				if (bullet->IsDead())
-					continue;
-				if (!bullet->GetIsShot())
-					continue;
+			enemyGrid_.QueryPoint(pos, [&](uint32_t id, const AABB& enemyAabb) {
+				Enemy enemy = enemies_.GetActive(id);
 
-				KamataEngine::Vector3 pos = bullet->GetPosition();
+				// このフレームで先に別の弾が当たった敵は除く
+				if (enemy.IsCollisionDisabled())
+					return true;
 
 				// 弾（点）と敵のAABBの当たり判定（点がAABB内にあるか）
 				if (pos.x >= enemyAabb.min.x && pos.x <= enemyAabb.max.x && pos.y >= enemyAabb.min.y && pos.y <= enemyAabb.max.y && pos.z >= enemyAabb.min.z && pos.z <= enemyAabb.max.z) {
 
 					// 衝突時処理
-					enemy->OnCollision(player_);
+					enemy.OnCollision(player_);
 
-					// 弾を消す（削除は Player::Update 内の remove_if に任せる）
-					bullet->Kill();
+					// 弾を消す（スロットの返却は Player::Update の最後に任せる）
+					bullet.Kill();
 
-					// １つの弾で複数敵に当たらない想定 -> 内側ループを抜ける
-					break;
+					// １つの弾で複数敵に当たらない想定 -> 列挙をやめる
+					return false;
 				}
-			}
+				return true;
+			});
 		}
 	}
 #pragma endregion
@@ -1,12 +1,19 @@
 #pragma once
 #include "CameraController.h"
+#include "EnemySystem.h"
 #include "Fade.h"
+#include "FrameRingBuffer.h"
+#include "InstancedModelRenderer.h"
+#include "MapChipChunkMesh.h"
 #include "KamataEngine.h"
 #include "MapChipField.h"
 #include "Math.h"
+#include "ModelRenderBackend.h"
 #include "Player.h"
+#include "RenderQueue.h"
 #include "Skydome.h"
-#include "enemy.h"
+#include "SpatialHashGrid.h"
+#include "WorldTransformSystem.h"
 #include <vector>
 
 class GameScene {
@@ -36,6 +43,21 @@ public:
 	///< summary>
 	void GenetateBlocks();
 
+	/// <summary>
+	/// チャンク内の表示ブロックの生成
+	/// </summary>
+	void GenerateChunkBlocks(uint32_t chunkX, uint32_t chunkY);
+
+	/// <summary>
+	/// チャンク内の表示ブロックの解放
+	/// </summary>
+	void ReleaseChunkBlocks(uint32_t chunkX, uint32_t chunkY);
+
+	/// <summary>
+	/// マップのストリーミング更新（読み込み・解放・変更されたチャンクのブロックを作り直す）
+	/// </summary>
+	void UpdateMapStreaming();
+
 	void CheckAllCollisions();
 
 	void ChangePhase();
@@ -71,14 +93,41 @@ private:
 	// プレイヤーのモデル
 	KamataEngine::Model* modelPlayer_ = nullptr;
 
+	// 弾のインスタンス描画
+	InstancedModelRenderer* bulletRenderer_ = nullptr;
+
 	/*-------------- 敵mob --------------*/
-	std::list<Enemy*> enemies_;
+	// 敵の中身（成分ごとの配列。スポーン情報の数だけ確保する）
+	EnemySystem enemies_;
 
 	// 敵のモデル
 	KamataEngine::Model* modelEnemy_ = nullptr;
 
+	// 敵のインスタンス描画
+	InstancedModelRenderer* enemyRenderer_ = nullptr;
+
+	// 弾との当たり判定の候補を絞る敵の空間ハッシュ（セルはタイル。毎フレーム作り直す）
+	SpatialHashGrid enemyGrid_;
+
+	// 空間ハッシュの箱の数（敵は数十体なので小さめ。数千体でも衝突は細かい判定で弾く）
+	static inline const uint32_t kEnemyGridBuckets = 1024;
+
 	/*---ブロック---*/
-	std::vector<std::vector<KamataEngine::WorldTransform*>> worldTransformBlocks_;
+	// チャンクごとのブロックのメッシュ（chunkY * チャンク横数 + chunkX 番目にそのチャンクのメッシュが入る）
+	// 見えている面だけをまとめたもので、チャンクの読み込み時（と隣のチャンクの変化時）に作り直す
+	std::vector<MapChipChunkMesh> blockMeshes_;
+
+	// メッシュを作るときの作業用
+	MapChipMesh blockMeshScratch_;
+
+	// ブロックの面ごとの UV の変換（ブロックのモデルから作る）
+	ModelInstanceBuffer blockFaceUVs_;
+
+	// ブロックのメッシュの描画
+	InstancedModelRenderer* blockRenderer_ = nullptr;
+
+	// チャンクの読み込み・解放イベントの受け取り用
+	std::vector<MapChipChunkEvent> chunkEvents_;
 
 	// ブロックのモデル
 	KamataEngine::Model* modelBlock_ = nullptr;
@@ -90,6 +139,46 @@ private:
 	// スカイドームのモデル
 	KamataEngine::Model* modelSkydome_ = nullptr;
 
+	/*---描画キュー---*/
+
+	// 描画をフレームに1回並べ替えて、パイプラインが変わるところでだけ切り替える
+	RenderQueue renderQueue_;
+
+	// 描画キューの実行先
+	ModelRenderBackend renderBackend_;
+
+	/*---カリング---*/
+
+	// 描画数の統計（描画したもの / 全体）
+	struct DrawStats {
+		uint32_t drawnBlocks = 0;
+		uint32_t totalBlocks = 0;
+		uint32_t drawnBlockTriangles = 0;
+		uint32_t totalBlockTriangles = 0;
+		uint32_t drawnEnemies = 0;
+		uint32_t totalEnemies = 0;
+		uint32_t drawnBullets = 0;
+		uint32_t totalBullets = 0;
+	};
+
+	DrawStats drawStats_;
+
+	// カメラに映る範囲を広げる量（ブロックの奥行きや敵の大きさのはみ出し分）
+	static inline const float kCullingMargin = 2.0f;
+
+	/*---ワールド変換---*/
+
+	// 動いたものだけ行列を作り直す
+	WorldTransformSystem* worldTransformSystem_ = nullptr;
+
+	/*---フレームごとの定数---*/
+
+	// 毎フレーム書き換える行列の置き場（オブジェクトごとにリソースを作らない）
+	FrameRingBuffer frameRing_;
+
+	// リングバッファの大きさ（行列 1 つ 64 バイトを 256 バイト境界で切り出すので、描画 1 回あたり最低 256 バイト使う）
+	static inline const size_t kFrameRingCapacity = 1024 * 1024;
+
 	/*---マップチップフィールド---*/
 
 	MapChipField* mapchipField_;
@@ -0,0 +1,217 @@
+#include "InstancedModelRenderer.h"
+#include <cassert>
+#include <d3dcompiler.h>
+
+#pragma comment(lib, "d3dcompiler.lib")
+
+using namespace KamataEngine;
+using Microsoft::WRL::ComPtr;
+
+void InstancedModelRenderer::Initialize(const wchar_t* vsFilePath, const wchar_t* psFilePath) {
+	ID3D12Device* device = DirectXCommon::GetInstance()->GetDevice();
+	if (!device) {
+		return;
+	}
+
+	/*-------------- シェーダー --------------*/
+	ComPtr<ID3DBlob> vsBlob = CompileShader(vsFilePath, "vs_5_0");
+	ComPtr<ID3DBlob> psBlob = CompileShader(psFilePath, "ps_5_0");
+
+	/*-------------- ルートシグネチャ --------------*/
+	D3D12_DESCRIPTOR_RANGE textureRange{};
+	textureRange.RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+	textureRange.NumDescriptors = 1;
+	textureRange.BaseShaderRegister = 0;
+	textureRange.OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+
+	D3D12_ROOT_PARAMETER rootParameters[kRootParameterCount]{};
+	rootParameters[kInstances].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+	rootParameters[kInstances].Descriptor.ShaderRegister = 1;
+	rootParameters[kInstances].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+
+	rootParameters[kCamera].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+	rootParameters[kCamera].Descriptor.ShaderRegister = 1;
+	rootParameters[kCamera].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+
+	rootParameters[kMaterial].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+	rootParameters[kMaterial].Descriptor.ShaderRegister = 2;
+	rootParameters[kMaterial].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+
+	rootParameters[kTexture].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+	rootParameters[kTexture].DescriptorTable.NumDescriptorRanges = 1;
+	rootParameters[kTexture].DescriptorTable.pDescriptorRanges = &textureRange;
+	rootParameters[kTexture].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+
+	rootParameters[kLight].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+	rootParameters[kLight].Descriptor.ShaderRegister = 3;
+	rootParameters[kLight].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+
+	rootParameters[kObjectColor].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+	rootParameters[kObjectColor].Descriptor.ShaderRegister = 4;
+	rootParameters[kObjectColor].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+
+	D3D12_STATIC_SAMPLER_DESC sampler{};
+	sampler.Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
+	sampler.AddressU = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+	sampler.AddressV = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+	sampler.AddressW = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+	sampler.ComparisonFunc = D3D12_COMPARISON_FUNC_NEVER;
+	sampler.MaxLOD = D3D12_FLOAT32_MAX;
+	sampler.ShaderRegister = 0;
+	sampler.ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+
+	D3D12_ROOT_SIGNATURE_DESC rootSignatureDesc{};
+	rootSignatureDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
+	rootSignatureDesc.NumParameters = kRootParameterCount;
+	rootSignatureDesc.pParameters = rootParameters;
+	rootSignatureDesc.NumStaticSamplers = 1;
+	rootSignatureDesc.pStaticSamplers = &sampler;
+
+	ComPtr<ID3DBlob> signatureBlob;
+	ComPtr<ID3DBlob> errorBlob;
+	HRESULT result = D3D12SerializeRootSignature(&rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signatureBlob, &errorBlob);
+	assert(SUCCEEDED(result));
+	result = device->CreateRootSignature(0, signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize(), IID_PPV_ARGS(&rootSignature_));
+	assert(SUCCEEDED(result));
+
+	/*-------------- パイプライン --------------*/
+	// 頂点レイアウトは Mesh::VertexPosNormalUv と同じ
+	D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
+	    {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"NORMAL",   0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,    0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	};
+
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC pipelineDesc{};
+	pipelineDesc.pRootSignature = rootSignature_.Get();
+	pipelineDesc.VS = {vsBlob->GetBufferPointer(), vsBlob->GetBufferSize()};
+	pipelineDesc.PS = {psBlob->GetBufferPointer(), psBlob->GetBufferSize()};
+	pipelineDesc.InputLayout = {inputLayout, _countof(inputLayout)};
+	pipelineDesc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+	pipelineDesc.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
+	pipelineDesc.SampleDesc.Count = 1;
+
+	// ブロックは不透明なのでブレンドなし・バックカリング・デプステストあり（Model::PreDraw(kBack, kNone, kOn) 相当）
+	pipelineDesc.BlendState.RenderTarget[0].RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+	pipelineDesc.RasterizerState.FillMode = D3D12_FILL_MODE_SOLID;
+	pipelineDesc.RasterizerState.CullMode = D3D12_CULL_MODE_BACK;
+	pipelineDesc.RasterizerState.DepthClipEnable = true;
+	pipelineDesc.DepthStencilState.DepthEnable = true;
+	pipelineDesc.DepthStencilState.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ALL;
+	pipelineDesc.DepthStencilState.DepthFunc = D3D12_COMPARISON_FUNC_LESS;
+	pipelineDesc.DSVFormat = kDepthStencilFormat;
+	pipelineDesc.NumRenderTargets = 1;
+	pipelineDesc.RTVFormats[0] = kRenderTargetFormat;
+
+	result = device->CreateGraphicsPipelineState(&pipelineDesc, IID_PPV_ARGS(&pipelineState_));
+	assert(SUCCEEDED(result));
+}
+
+void InstancedModelRenderer::BeginPass(const Camera& camera) {
+	passCommandList_ = SetPipelineCommands(camera);
+	inPass_ = true;
+}
+
+void InstancedModelRenderer::EndPass() {
+	passCommandList_ = nullptr;
+	inPass_ = false;
+}
+
+void InstancedModelRenderer::Draw(Model& model, const ModelInstanceBuffer& instances, const Camera& camera) {
+	Draw(model, instances.GetGPUVirtualAddress(), instances.GetInstanceCount(), camera);
+}
+
+void InstancedModelRenderer::Draw(Model& model, D3D12_GPU_VIRTUAL_ADDRESS instances, uint32_t instanceCount, const Camera& camera) {
+	if (instanceCount == 0) {
+		return;
+	}
+
+	ID3D12GraphicsCommandList* commandList = SetCommonCommands(instances, camera);
+
+	// メッシュごとに1回だけ描画する
+	for (const std::unique_ptr<Mesh>& mesh : model.GetMeshes()) {
+		const uint32_t indexCount = static_cast<uint32_t>(mesh->GetIndices().size());
+
+		if (commandList) {
+			commandList->IASetVertexBuffers(0, 1, &mesh->GetVBView());
+			commandList->IASetIndexBuffer(&mesh->GetIBView());
+			mesh->GetMaterial()->SetGraphicsCommand(commandList, kMaterial, kTexture);
+			commandList->DrawIndexedInstanced(indexCount, instanceCount, 0, 0, 0);
+		}
+
+		drawRecords_.push_back({mesh.get(), indexCount, instanceCount});
+	}
+}
+
+void InstancedModelRenderer::DrawIndexed(
+    const D3D12_VERTEX_BUFFER_VIEW& vbView, const D3D12_INDEX_BUFFER_VIEW& ibView, uint32_t indexCount, Material& material, const ModelInstanceBuffer& matrices, uint32_t instanceCount,
+    const Camera& camera) {
+	if (indexCount == 0 || instanceCount == 0) {
+		return;
+	}
+
+	ID3D12GraphicsCommandList* commandList = SetCommonCommands(matrices.GetGPUVirtualAddress(), camera);
+	if (commandList) {
+		commandList->IASetVertexBuffers(0, 1, &vbView);
+		commandList->IASetIndexBuffer(&ibView);
+		material.SetGraphicsCommand(commandList, kMaterial, kTexture);
+		commandList->DrawIndexedInstanced(indexCount, instanceCount, 0, 0, 0);
+	}
+
+	drawRecords_.push_back({nullptr, indexCount, instanceCount});
+}
+
+ID3D12GraphicsCommandList* InstancedModelRenderer::SetPipelineCommands(const Camera& camera) {
+	// コマンドリストが無い（PreDraw の外、またはデバイスの無い環境）ときは記録だけする
+	ModelCommon* modelCommon = ModelCommon::GetInstance();
+	ID3D12GraphicsCommandList* commandList = modelCommon->GetCommandList();
+	if (!commandList || !pipelineState_) {
+		return nullptr;
+	}
+
+	commandList->SetPipelineState(pipelineState_.Get());
+	commandList->SetGraphicsRootSignature(rootSignature_.Get());
+	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+	// 描画全体で共通のもの
+	commandList->SetGraphicsRootConstantBufferView(kCamera, camera.GetConstBuffer()->GetGPUVirtualAddress());
+	modelCommon->LightCommand();
+	modelCommon->GetObjectColor()->SetGraphicsCommand(commandList, kObjectColor);
+
+	return commandList;
+}
+
+ID3D12GraphicsCommandList* InstancedModelRenderer::SetCommonCommands(D3D12_GPU_VIRTUAL_ADDRESS matrices, const Camera& camera) {
+	ID3D12GraphicsCommandList* commandList = inPass_ ? passCommandList_ : SetPipelineCommands(camera);
+	if (!commandList || matrices == 0) {
+		return nullptr;
+	}
+
+	commandList->SetGraphicsRootShaderResourceView(kInstances, matrices);
+	return commandList;
+}
+
+uint32_t InstancedModelRenderer::GetDrawnInstanceCount() const {
+	uint32_t count = 0;
+	for (const DrawRecord& record : drawRecords_) {
+		count += record.instanceCount;
+	}
+	return count;
+}
+
+ComPtr<ID3DBlob> InstancedModelRenderer::CompileShader(const wchar_t* filePath, const char* target) {
+	UINT flags = 0;
+#ifdef _DEBUG
+	flags |= D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+#endif // _DEBUG
+
+	ComPtr<ID3DBlob> shaderBlob;
+	ComPtr<ID3DBlob> errorBlob;
+	HRESULT result = D3DCompileFromFile(filePath, nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main", target, flags, 0, &shaderBlob, &errorBlob);
+	if (FAILED(result) && errorBlob) {
+		OutputDebugStringA(static_cast<const char*>(errorBlob->GetBufferPointer()));
+	}
+	assert(SUCCEEDED(result));
+
+	return shaderBlob;
+}
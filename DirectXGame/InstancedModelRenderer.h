@@ -0,0 +1,124 @@
+#pragma once
+#include "KamataEngine.h"
+#include "ModelInstanceBuffer.h"
+#include <vector>
+
+/// <summary>
+/// 同じモデルを複数の行列でまとめて描画する（メッシュ1つにつき描画1回）
+/// </summary>
+class InstancedModelRenderer {
+public:
+	// 描画呼び出しの記録
+	struct DrawRecord {
+		const KamataEngine::Mesh* mesh = nullptr;
+		uint32_t indexCount = 0;
+		uint32_t instanceCount = 0;
+	};
+
+	/// <summary>
+	/// 初期化（シェーダーのコンパイルとパイプラインの生成）
+	/// デバイスが無い環境では描画を記録するだけになる
+	/// </summary>
+	/// <param name="vsFilePath">頂点シェーダー</param>
+	/// <param name="psFilePath">ピクセルシェーダー</param>
+	void Initialize(const wchar_t* vsFilePath = L"Resources/shaders/InstancedObjVS.hlsl", const wchar_t* psFilePath = L"Resources/shaders/ObjPS.hlsl");
+
+	/// <summary>
+	/// パイプラインとカメラなどの共通の定数をまとめて積む
+	/// EndPass までの Draw / DrawIndexed では行列の配列だけを積み直す（カメラはここで渡したものを使う）
+	/// </summary>
+	/// <param name="camera">カメラ</param>
+	void BeginPass(const KamataEngine::Camera& camera);
+
+	/// <summary>
+	/// BeginPass の区間の終わり（以後の Draw は毎回パイプラインから積む）
+	/// </summary>
+	void EndPass();
+
+	/// <summary>
+	/// インスタンス描画
+	/// Model::PreDraw 〜 Model::PostDraw の間で呼ぶ。パイプラインを差し替えるので、同じ区間で後から Model::Draw は呼ばないこと
+	/// </summary>
+	/// <param name="model">モデル</param>
+	/// <param name="instances">インスタンスごとのワールド行列</param>
+	/// <param name="camera">カメラ</param>
+	void Draw(KamataEngine::Model& model, const ModelInstanceBuffer& instances, const KamataEngine::Camera& camera);
+
+	/// <summary>
+	/// インスタンス描画（行列の配列を GPU アドレスで渡す。フレームごとに書き込む動的なオブジェクト用）
+	/// </summary>
+	/// <param name="model">モデル</param>
+	/// <param name="instances">インスタンスごとのワールド行列の GPU アドレス（0 なら記録だけする）</param>
+	/// <param name="instanceCount">インスタンス数</param>
+	/// <param name="camera">カメラ</param>
+	void Draw(KamataEngine::Model& model, D3D12_GPU_VIRTUAL_ADDRESS instances, uint32_t instanceCount, const KamataEngine::Camera& camera);
+
+	/// <summary>
+	/// 頂点・インデックスバッファを直接指定して描画（Model を使わないメッシュ用）
+	/// </summary>
+	/// <param name="vbView">頂点バッファ（頂点は Mesh::VertexPosNormalUv）</param>
+	/// <param name="ibView">インデックスバッファ</param>
+	/// <param name="indexCount">インデックス数</param>
+	/// <param name="material">マテリアル</param>
+	/// <param name="matrices">シェーダーに渡す行列の配列（t1）</param>
+	/// <param name="instanceCount">インスタンス数</param>
+	/// <param name="camera">カメラ</param>
+	void DrawIndexed(
+	    const D3D12_VERTEX_BUFFER_VIEW& vbView, const D3D12_INDEX_BUFFER_VIEW& ibView, uint32_t indexCount, KamataEngine::Material& material, const ModelInstanceBuffer& matrices,
+	    uint32_t instanceCount, const KamataEngine::Camera& camera);
+
+	/// <summary>
+	/// 描画の記録を消す（フレームの始めに呼ぶ）
+	/// </summary>
+	void ClearDrawRecords() { drawRecords_.clear(); }
+
+	// 描画の記録の getter
+	const std::vector<DrawRecord>& GetDrawRecords() const { return drawRecords_; }
+
+	// 描画呼び出し回数の getter
+	uint32_t GetDrawCallCount() const { return static_cast<uint32_t>(drawRecords_.size()); }
+
+	// 描画したインスタンス数の合計の getter
+	uint32_t GetDrawnInstanceCount() const;
+
+private:
+	// ルートパラメータ番号（1番以降は Model と同じ並びにして、エンジン側のコマンド設定をそのまま使う）
+	enum RootParameter {
+		kInstances,   // シェーダーに渡す行列の配列（t1。通常はインスタンスごとのワールド行列）
+		kCamera,      // カメラ（b1）
+		kMaterial,    // マテリアル（b2）
+		kTexture,     // テクスチャ（t0）
+		kLight,       // ライト（b3）
+		kObjectColor, // オブジェクトの色（b4）
+
+		kRootParameterCount,
+	};
+
+	// 描画先のフォーマット（エンジンの 3D 描画と合わせる）
+	static inline const DXGI_FORMAT kRenderTargetFormat = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+	static inline const DXGI_FORMAT kDepthStencilFormat = DXGI_FORMAT_D32_FLOAT;
+
+	// パイプラインとカメラなどの共通の定数を積む。コマンドを積めない（記録だけする）ときは nullptr を返す
+	ID3D12GraphicsCommandList* SetPipelineCommands(const KamataEngine::Camera& camera);
+
+	// 描画ごとのコマンド（BeginPass の区間外ならパイプラインから）を積む。コマンドを積めないときは nullptr を返す
+	ID3D12GraphicsCommandList* SetCommonCommands(D3D12_GPU_VIRTUAL_ADDRESS matrices, const KamataEngine::Camera& camera);
+
+	// シェーダーの読み込み
+	Microsoft::WRL::ComPtr<ID3DBlob> CompileShader(const wchar_t* filePath, const char* target);
+
+	// ルートシグネチャ
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_;
+
+	// パイプライン
+	Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState_;
+
+	// このフレームの描画の記録
+	std::vector<DrawRecord> drawRecords_;
+
+	// BeginPass の区間中かどうか
+	bool inPass_ = false;
+
+	// BeginPass で共通の定数を積んだコマンドリスト（積めなかったときは nullptr）
+	ID3D12GraphicsCommandList* passCommandList_ = nullptr;
+};
@@ -0,0 +1,95 @@
+#include "LinearRingAllocator.h"
+#include <cassert>
+
+namespace {
+
+// alignment（2のべき乗）の倍数に切り上げる
+size_t AlignUp(size_t value, size_t alignment) { return (value + alignment - 1) & ~(alignment - 1); }
+
+} // namespace
+
+void LinearRingAllocator::Initialize(size_t capacity) {
+	capacity_ = capacity;
+	head_ = 0;
+	tail_ = 0;
+	frames_.clear();
+
+	stats_ = {};
+	stats_.capacity = capacity;
+}
+
+size_t LinearRingAllocator::Allocate(size_t size, size_t alignment) {
+	assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+	// 使用中の領域が無ければ先頭から詰め直す
+	if (stats_.usedBytes == 0) {
+		head_ = 0;
+		tail_ = 0;
+	}
+
+	size_t offset = kInvalidOffset;
+	size_t newHead = 0;
+	if (size != 0 && size <= capacity_) {
+		const size_t alignedHead = AlignUp(head_, alignment);
+
+		if (stats_.usedBytes == 0 || head_ > tail_) {
+			// 空きは [head, capacity) と [0, tail) の2つ
+			if (alignedHead + size <= capacity_) {
+				offset = alignedHead;
+				newHead = alignedHead + size;
+			} else if (size <= tail_) {
+				// 末尾に入らないので先頭に折り返す（0 はどのアラインメントも満たす）
+				offset = 0;
+				newHead = size;
+			}
+		} else if (head_ < tail_) {
+			// 空きは [head, tail) だけ
+			if (alignedHead + size <= tail_) {
+				offset = alignedHead;
+				newHead = alignedHead + size;
+			}
+		}
+		// head == tail で使用中なら満杯
+	}
+
+	if (offset == kInvalidOffset) {
+		++stats_.failedAllocations;
+		return kInvalidOffset;
+	}
+
+	// 詰め物（アラインメントや折り返しで飛ばした分）も含めて使用量に数える
+	const size_t consumed = (newHead > head_) ? newHead - head_ : (capacity_ - head_) + newHead;
+	head_ = newHead;
+
+	stats_.usedBytes += consumed;
+	stats_.frameBytes += consumed;
+	++stats_.frameAllocations;
+	if (stats_.usedBytes > stats_.peakUsedBytes) {
+		stats_.peakUsedBytes = stats_.usedBytes;
+	}
+
+	return offset;
+}
+
+void LinearRingAllocator::FinishFrame(uint64_t fenceValue) {
+	// 何も割り当てなかったフレームは待つものが無い
+	if (stats_.frameBytes != 0) {
+		assert(frames_.empty() || frames_.back().fenceValue <= fenceValue);
+		frames_.push_back({fenceValue, head_, stats_.frameBytes});
+	}
+
+	stats_.frameBytes = 0;
+	stats_.frameAllocations = 0;
+	stats_.framesInFlight = static_cast<uint32_t>(frames_.size());
+}
+
+void LinearRingAllocator::Retire(uint64_t completedFenceValue) {
+	while (!frames_.empty() && frames_.front().fenceValue <= completedFenceValue) {
+		const FrameMarker& frame = frames_.front();
+		tail_ = frame.head;
+		stats_.usedBytes -= frame.bytes;
+		frames_.pop_front();
+	}
+
+	stats_.framesInFlight = static_cast<uint32_t>(frames_.size());
+}
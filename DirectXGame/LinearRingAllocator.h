@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+/// <summary>
+/// フレーム単位で解放するリングバッファの割り当て計算
+/// GPU のリソースには触らず、オフセットの計算だけをする（デバイスの無い環境でも動作を確かめられる）
+/// </summary>
+class LinearRingAllocator {
+public:
+	// 割り当てに失敗したときのオフセット
+	static inline const size_t kInvalidOffset = SIZE_MAX;
+
+	// 使用状況
+	struct Stats {
+		size_t capacity = 0;      // 全体の大きさ
+		size_t usedBytes = 0;     // GPU がまだ使っている可能性のあるバイト数（詰め物を含む）
+		size_t peakUsedBytes = 0; // usedBytes の最大値
+		size_t frameBytes = 0;    // 今のフレームで割り当てたバイト数（詰め物を含む）
+		uint32_t frameAllocations = 0;   // 今のフレームの割り当て回数
+		uint32_t failedAllocations = 0;  // 空きが足りずに失敗した回数（累計）
+		uint32_t framesInFlight = 0;     // 解放待ちのフレーム数
+	};
+
+	/// <summary>
+	/// 初期化（以前の割り当てはすべて破棄する）
+	/// </summary>
+	/// <param name="capacity">リング全体のバイト数</param>
+	void Initialize(size_t capacity);
+
+	/// <summary>
+	/// 割り当て
+	/// 末尾に収まらないときは先頭に折り返す（末尾の余りは詰め物としてそのフレームの使用量に数える）
+	/// </summary>
+	/// <param name="size">バイト数</param>
+	/// <param name="alignment">アラインメント（2のべき乗）</param>
+	/// <returns>リング先頭からのオフセット。空きが無ければ kInvalidOffset</returns>
+	size_t Allocate(size_t size, size_t alignment);
+
+	/// <summary>
+	/// フレームの終わり。このフレームの割り当てにフェンス値を付けて解放待ちにする
+	/// </summary>
+	/// <param name="fenceValue">このフレームの描画が終わったときに完了するフェンス値</param>
+	void FinishFrame(uint64_t fenceValue);
+
+	/// <summary>
+	/// 完了したフレームの領域を解放する
+	/// </summary>
+	/// <param name="completedFenceValue">GPU が完了したフェンス値</param>
+	void Retire(uint64_t completedFenceValue);
+
+	// 使用状況の getter
+	const Stats& GetStats() const { return stats_; }
+
+private:
+	// 解放待ちのフレーム
+	struct FrameMarker {
+		uint64_t fenceValue = 0; // 完了を待つフェンス値
+		size_t head = 0;         // フレーム終わりの書き込み位置（解放後の tail になる）
+		size_t bytes = 0;        // このフレームで使ったバイト数
+	};
+
+	// 全体の大きさ
+	size_t capacity_ = 0;
+
+	// 次に書き込む位置
+	size_t head_ = 0;
+
+	// GPU が使っている可能性のある領域の先頭
+	size_t tail_ = 0;
+
+	// 解放待ちのフレーム（古い順）
+	std::deque<FrameMarker> frames_;
+
+	// 使用状況
+	Stats stats_;
+};
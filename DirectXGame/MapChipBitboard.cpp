@@ -0,0 +1,146 @@
+#define NOMINMAX
+#include "MapChipBitboard.h"
+#include <algorithm>
+#include <bit>
+
+void MapChipBitboard::Build(const MapChipData& data) {
+
+	width_ = data.width;
+	height_ = data.height;
+	wordsPerRow_ = (width_ + 63) / 64;
+	words_.assign(static_cast<size_t>(wordsPerRow_) * height_, 0);
+
+	UpdateRegion(data, 0, 0, width_, height_);
+}
+
+void MapChipBitboard::UpdateRegion(const MapChipData& data, uint32_t xIndex, uint32_t yIndex, uint32_t numX, uint32_t numY) {
+
+	if (numX == 0 || numY == 0 || xIndex >= width_ || yIndex >= height_) {
+		return;
+	}
+
+	// 範囲に掛かるワードをまるごと詰め直す
+	const uint32_t word0 = xIndex >> 6;
+	const uint32_t word1 = (std::min(xIndex + numX, width_) - 1) >> 6;
+	const uint32_t y1 = std::min(yIndex + numY, height_);
+
+	for (uint32_t y = yIndex; y < y1; ++y) {
+		const MapChipType* row = &data.Data[static_cast<size_t>(y) * width_];
+
+		for (uint32_t word = word0; word <= word1; ++word) {
+			const uint32_t x0 = word * 64;
+			const uint32_t x1 = std::min(x0 + 64, width_);
+
+			uint64_t bits = 0;
+			for (uint32_t x = x0; x < x1; ++x) {
+				bits |= static_cast<uint64_t>(row[x] == MapChipType::kBlock) << (x - x0);
+			}
+			words_[static_cast<size_t>(y) * wordsPerRow_ + word] = bits;
+		}
+	}
+}
+
+bool MapChipBitboard::AnySolid(uint32_t yIndex, uint32_t xIndex0, uint32_t xIndex1) const {
+
+	if (yIndex >= height_ || xIndex0 >= width_ || xIndex0 > xIndex1) {
+		return false;
+	}
+	xIndex1 = std::min(xIndex1, width_ - 1);
+
+	const uint64_t* row = &words_[static_cast<size_t>(yIndex) * wordsPerRow_];
+	const uint32_t word0 = xIndex0 >> 6;
+	const uint32_t word1 = xIndex1 >> 6;
+
+	// 1ワードに収まる場合
+	if (word0 == word1) {
+		return (row[word0] & SpanMask(xIndex0 & 63, xIndex1 & 63)) != 0;
+	}
+
+	// 両端のワードは一部、間のワードは丸ごと調べる
+	if ((row[word0] & SpanMask(xIndex0 & 63, 63)) != 0 || (row[word1] & SpanMask(0, xIndex1 & 63)) != 0) {
+		return true;
+	}
+	for (uint32_t word = word0 + 1; word < word1; ++word) {
+		if (row[word] != 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+uint32_t MapChipBitboard::CountSolid(uint32_t yIndex, uint32_t xIndex0, uint32_t xIndex1) const {
+
+	if (yIndex >= height_ || xIndex0 >= width_ || xIndex0 > xIndex1) {
+		return 0;
+	}
+	xIndex1 = std::min(xIndex1, width_ - 1);
+
+	const uint64_t* row = &words_[static_cast<size_t>(yIndex) * wordsPerRow_];
+	const uint32_t word0 = xIndex0 >> 6;
+	const uint32_t word1 = xIndex1 >> 6;
+
+	if (word0 == word1) {
+		return static_cast<uint32_t>(std::popcount(row[word0] & SpanMask(xIndex0 & 63, xIndex1 & 63)));
+	}
+
+	uint32_t count = static_cast<uint32_t>(std::popcount(row[word0] & SpanMask(xIndex0 & 63, 63)) + std::popcount(row[word1] & SpanMask(0, xIndex1 & 63)));
+	for (uint32_t word = word0 + 1; word < word1; ++word) {
+		count += static_cast<uint32_t>(std::popcount(row[word]));
+	}
+
+	return count;
+}
+
+int64_t MapChipBitboard::FindNextSolidRight(uint32_t yIndex, uint32_t xIndex) const {
+
+	if (yIndex >= height_ || xIndex >= width_) {
+		return kNotFound;
+	}
+
+	const uint64_t* row = &words_[static_cast<size_t>(yIndex) * wordsPerRow_];
+
+	// 最初のワードは xIndex より左のビットを落としてから探す
+	uint32_t word = xIndex >> 6;
+	uint64_t bits = row[word] & SpanMask(xIndex & 63, 63);
+
+	while (true) {
+		if (bits != 0) {
+			return static_cast<int64_t>(word) * 64 + std::countr_zero(bits);
+		}
+		if (++word >= wordsPerRow_) {
+			return kNotFound;
+		}
+		bits = row[word];
+	}
+}
+
+int64_t MapChipBitboard::FindNextSolidLeft(uint32_t yIndex, uint32_t xIndex) const {
+
+	if (yIndex >= height_ || width_ == 0) {
+		return kNotFound;
+	}
+	xIndex = std::min(xIndex, width_ - 1);
+
+	const uint64_t* row = &words_[static_cast<size_t>(yIndex) * wordsPerRow_];
+
+	// 最初のワードは xIndex より右のビットを落としてから探す
+	uint32_t word = xIndex >> 6;
+	uint64_t bits = row[word] & SpanMask(0, xIndex & 63);
+
+	while (true) {
+		if (bits != 0) {
+			return static_cast<int64_t>(word) * 64 + 63 - std::countl_zero(bits);
+		}
+		if (word-- == 0) {
+			return kNotFound;
+		}
+		bits = row[word];
+	}
+}
+
+uint64_t MapChipBitboard::SpanMask(uint32_t xIndex0, uint32_t xIndex1) {
+	// xIndex1 + 1 が 64 になるとシフトが未定義になるので分けて作る
+	const uint64_t upper = (xIndex1 >= 63) ? ~uint64_t(0) : ((uint64_t(1) << (xIndex1 + 1)) - 1);
+	return upper & (~uint64_t(0) << xIndex0);
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "MapChipField.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// マップチップのブロックを1タイル1ビットで行ごとに詰めたビットボード
+/// 行内の範囲の問い合わせを 64 タイル単位のビット演算で行う
+/// </summary>
+class MapChipBitboard {
+public:
+	// 見つからなかったときの戻り値
+	static inline const int64_t kNotFound = -1;
+
+	/// <summary>
+	/// マップ全体から作り直す
+	/// </summary>
+	void Build(const MapChipData& data);
+
+	/// <summary>
+	/// タイルが変更された範囲だけ作り直す
+	/// </summary>
+	/// <param name="data">マップチップデータ</param>
+	/// <param name="xIndex">範囲の左端</param>
+	/// <param name="yIndex">範囲の上端</param>
+	/// <param name="numX">横のタイル数</param>
+	/// <param name="numY">縦のタイル数</param>
+	void UpdateRegion(const MapChipData& data, uint32_t xIndex, uint32_t yIndex, uint32_t numX, uint32_t numY);
+
+	/// <summary>
+	/// 行 yIndex の xIndex0..xIndex1（両端を含む）にブロックがあるか（マップ外は空白扱い）
+	/// </summary>
+	bool AnySolid(uint32_t yIndex, uint32_t xIndex0, uint32_t xIndex1) const;
+
+	/// <summary>
+	/// 行 yIndex の xIndex0..xIndex1（両端を含む）のブロック数
+	/// </summary>
+	uint32_t CountSolid(uint32_t yIndex, uint32_t xIndex0, uint32_t xIndex1) const;
+
+	/// <summary>
+	/// 行 yIndex で xIndex から右（xIndex を含む）に向かって最初のブロック
+	/// </summary>
+	/// <returns>ブロックの xIndex（無ければ kNotFound）</returns>
+	int64_t FindNextSolidRight(uint32_t yIndex, uint32_t xIndex) const;
+
+	/// <summary>
+	/// 行 yIndex で xIndex から左（xIndex を含む）に向かって最初のブロック
+	/// </summary>
+	/// <returns>ブロックの xIndex（無ければ kNotFound）</returns>
+	int64_t FindNextSolidLeft(uint32_t yIndex, uint32_t xIndex) const;
+
+	// タイルがブロックか
+	bool IsSolid(uint32_t xIndex, uint32_t yIndex) const {
+		if (xIndex >= width_ || yIndex >= height_) {
+			return false;
+		}
+		return (words_[static_cast<size_t>(yIndex) * wordsPerRow_ + (xIndex >> 6)] >> (xIndex & 63)) & 1;
+	}
+
+	// 作成済みのマップと大きさが一致しているか
+	bool IsBuiltFor(const MapChipData& data) const { return width_ == data.width && height_ == data.height; }
+
+private:
+	// xIndex0..xIndex1（同じワード内）のビットが立つマスク
+	static uint64_t SpanMask(uint32_t xIndex0, uint32_t xIndex1);
+
+	// マップの大きさ
+	uint32_t width_ = 0;
+	uint32_t height_ = 0;
+
+	// 1行のワード数
+	uint32_t wordsPerRow_ = 0;
+
+	// 行優先（words_[yIndex * wordsPerRow_ + xIndex / 64] の xIndex % 64 ビット目）
+	std::vector<uint64_t> words_;
+};
@@ -0,0 +1,75 @@
+#include "MapChipChunkMesh.h"
+#include <cassert>
+#include <cstring>
+
+using namespace KamataEngine;
+using Microsoft::WRL::ComPtr;
+
+namespace {
+
+// アップロードヒープにバッファを作ってデータを書き込む（一度書いたら書き換えない）
+ComPtr<ID3D12Resource> CreateUploadBuffer(ID3D12Device* device, const void* data, size_t size) {
+	D3D12_HEAP_PROPERTIES heapProperties{};
+	heapProperties.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+	D3D12_RESOURCE_DESC resourceDesc{};
+	resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+	resourceDesc.Width = size;
+	resourceDesc.Height = 1;
+	resourceDesc.DepthOrArraySize = 1;
+	resourceDesc.MipLevels = 1;
+	resourceDesc.SampleDesc.Count = 1;
+	resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+	ComPtr<ID3D12Resource> resource;
+	HRESULT result = device->CreateCommittedResource(
+	    &heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&resource));
+	assert(SUCCEEDED(result));
+
+	void* mapped = nullptr;
+	result = resource->Map(0, nullptr, &mapped);
+	assert(SUCCEEDED(result));
+	std::memcpy(mapped, data, size);
+	resource->Unmap(0, nullptr);
+
+	return resource;
+}
+
+} // namespace
+
+void MapChipChunkMesh::Create(const MapChipMesh& mesh) {
+	Release();
+
+	indexCount_ = static_cast<uint32_t>(mesh.indices.size());
+	blockCount_ = mesh.blockCount;
+	if (mesh.indices.empty()) {
+		return;
+	}
+
+	// デバイスが無い環境（描画を記録するだけの場合）では数だけを持つ
+	ID3D12Device* device = DirectXCommon::GetInstance()->GetDevice();
+	if (!device) {
+		return;
+	}
+
+	const size_t vertexBytes = sizeof(Mesh::VertexPosNormalUv) * mesh.vertices.size();
+	vertexBuffer_ = CreateUploadBuffer(device, mesh.vertices.data(), vertexBytes);
+	vbView_.BufferLocation = vertexBuffer_->GetGPUVirtualAddress();
+	vbView_.SizeInBytes = static_cast<UINT>(vertexBytes);
+	vbView_.StrideInBytes = sizeof(Mesh::VertexPosNormalUv);
+
+	const size_t indexBytes = sizeof(uint32_t) * mesh.indices.size();
+	indexBuffer_ = CreateUploadBuffer(device, mesh.indices.data(), indexBytes);
+	ibView_.BufferLocation = indexBuffer_->GetGPUVirtualAddress();
+	ibView_.SizeInBytes = static_cast<UINT>(indexBytes);
+	ibView_.Format = DXGI_FORMAT_R32_UINT;
+}
+
+void MapChipChunkMesh::Release() {
+	vertexBuffer_.Reset();
+	indexBuffer_.Reset();
+	vbView_ = {};
+	ibView_ = {};
+	indexCount_ = 0;
+	blockCount_ = 0;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include "KamataEngine.h"
+#include "MapChipMeshBuilder.h"
+
+/// <summary>
+/// チャンク1つ分のマップのメッシュの頂点・インデックスバッファ
+/// </summary>
+class MapChipChunkMesh {
+public:
+	/// <summary>
+	/// メッシュからバッファを生成する（以前の内容は破棄する）
+	/// </summary>
+	void Create(const MapChipMesh& mesh);
+
+	/// <summary>
+	/// バッファを破棄する
+	/// </summary>
+	void Release();
+
+	// getter
+	const D3D12_VERTEX_BUFFER_VIEW& GetVBView() const { return vbView_; }
+	const D3D12_INDEX_BUFFER_VIEW& GetIBView() const { return ibView_; }
+	uint32_t GetIndexCount() const { return indexCount_; }
+	uint32_t GetTriangleCount() const { return indexCount_ / 3; }
+	uint32_t GetBlockCount() const { return blockCount_; }
+
+private:
+	// 頂点バッファ
+	Microsoft::WRL::ComPtr<ID3D12Resource> vertexBuffer_;
+	D3D12_VERTEX_BUFFER_VIEW vbView_{};
+
+	// インデックスバッファ
+	Microsoft::WRL::ComPtr<ID3D12Resource> indexBuffer_;
+	D3D12_INDEX_BUFFER_VIEW ibView_{};
+
+	uint32_t indexCount_ = 0;
+	uint32_t blockCount_ = 0;
+};
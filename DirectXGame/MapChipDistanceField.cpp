@@ -0,0 +1,124 @@
+#define NOMINMAX
+#include "MapChipDistanceField.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// ブロックが無い場所の2乗距離（放物線の交点計算が溢れない程度に大きな値）
+const float kFar = 1.0e20f;
+
+} // namespace
+
+void MapChipDistanceField::Build(const MapChipData& data) {
+
+	width_ = data.width;
+	height_ = data.height;
+	distances_.assign(static_cast<size_t>(width_) * height_, kMaxDistance);
+
+	if (width_ == 0 || height_ == 0) {
+		return;
+	}
+
+	Compute(data, 0, 0, width_ - 1, height_ - 1);
+}
+
+void MapChipDistanceField::UpdateRegion(const MapChipData& data, uint32_t xIndex, uint32_t yIndex, uint32_t numX, uint32_t numY) {
+
+	if (numX == 0 || numY == 0 || xIndex >= width_ || yIndex >= height_) {
+		return;
+	}
+
+	// 変更されたタイルから kMaxDistance 以内のタイルの距離が変わりうる
+	const uint32_t margin = static_cast<uint32_t>(std::ceil(kMaxDistance));
+	const uint32_t x0 = (xIndex > margin) ? xIndex - margin : 0;
+	const uint32_t y0 = (yIndex > margin) ? yIndex - margin : 0;
+	const uint32_t x1 = std::min(xIndex + numX - 1 + margin, width_ - 1);
+	const uint32_t y1 = std::min(yIndex + numY - 1 + margin, height_ - 1);
+
+	Compute(data, x0, y0, x1, y1);
+}
+
+void MapChipDistanceField::Compute(const MapChipData& data, uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1) {
+
+	// 出力範囲のタイルから kMaxDistance 以内にあるブロックを全て含む入力範囲
+	// （それより遠いブロックは打ち切り後の距離に影響しない）
+	const uint32_t margin = static_cast<uint32_t>(std::ceil(kMaxDistance));
+	const uint32_t inX0 = (x0 > margin) ? x0 - margin : 0;
+	const uint32_t inY0 = (y0 > margin) ? y0 - margin : 0;
+	const uint32_t inX1 = std::min(x1 + margin, width_ - 1);
+	const uint32_t inY1 = std::min(y1 + margin, height_ - 1);
+	const uint32_t inWidth = inX1 - inX0 + 1;
+	const uint32_t inHeight = inY1 - inY0 + 1;
+
+	const uint32_t lineLength = std::max(inWidth, inHeight);
+	lineIn_.resize(lineLength);
+	lineOut_.resize(lineLength);
+	hullVertices_.resize(lineLength);
+	hullBounds_.resize(lineLength + 1);
+	columnPass_.resize(static_cast<size_t>(inWidth) * inHeight);
+
+	// 1段目: 列ごとに縦方向の2乗距離を求める
+	for (uint32_t x = inX0; x <= inX1; ++x) {
+		for (uint32_t y = inY0; y <= inY1; ++y) {
+			lineIn_[y - inY0] = (data.Data[static_cast<size_t>(y) * width_ + x] == MapChipType::kBlock) ? 0.0f : kFar;
+		}
+
+		Transform1D(lineIn_.data(), lineOut_.data(), inHeight);
+
+		for (uint32_t y = 0; y < inHeight; ++y) {
+			columnPass_[static_cast<size_t>(y) * inWidth + (x - inX0)] = lineOut_[y];
+		}
+	}
+
+	// 2段目: 出力範囲の行ごとに横方向へ広げる
+	for (uint32_t y = y0; y <= y1; ++y) {
+		Transform1D(&columnPass_[static_cast<size_t>(y - inY0) * inWidth], lineOut_.data(), inWidth);
+
+		for (uint32_t x = x0; x <= x1; ++x) {
+			distances_[static_cast<size_t>(y) * width_ + x] = std::min(std::sqrt(lineOut_[x - inX0]), kMaxDistance);
+		}
+	}
+}
+
+void MapChipDistanceField::Transform1D(const float* f, float* d, uint32_t n) {
+
+	// 各要素を頂点とする放物線の下側の包絡線を求める
+	// v: 包絡線を作る放物線の頂点, z: 隣り合う放物線の境界
+	const float kInfinity = std::numeric_limits<float>::infinity();
+	int32_t* v = hullVertices_.data();
+	float* z = hullBounds_.data();
+
+	int32_t k = 0;
+	v[0] = 0;
+	z[0] = -kInfinity;
+	z[1] = kInfinity;
+
+	// 2つの放物線の交点
+	// ((f[q] + q^2) - (f[p] + p^2)) / 2(q - p) を q^2 を作らない形にしたもの（長い行でも float の精度が落ちない）
+	auto intersect = [f](int32_t p, int32_t q) { return (f[q] - f[p]) / (2.0f * static_cast<float>(q - p)) + static_cast<float>(q + p) / 2.0f; };
+
+	for (int32_t q = 1; q < static_cast<int32_t>(n); ++q) {
+		float s = intersect(v[k], q);
+		while (s <= z[k]) {
+			--k;
+			s = intersect(v[k], q);
+		}
+
+		++k;
+		v[k] = q;
+		z[k] = s;
+		z[k + 1] = kInfinity;
+	}
+
+	// 包絡線から各要素の値を読み出す
+	k = 0;
+	for (int32_t q = 0; q < static_cast<int32_t>(n); ++q) {
+		while (z[k + 1] < static_cast<float>(q)) {
+			++k;
+		}
+		const float diff = static_cast<float>(q - v[k]);
+		d[q] = diff * diff + f[v[k]];
+	}
+}
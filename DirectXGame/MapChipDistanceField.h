@@ -0,0 +1,64 @@
+#pragma once
+#include "MapChipField.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// マップチップのブロックまでの距離場（ユークリッド距離変換）
+/// 各タイルの中心から最も近いブロックの中心までの距離（タイル単位）を持つ
+/// 距離は kMaxDistance で打ち切るので、タイルの変更時はその周囲だけを作り直せばよい
+/// </summary>
+class MapChipDistanceField {
+public:
+	// 保持する距離の上限（タイル数）
+	static inline const float kMaxDistance = 16.0f;
+
+	/// <summary>
+	/// マップ全体から作り直す
+	/// </summary>
+	void Build(const MapChipData& data);
+
+	/// <summary>
+	/// タイルが変更された範囲の影響を受けるタイルだけ作り直す
+	/// </summary>
+	/// <param name="data">マップチップデータ</param>
+	/// <param name="xIndex">範囲の左端</param>
+	/// <param name="yIndex">範囲の上端</param>
+	/// <param name="numX">横のタイル数</param>
+	/// <param name="numY">縦のタイル数</param>
+	void UpdateRegion(const MapChipData& data, uint32_t xIndex, uint32_t yIndex, uint32_t numX, uint32_t numY);
+
+	// タイルの中心から最も近いブロックの中心までの距離（タイル単位、kMaxDistance で打ち切り）
+	float GetDistance(uint32_t xIndex, uint32_t yIndex) const { return distances_[static_cast<size_t>(yIndex) * width_ + xIndex]; }
+
+	// 作成済みのマップと大きさが一致しているか
+	bool IsBuiltFor(const MapChipData& data) const { return width_ == data.width && height_ == data.height; }
+
+private:
+	/// <summary>
+	/// 出力範囲（両端を含む）の距離を、そこから kMaxDistance 以内のタイルだけを使って求める
+	/// </summary>
+	void Compute(const MapChipData& data, uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1);
+
+	/// <summary>
+	/// 1次元の2乗距離変換（Felzenszwalb & Huttenlocher）
+	/// </summary>
+	/// <param name="f">入力（ブロックは 0、それ以外は十分大きな値）</param>
+	/// <param name="d">出力（2乗距離）</param>
+	/// <param name="n">要素数</param>
+	void Transform1D(const float* f, float* d, uint32_t n);
+
+	// マップの大きさ
+	uint32_t width_ = 0;
+	uint32_t height_ = 0;
+
+	// 行優先の距離（タイル単位）
+	std::vector<float> distances_;
+
+	// 計算用の作業領域
+	std::vector<float> columnPass_;
+	std::vector<float> lineIn_;
+	std::vector<float> lineOut_;
+	std::vector<int32_t> hullVertices_;
+	std::vector<float> hullBounds_;
+};
@@ -1,47 +1,182 @@
+#define NOMINMAX
 #include "MapChipField.h"
+#include "MapChipBitboard.h"
+#include "MapChipDistanceField.h"
+#include "MapChipOccupancyPyramid.h"
+#include "MapChipStreamer.h"
+#include "MappedFile.h"
+#include "TextToken.h"
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstring>
+#include <emmintrin.h>
+#include <filesystem>
 #include <fstream>
-#include <map>
-#include <sstream>
-#include <cctype>
+#include <limits>
+#include <string_view>
 
 using namespace KamataEngine;
 
 namespace {
 
-// マップチップ用トークンテーブル
-std::map<std::string, MapChipType> mapChipTable = {
-    {"0", MapChipType::kBlank},
-    {"1", MapChipType::kBlock},
+// トークンの種類
+enum class TokenKind {
+	kUnknown,  // 不明（空白扱い）
+	kMapChip,  // マップチップ
+	kEnemy,    // 敵
 };
 
-// 敵トークンテーブル（CSV内で敵を表すトークンをここに追加）
-std::map<std::string, EnemyType> enemyTable = {
-    {"E1", EnemyType::kSlime},
-    {"E2", EnemyType::kBat},
-};
+// CSV のトークンを分類する
+// マップチップ: "0" 空白 / "1" ブロック
+// 敵        : "E1" スライム / "E2" コウモリ（敵を追加する場合はここに case を追加）
+inline TokenKind ClassifyToken(std::string_view token, MapChipType& mapChipType, EnemyType& enemyType) {
+	switch (token.size()) {
+	case 1:
+		switch (token[0]) {
+		case '0':
+			mapChipType = MapChipType::kBlank;
+			return TokenKind::kMapChip;
+		case '1':
+			mapChipType = MapChipType::kBlock;
+			return TokenKind::kMapChip;
+		}
+		break;
+	case 2:
+		if (token[0] != 'E') {
+			break;
+		}
+		switch (token[1]) {
+		case '1':
+			enemyType = EnemyType::kSlime;
+			return TokenKind::kEnemy;
+		case '2':
+			enemyType = EnemyType::kBat;
+			return TokenKind::kEnemy;
+		}
+		break;
+	}
+	return TokenKind::kUnknown;
+}
+
+// 列数が増えたときに、読み込み済みの行を新しい行幅で並べ直す
+// （通常は1行目で幅が決まるため、列数が揃っていない CSV でのみ通る）
+void RestrideRows(std::vector<MapChipType>& tiles, uint32_t oldWidth, uint32_t newWidth, uint32_t rows) {
+	std::vector<MapChipType> restrided(static_cast<size_t>(newWidth) * rows, MapChipType::kBlank);
+	for (uint32_t y = 0; y < rows; ++y) {
+		std::copy_n(tiles.begin() + static_cast<size_t>(y) * oldWidth, oldWidth, restrided.begin() + static_cast<size_t>(y) * newWidth);
+	}
+	// 未処理分（現在の行）を後ろに付け直す
+	restrided.insert(restrided.end(), tiles.begin() + static_cast<size_t>(oldWidth) * rows, tiles.end());
+	tiles.swap(restrided);
+}
+
+// ベイク済みマップの識別子
+const char kMapChipBinaryMagic[4] = {'M', 'C', 'H', 'P'};
+
+// ベイク済みマップのヘッダを読み出して検証する
+bool ReadMapChipBinaryHeader(const MappedFile& file, MapChipBinaryHeader& header) {
+
+	const size_t size = file.GetSize();
+
+	if (size < sizeof(MapChipBinaryHeader)) {
+		return false;
+	}
+
+	std::memcpy(&header, file.GetData(), sizeof(header));
+
+	if (std::memcmp(header.magic, kMapChipBinaryMagic, sizeof(header.magic)) != 0 || header.version != kMapChipBinaryVersion) {
+		return false;
+	}
+
+	// 各ブロックがファイル内に収まっているか確認
+	const size_t tileBytes = static_cast<size_t>(header.width) * header.height;
+	const size_t spawnBytes = static_cast<size_t>(header.enemySpawnCount) * sizeof(MapChipBinaryEnemySpawn);
+	if (header.tileOffset > size || tileBytes > size - header.tileOffset) {
+		return false;
+	}
+	if (header.enemySpawnOffset > size || spawnBytes > size - header.enemySpawnOffset) {
+		return false;
+	}
+
+	return true;
+}
 
-// 末尾の改行やスペース、CR を取り除く簡易トリム
-inline void TrimToken(std::string& s) {
-    // remove trailing whitespace
-    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) s.pop_back();
-    // remove leading whitespace
-    size_t i = 0;
-    while (i < s.size() && std::isspace(static_cast<unsigned char>(s[i]))) ++i;
-    if (i) s.erase(0, i);
+// ベイク済みマップの敵スポーン表を読み出す
+// 種別やタイル番号がおかしい要素が1つでもあればファイルが壊れているとみなし、false を返す
+bool ReadMapChipBinaryEnemySpawns(const MappedFile& file, const MapChipBinaryHeader& header, std::vector<EnemySpawn>& enemySpawns) {
+
+	enemySpawns.resize(header.enemySpawnCount);
+	for (uint32_t i = 0; i < header.enemySpawnCount; ++i) {
+		MapChipBinaryEnemySpawn record;
+		std::memcpy(&record, file.GetData() + header.enemySpawnOffset + i * sizeof(MapChipBinaryEnemySpawn), sizeof(record));
+
+		if (record.type > static_cast<uint32_t>(EnemyType::kBat) || record.xIndex >= header.width || record.yIndex >= header.height) {
+			enemySpawns.clear();
+			return false;
+		}
+
+		enemySpawns[i].type = static_cast<EnemyType>(record.type);
+		enemySpawns[i].index.xIndex = record.xIndex;
+		enemySpawns[i].index.yIndex = record.yIndex;
+	}
+
+	return true;
 }
 
+// ベイク済みマップのタイルがすべて知っている種別（空白かブロック）か
+// 壊れた・古い形式のファイルのバイトをそのまま MapChipType にすると、どこでも扱っていない値になるので読む前に弾く
+bool ValidateMapChipBinaryTiles(const MappedFile& file, const MapChipBinaryHeader& header) {
+
+	const uint8_t* tiles = file.GetData() + header.tileOffset;
+	const size_t tileBytes = static_cast<size_t>(header.width) * header.height;
+
+	// 分岐せずに最大値だけを求める（ループはベクトル化される）
+	uint8_t maxTile = 0;
+	for (size_t i = 0; i < tileBytes; ++i) {
+		maxTile = std::max(maxTile, tiles[i]);
+	}
+	return maxTile <= static_cast<uint8_t>(MapChipType::kBlock);
+}
+
+// 境界上の丸め誤差の許容量（SweepAABB と IsGroundBelow で共有する）
+const float kEdgeEpsilon = 1.0e-4f;
+
+// 座標が含まれるタイル（上向きのグリッド座標）
+int64_t CellOfX(float x) { return static_cast<int64_t>(std::floor((x + MapChipField::kBlockWidth / 2.0f) / MapChipField::kBlockWidth)); }
+int64_t CellOfY(float y) { return static_cast<int64_t>(std::floor((y + MapChipField::kBlockHeight / 2.0f) / MapChipField::kBlockHeight)); }
+
 } // namespace
 
+// 常駐しているチャンクのタイルと派生データ
+// タイルは kChunkSize x kChunkSize で持ち（マップ外の部分は空白）、派生データはチャンクの中だけで作る
+struct MapChipField::ResidentChunk {
+	MapChipData tiles;
+	MapChipOccupancyPyramid occupancy;
+	MapChipBitboard bitboard;
+	MapChipDistanceField distanceField;
+};
+
+MapChipField::MapChipField()
+    : occupancy_(std::make_unique<MapChipOccupancyPyramid>()), bitboard_(std::make_unique<MapChipBitboard>()), distanceField_(std::make_unique<MapChipDistanceField>()) {}
+
+MapChipField::~MapChipField() = default;
+
 void MapChipField::ResetMapChipData() {
 
+	// ストリーミングを止める
+	streamer_.reset();
+	chunkStates_.clear();
+	residentChunkData_.clear();
+	residentChunks_.clear();
+	chunkEvents_.clear();
+	streamingStats_ = {};
+
 	// マップチップデータをリセット
 	mapChipData_.Data.clear();
-	mapChipData_.Data.resize(kNumBlockVirtical);
-
-	for (std::vector<MapChipType>& mapChipDataLine : mapChipData_.Data) {
-		mapChipDataLine.resize(kNumBlockHorizontal);
-	}
+	mapChipData_.width = 0;
+	mapChipData_.height = 0;
+	OnMapChipRegionChanged(0, 0, 0, 0);
 
 	// 敵データをリセット
 	enemySpawns_.clear();
@@ -52,81 +187,712 @@ void MapChipField::LoadMapChipCsv(const std::string& filePath) {
 	// マップチップデータをリセット
 	ResetMapChipData();
 
-	// ファイルを開く
-	std::ifstream file;
-	file.open(filePath);
+	// ファイルをメモリマップする（ファイル全体を1つのバッファとして参照し、行ごとのコピーはしない）
+	MappedFile file;
+	bool isOpen = file.Open(filePath);
 	// ファイルが開けなかった場合の処理
-	assert(file.is_open());
-
-	// マップチップCSV
-	std::stringstream mapChipCsv;
-	// ファイルの内容を文字列にストリームにコピー
-	mapChipCsv << file.rdbuf();
-	// ファイルを閉じる
-	file.close();
-
-	// CSVからマップチップデータを読み込む
-	for (uint32_t y = 0; y < kNumBlockVirtical; ++y) {
-		std::string line;
-		if (!std::getline(mapChipCsv, line)) {
-			// 行が足りない場合は残り放置（既に kBlank 等で初期化されている）
-			break;
+	assert(isOpen);
+	if (!isOpen) {
+		return;
+	}
+
+	std::string_view csv(reinterpret_cast<const char*>(file.GetData()), file.GetSize());
+
+	std::vector<MapChipType>& tiles = mapChipData_.Data;
+	uint32_t width = 0;
+	uint32_t height = 0;
+
+	// 1トークンは最低でも「1文字 + 区切り」なので、その分を先に確保して再確保を防ぐ
+	tiles.reserve(csv.size() / 2 + 1);
+
+	// まだ確定していない空行の数（途中の空行は空白の行、末尾の空行は行数に含めない）
+	uint32_t pendingEmptyRows = 0;
+
+	// CSV を先頭から1回だけ走査する
+	size_t lineBegin = 0;
+	while (lineBegin < csv.size()) {
+
+		size_t lineEnd = csv.find('\n', lineBegin);
+		if (lineEnd == std::string_view::npos) {
+			lineEnd = csv.size();
+		}
+
+		std::string_view line = TrimToken(csv.substr(lineBegin, lineEnd - lineBegin));
+		lineBegin = lineEnd + 1;
+
+		if (line.empty()) {
+			++pendingEmptyRows;
+			continue;
+		}
+
+		// 途中にあった空行を空白の行として確定する
+		for (; pendingEmptyRows > 0; --pendingEmptyRows) {
+			tiles.insert(tiles.end(), width, MapChipType::kBlank);
+			++height;
 		}
 
-		// 1行分の文字列をストリームに変換
-		std::stringstream line_Stream(line);
+		// 1行分のトークンを読む
+		uint32_t x = 0;
+		while (true) {
+			size_t comma = line.find(',');
+			std::string_view word = TrimToken(line.substr(0, comma));
 
-		for (int32_t x = 0; x < kNumBlockHorizontal; ++x) {
+			MapChipType mapChipType = MapChipType::kBlank;
+			EnemyType enemyType = EnemyType::kNone;
 
-			std::string word;
-			if (!std::getline(line_Stream, word, ',')) {
-				// 列が足りない場合は続行
+			switch (ClassifyToken(word, mapChipType, enemyType)) {
+			case TokenKind::kMapChip:
+				// マップチップトークンなら設定
+				tiles.push_back(mapChipType);
+				break;
+			case TokenKind::kEnemy:
+				// マップチップではなく敵トークンなら敵情報を登録し、マップは空白にする
+				enemySpawns_.push_back(EnemySpawn{enemyType, IndexSet{x, height}});
+				tiles.push_back(MapChipType::kBlank);
+				break;
+			case TokenKind::kUnknown:
+			default:
+				// それ以外は空白
+				tiles.push_back(MapChipType::kBlank);
 				break;
 			}
+			++x;
 
-			TrimToken(word);
-
-			// マップチップトークンなら設定
-			if (!word.empty() && mapChipTable.contains(word)) {
-				mapChipData_.Data[y][x] = mapChipTable[word];
+			if (comma == std::string_view::npos) {
+				break;
 			}
-			// マップチップではなく敵トークンなら敵情報を登録し、マップは空白にする
-			else if (!word.empty() && enemyTable.contains(word)) {
-				EnemySpawn spawn;
-				spawn.type = enemyTable[word];
-				spawn.index.xIndex = static_cast<uint32_t>(x);
-				spawn.index.yIndex = static_cast<uint32_t>(y);
-				enemySpawns_.push_back(spawn);
-
-				// 敵のあるセルはマップ上は空白扱い（必要なら他の扱いに変更）
-				mapChipData_.Data[y][x] = MapChipType::kBlank;
+			line.remove_prefix(comma + 1);
+		}
+
+		// 行幅をそろえる
+		if (height == 0) {
+			// 1行目の列数を行幅とする
+			width = x;
+		} else if (x < width) {
+			// 列が足りない場合は空白で埋める
+			tiles.insert(tiles.end(), width - x, MapChipType::kBlank);
+		} else if (x > width) {
+			// 前の行より長い場合は、読み込み済みの行を並べ直す
+			RestrideRows(tiles, width, x, height);
+			width = x;
+		}
+
+		++height;
+	}
+
+	mapChipData_.width = width;
+	mapChipData_.height = height;
+	OnMapChipRegionChanged(0, 0, width, height);
+}
+
+bool MapChipField::LoadMapChipBinary(const std::string& filePath) {
+
+	// ファイルをメモリマップする（ファイル全体を読み込んでパースすることはしない）
+	MappedFile file;
+	if (!file.Open(filePath)) {
+		return false;
+	}
+
+	// ヘッダの検証
+	MapChipBinaryHeader header;
+	if (!ReadMapChipBinaryHeader(file, header)) {
+		return false;
+	}
+
+	// 敵スポーン表とタイルの検証（壊れていたら今のマップを残したまま失敗する）
+	std::vector<EnemySpawn> enemySpawns;
+	if (!ReadMapChipBinaryEnemySpawns(file, header, enemySpawns) || !ValidateMapChipBinaryTiles(file, header)) {
+		return false;
+	}
+
+	// マップチップデータをリセット
+	ResetMapChipData();
+
+	// タイル配列は1タイル1バイトで詰めてあるので、そのまま一括コピーする
+	const size_t tileBytes = static_cast<size_t>(header.width) * header.height;
+	mapChipData_.width = header.width;
+	mapChipData_.height = header.height;
+	mapChipData_.Data.resize(tileBytes);
+	std::memcpy(mapChipData_.Data.data(), file.GetData() + header.tileOffset, tileBytes);
+
+	OnMapChipRegionChanged(0, 0, header.width, header.height);
+
+	// 敵スポーン表
+	enemySpawns_.swap(enemySpawns);
+
+	return true;
+}
+
+void MapChipField::LoadMapChip(const std::string& binaryPath, const std::string& csvPath, bool streaming) {
+
+	// CSV の方が新しければ、ベイク済みデータは古いので使わない
+	std::error_code ec;
+	const auto binaryTime = std::filesystem::last_write_time(binaryPath, ec);
+	bool useBinary = !ec;
+
+	if (useBinary) {
+		const auto csvTime = std::filesystem::last_write_time(csvPath, ec);
+		if (!ec && csvTime > binaryTime) {
+			useBinary = false;
+		}
+	}
+
+	if (useBinary) {
+		if (streaming ? OpenMapChipStream(binaryPath) : LoadMapChipBinary(binaryPath)) {
+			return;
+		}
+	}
+
+	// ストリーミングはベイク済みマップからしか読めないので、無い・古い・壊れている場合は CSV からベイクし直す
+	if (streaming && BakeMapChipCsv(csvPath, binaryPath) && OpenMapChipStream(binaryPath)) {
+		return;
+	}
+
+	// フォールバック: CSV を読み込む（書き出せなかった場合など）
+	LoadMapChipCsv(csvPath);
+}
+
+bool MapChipField::SaveMapChipBinary(const std::string& filePath) const {
+
+	// ストリーミング中は常駐しているチャンクのタイルしか持っていない
+	if (streamer_) {
+		return false;
+	}
+
+	const size_t tileBytes = mapChipData_.Data.size();
+
+	// ヘッダの作成
+	MapChipBinaryHeader header = {};
+	std::memcpy(header.magic, kMapChipBinaryMagic, sizeof(header.magic));
+	header.version = kMapChipBinaryVersion;
+	header.width = mapChipData_.width;
+	header.height = mapChipData_.height;
+	header.enemySpawnCount = static_cast<uint32_t>(enemySpawns_.size());
+	header.tileOffset = sizeof(MapChipBinaryHeader);
+	// 敵スポーン表は4バイト境界に揃える
+	header.enemySpawnOffset = static_cast<uint32_t>((header.tileOffset + tileBytes + 3) & ~size_t(3));
+
+	std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+	if (!file.is_open()) {
+		return false;
+	}
+
+	// ヘッダとタイル配列
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(mapChipData_.Data.data()), tileBytes);
+
+	// パディング
+	const char padding[4] = {};
+	file.write(padding, header.enemySpawnOffset - (header.tileOffset + tileBytes));
+
+	// 敵スポーン表
+	for (const EnemySpawn& spawn : enemySpawns_) {
+		MapChipBinaryEnemySpawn record;
+		record.type = static_cast<uint32_t>(spawn.type);
+		record.xIndex = spawn.index.xIndex;
+		record.yIndex = spawn.index.yIndex;
+		file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+	}
+
+	return file.good();
+}
+
+bool MapChipField::BakeMapChipCsv(const std::string& csvPath, const std::string& binaryPath) {
+
+	MapChipField mapChipField;
+	mapChipField.LoadMapChipCsv(csvPath);
+
+	return mapChipField.SaveMapChipBinary(binaryPath);
+}
+
+bool MapChipField::OpenMapChipStream(const std::string& filePath) {
+
+	// ローダーがファイルをマップし、ストリーミング中は開いたままにする
+	auto streamer = std::make_unique<MapChipStreamer>();
+	if (!streamer->Open(filePath)) {
+		return false;
+	}
+
+	// ヘッダの検証
+	MapChipBinaryHeader header;
+	if (!ReadMapChipBinaryHeader(streamer->GetFile(), header)) {
+		return false;
+	}
+
+	// 敵スポーン表は小さいので最初に全て読む（壊れていたら今のマップを残したまま失敗する）
+	std::vector<EnemySpawn> enemySpawns;
+	if (!ReadMapChipBinaryEnemySpawns(streamer->GetFile(), header, enemySpawns)) {
+		return false;
+	}
+
+	// タイルは開くときに一度だけ全体を検証する（チャンクの読み込みは検証済みのバイトをそのままコピーする）
+	if (!ValidateMapChipBinaryTiles(streamer->GetFile(), header)) {
+		return false;
+	}
+
+	// マップチップデータをリセット
+	ResetMapChipData();
+
+	// マップ全体のタイルは確保せず、大きさだけを持つ（タイルと派生データは常駐したチャンクごとに持つ）
+	mapChipData_.width = header.width;
+	mapChipData_.height = header.height;
+
+	enemySpawns_.swap(enemySpawns);
+
+	const size_t numChunks = static_cast<size_t>(GetNumChunkHorizontal()) * GetNumChunkVirtical();
+	chunkStates_.assign(numChunks, ChunkState::kUnloaded);
+	residentChunkData_.resize(numChunks);
+
+	streamer->Start(header.width, header.height, header.tileOffset);
+	streamer_ = std::move(streamer);
+
+	return true;
+}
+
+void MapChipField::UpdateStreaming(const Vector3& center, bool waitForLoads) {
+
+	if (!streamer_ || mapChipData_.width == 0 || mapChipData_.height == 0) {
+		return;
+	}
+
+	const uint32_t numChunkX = GetNumChunkHorizontal();
+	const uint32_t numChunkY = GetNumChunkVirtical();
+
+	// 中心座標のあるチャンク（マップ外ならマップ端のチャンク）
+	const float tileX = std::floor((center.x + kBlockWidth / 2.0f) / kBlockWidth);
+	const float tileY = static_cast<float>(mapChipData_.height - 1) - std::floor((center.y + kBlockHeight / 2.0f) / kBlockHeight);
+	const int64_t centerChunkX = std::clamp(static_cast<int64_t>(tileX), int64_t(0), static_cast<int64_t>(mapChipData_.width - 1)) / kChunkSize;
+	const int64_t centerChunkY = std::clamp(static_cast<int64_t>(tileY), int64_t(0), static_cast<int64_t>(mapChipData_.height - 1)) / kChunkSize;
+
+	const int64_t radius = static_cast<int64_t>(streamingRadius_);
+
+	// 範囲内で未読み込みのチャンクをリクエストする
+	const int64_t minX = std::max(centerChunkX - radius, int64_t(0));
+	const int64_t maxX = std::min(centerChunkX + radius, static_cast<int64_t>(numChunkX) - 1);
+	const int64_t minY = std::max(centerChunkY - radius, int64_t(0));
+	const int64_t maxY = std::min(centerChunkY + radius, static_cast<int64_t>(numChunkY) - 1);
+
+	for (int64_t y = minY; y <= maxY; ++y) {
+		for (int64_t x = minX; x <= maxX; ++x) {
+			ChunkState& state = chunkStates_[static_cast<size_t>(y) * numChunkX + static_cast<size_t>(x)];
+			if (state == ChunkState::kUnloaded) {
+				state = ChunkState::kLoading;
+				++streamingStats_.pendingChunks;
+				streamer_->Request(static_cast<uint32_t>(x), static_cast<uint32_t>(y));
 			}
-			// それ以外は既定値（初期化済み）
 		}
 	}
+
+	// 範囲から十分に離れたチャンクを解放する（境界で読み込みと解放を繰り返さないよう1チャンク分の余裕を持たせる）
+	for (size_t i = 0; i < residentChunks_.size();) {
+		const uint32_t chunkX = residentChunks_[i] % numChunkX;
+		const uint32_t chunkY = residentChunks_[i] / numChunkX;
+		const int64_t distance = std::max(std::abs(static_cast<int64_t>(chunkX) - centerChunkX), std::abs(static_cast<int64_t>(chunkY) - centerChunkY));
+
+		if (distance <= radius + 1) {
+			++i;
+			continue;
+		}
+
+		// タイルと派生データをまとめて解放する
+		residentChunkData_[residentChunks_[i]].reset();
+		chunkStates_[residentChunks_[i]] = ChunkState::kUnloaded;
+		chunkEvents_.push_back(MapChipChunkEvent{chunkX, chunkY, MapChipChunkEventType::kUnloaded});
+
+		// 順序は問わないので末尾と入れ替えて削除
+		residentChunks_[i] = residentChunks_.back();
+		residentChunks_.pop_back();
+	}
+
+	// 初期化時などは読み込みが終わるまで待つ
+	if (waitForLoads) {
+		streamer_->WaitIdle();
+	}
+
+	// 読み込みが終わったチャンクを反映する
+	std::vector<MapChipStreamer::LoadResult> results;
+	streamer_->TakeCompleted(results);
+
+	for (const MapChipStreamer::LoadResult& result : results) {
+		const uint32_t chunkIndex = result.chunkY * numChunkX + result.chunkX;
+
+		--streamingStats_.pendingChunks;
+
+		if (chunkStates_[chunkIndex] != ChunkState::kLoading) {
+			continue;
+		}
+
+		// 読み込み中に範囲から離れたチャンクは反映せずに捨てる（戻ってきたら読み込み直す）
+		const int64_t distance = std::max(std::abs(static_cast<int64_t>(result.chunkX) - centerChunkX), std::abs(static_cast<int64_t>(result.chunkY) - centerChunkY));
+		if (distance > radius + 1) {
+			chunkStates_[chunkIndex] = ChunkState::kUnloaded;
+			++streamingStats_.discardedChunksTotal;
+			continue;
+		}
+
+		// チャンクのタイル（マップ外の部分は空白で読み込まれている）から派生データを作る
+		auto chunk = std::make_unique<ResidentChunk>();
+		chunk->tiles.width = kChunkSize;
+		chunk->tiles.height = kChunkSize;
+		chunk->tiles.Data.assign(result.tiles.begin(), result.tiles.end());
+		chunk->occupancy.Build(chunk->tiles);
+		chunk->bitboard.Build(chunk->tiles);
+		chunk->distanceField.Build(chunk->tiles);
+		residentChunkData_[chunkIndex] = std::move(chunk);
+
+		chunkStates_[chunkIndex] = ChunkState::kResident;
+		residentChunks_.push_back(chunkIndex);
+		chunkEvents_.push_back(MapChipChunkEvent{result.chunkX, result.chunkY, MapChipChunkEventType::kLoaded});
+
+		// 統計情報の更新
+		++streamingStats_.loadedChunksTotal;
+		streamingStats_.lastLoadLatencyMs = result.latencyMs;
+		streamingStats_.averageLoadLatencyMs += (result.latencyMs - streamingStats_.averageLoadLatencyMs) / static_cast<float>(streamingStats_.loadedChunksTotal);
+	}
+
+	streamingStats_.residentChunks = static_cast<uint32_t>(residentChunks_.size());
 }
 
-MapChipType MapChipField::GetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex) {
+void MapChipField::TakeChunkEvents(std::vector<MapChipChunkEvent>& events) {
+	events.clear();
+	events.swap(chunkEvents_);
+}
 
-	if (xIndex < 0 || kNumBlockHorizontal - 1 < xIndex) {
-		return MapChipType::kBlank;
+bool MapChipField::IsChunkResident(uint32_t chunkX, uint32_t chunkY) const {
+
+	if (chunkX >= GetNumChunkHorizontal() || chunkY >= GetNumChunkVirtical()) {
+		return false;
+	}
+
+	// ストリーミングしていなければマップ全体が読み込み済み
+	if (!streamer_) {
+		return true;
 	}
 
-	if (yIndex < 0 || kNumBlockVirtical - 1 < yIndex) {
+	return chunkStates_[static_cast<size_t>(chunkY) * GetNumChunkHorizontal() + chunkX] == ChunkState::kResident;
+}
+
+MapChipType MapChipField::GetStreamedMapChipType(uint32_t xIndex, uint32_t yIndex) const {
+	const ResidentChunk* chunk = FindResidentChunk(xIndex / kChunkSize, yIndex / kChunkSize);
+	if (!chunk) {
 		return MapChipType::kBlank;
 	}
+	return chunk->tiles.Data[(yIndex % kChunkSize) * kChunkSize + xIndex % kChunkSize];
+}
+
+void MapChipField::SetMapChipType(uint32_t xIndex, uint32_t yIndex, MapChipType type) {
+
+	if (xIndex >= mapChipData_.width || yIndex >= mapChipData_.height) {
+		return;
+	}
+
+	const uint32_t chunkX = xIndex / kChunkSize;
+	const uint32_t chunkY = yIndex / kChunkSize;
+
+	if (!streamer_) {
+		MapChipType& tile = mapChipData_.Data[static_cast<size_t>(yIndex) * mapChipData_.width + xIndex];
+		if (tile == type) {
+			return;
+		}
+		tile = type;
+		OnMapChipRegionChanged(xIndex, yIndex, 1, 1);
+	} else {
+		// ストリーミング中は常駐しているチャンクのタイルと派生データを書き換える
+		ResidentChunk* chunk = residentChunkData_[static_cast<size_t>(chunkY) * GetNumChunkHorizontal() + chunkX].get();
+		if (!chunk) {
+			return;
+		}
+		const uint32_t localX = xIndex % kChunkSize;
+		const uint32_t localY = yIndex % kChunkSize;
+		MapChipType& tile = chunk->tiles.Data[localY * kChunkSize + localX];
+		if (tile == type) {
+			return;
+		}
+		tile = type;
+		chunk->occupancy.UpdateRegion(localX, localY, 1, 1);
+		chunk->bitboard.UpdateRegion(chunk->tiles, localX, localY, 1, 1);
+		chunk->distanceField.UpdateRegion(chunk->tiles, localX, localY, 1, 1);
+	}
 
-	return mapChipData_.Data[yIndex][xIndex];
+	// チャンクのメッシュは隣のタイルを見て隠れた面を省くので、チャンクの端のタイルなら隣のチャンクの見た目も変わる
+	AddChunkModifiedEvent(chunkX, chunkY);
+	if (xIndex % kChunkSize == 0 && chunkX > 0) {
+		AddChunkModifiedEvent(chunkX - 1, chunkY);
+	}
+	if (xIndex % kChunkSize == kChunkSize - 1 && chunkX + 1 < GetNumChunkHorizontal()) {
+		AddChunkModifiedEvent(chunkX + 1, chunkY);
+	}
+	if (yIndex % kChunkSize == 0 && chunkY > 0) {
+		AddChunkModifiedEvent(chunkX, chunkY - 1);
+	}
+	if (yIndex % kChunkSize == kChunkSize - 1 && chunkY + 1 < GetNumChunkVirtical()) {
+		AddChunkModifiedEvent(chunkX, chunkY + 1);
+	}
 }
 
-Vector3 MapChipField::GetMapChipPositionByIndex(uint32_t xIndex, uint32_t yIndex) { return Vector3(kBlockWidth * xIndex, kBlockHeight * (kNumBlockVirtical - 1 - yIndex), 0); }
+void MapChipField::AddChunkModifiedEvent(uint32_t chunkX, uint32_t chunkY) {
+
+	if (!IsChunkResident(chunkX, chunkY)) {
+		return;
+	}
+
+	// 同じフレームに何度変更しても、作り直しは1回で済むようにまとめる
+	for (const MapChipChunkEvent& event : chunkEvents_) {
+		if (event.type == MapChipChunkEventType::kModified && event.chunkX == chunkX && event.chunkY == chunkY) {
+			return;
+		}
+	}
+	chunkEvents_.push_back(MapChipChunkEvent{chunkX, chunkY, MapChipChunkEventType::kModified});
+}
+
+bool MapChipField::GetIndexRangeInRect(const RangeRect& rect, IndexSet& minIndex, IndexSet& maxIndex) const {
+
+	if (mapChipData_.width == 0 || mapChipData_.height == 0) {
+		return false;
+	}
+
+	// タイル x はワールド座標で [x * 幅 - 幅 / 2, x * 幅 + 幅 / 2] を占める（y は下から数える）
+	const float cellLeft = std::floor((rect.left + kBlockWidth / 2.0f) / kBlockWidth);
+	const float cellRight = std::floor((rect.right + kBlockWidth / 2.0f) / kBlockWidth);
+	const float cellBottom = std::floor((rect.bottom + kBlockHeight / 2.0f) / kBlockHeight);
+	const float cellTop = std::floor((rect.top + kBlockHeight / 2.0f) / kBlockHeight);
+
+	const float width = static_cast<float>(mapChipData_.width);
+	const float height = static_cast<float>(mapChipData_.height);
+	if (cellRight < 0.0f || cellLeft >= width || cellTop < 0.0f || cellBottom >= height) {
+		return false;
+	}
+
+	const uint32_t x0 = static_cast<uint32_t>(std::max(cellLeft, 0.0f));
+	const uint32_t x1 = static_cast<uint32_t>(std::min(cellRight, width - 1.0f));
+	const uint32_t cellY0 = static_cast<uint32_t>(std::max(cellBottom, 0.0f));
+	const uint32_t cellY1 = static_cast<uint32_t>(std::min(cellTop, height - 1.0f));
+
+	// yIndex は上から数えるので上下を入れ替える
+	minIndex = {x0, mapChipData_.height - 1 - cellY1};
+	maxIndex = {x1, mapChipData_.height - 1 - cellY0};
+	return true;
+}
+
+bool MapChipField::IsRegionEmpty(uint32_t xIndex0, uint32_t yIndex0, uint32_t xIndex1, uint32_t yIndex1) const {
+
+	if (!streamer_) {
+		return occupancy_->IsRegionEmpty(xIndex0, yIndex0, xIndex1, yIndex1);
+	}
+
+	// マップ外は空白
+	if (xIndex0 > xIndex1 || yIndex0 > yIndex1 || xIndex0 >= mapChipData_.width || yIndex0 >= mapChipData_.height) {
+		return true;
+	}
+	xIndex1 = std::min(xIndex1, mapChipData_.width - 1);
+	yIndex1 = std::min(yIndex1, mapChipData_.height - 1);
+
+	// 掛かっているチャンクごとに、チャンクの占有ピラミッドで調べる
+	for (uint32_t chunkY = yIndex0 / kChunkSize; chunkY <= yIndex1 / kChunkSize; ++chunkY) {
+		for (uint32_t chunkX = xIndex0 / kChunkSize; chunkX <= xIndex1 / kChunkSize; ++chunkX) {
+			const ResidentChunk* chunk = FindResidentChunk(chunkX, chunkY);
+			if (!chunk) {
+				return false;
+			}
+			const uint32_t x0 = std::max(xIndex0, chunkX * kChunkSize) - chunkX * kChunkSize;
+			const uint32_t y0 = std::max(yIndex0, chunkY * kChunkSize) - chunkY * kChunkSize;
+			const uint32_t x1 = std::min(xIndex1 - chunkX * kChunkSize, kChunkSize - 1);
+			const uint32_t y1 = std::min(yIndex1 - chunkY * kChunkSize, kChunkSize - 1);
+			if (!chunk->occupancy.IsRegionEmpty(x0, y0, x1, y1)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+bool MapChipField::AnySolidInRow(uint32_t yIndex, uint32_t xIndex0, uint32_t xIndex1) const {
+
+	if (!streamer_) {
+		return bitboard_->AnySolid(yIndex, xIndex0, xIndex1);
+	}
+
+	// マップ外は空白
+	if (yIndex >= mapChipData_.height || xIndex0 >= mapChipData_.width || xIndex0 > xIndex1) {
+		return false;
+	}
+	xIndex1 = std::min(xIndex1, mapChipData_.width - 1);
+
+	// 掛かっているチャンクごとに、チャンクのビットボードで調べる
+	const uint32_t chunkY = yIndex / kChunkSize;
+	for (uint32_t chunkX = xIndex0 / kChunkSize; chunkX <= xIndex1 / kChunkSize; ++chunkX) {
+		const ResidentChunk* chunk = FindResidentChunk(chunkX, chunkY);
+		if (!chunk) {
+			return true;
+		}
+		const uint32_t x0 = std::max(xIndex0, chunkX * kChunkSize) - chunkX * kChunkSize;
+		const uint32_t x1 = std::min(xIndex1 - chunkX * kChunkSize, kChunkSize - 1);
+		if (chunk->bitboard.AnySolid(yIndex % kChunkSize, x0, x1)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+int64_t MapChipField::FindNextSolidRight(uint32_t yIndex, uint32_t xIndex) const {
+
+	if (!streamer_) {
+		return bitboard_->FindNextSolidRight(yIndex, xIndex);
+	}
+
+	if (yIndex >= mapChipData_.height || xIndex >= mapChipData_.width) {
+		return MapChipBitboard::kNotFound;
+	}
+
+	// チャンクを右へ順に調べる（常駐していないチャンクはその左端がブロック）
+	const uint32_t chunkY = yIndex / kChunkSize;
+	for (uint32_t chunkX = xIndex / kChunkSize; chunkX < GetNumChunkHorizontal(); ++chunkX) {
+		const uint32_t chunkLeft = chunkX * kChunkSize;
+		const ResidentChunk* chunk = FindResidentChunk(chunkX, chunkY);
+		if (!chunk) {
+			return std::max(xIndex, chunkLeft);
+		}
+		const int64_t found = chunk->bitboard.FindNextSolidRight(yIndex % kChunkSize, std::max(xIndex, chunkLeft) - chunkLeft);
+		if (found != MapChipBitboard::kNotFound) {
+			return chunkLeft + found;
+		}
+	}
+	return MapChipBitboard::kNotFound;
+}
+
+int64_t MapChipField::FindNextSolidLeft(uint32_t yIndex, uint32_t xIndex) const {
+
+	if (!streamer_) {
+		return bitboard_->FindNextSolidLeft(yIndex, xIndex);
+	}
+
+	if (yIndex >= mapChipData_.height || mapChipData_.width == 0) {
+		return MapChipBitboard::kNotFound;
+	}
+	xIndex = std::min(xIndex, mapChipData_.width - 1);
+
+	// チャンクを左へ順に調べる（常駐していないチャンクはその右端がブロック）
+	const uint32_t chunkY = yIndex / kChunkSize;
+	for (int64_t chunkX = xIndex / kChunkSize; chunkX >= 0; --chunkX) {
+		const uint32_t chunkLeft = static_cast<uint32_t>(chunkX) * kChunkSize;
+		const uint32_t start = std::min(xIndex, chunkLeft + kChunkSize - 1);
+		const ResidentChunk* chunk = FindResidentChunk(static_cast<uint32_t>(chunkX), chunkY);
+		if (!chunk) {
+			return start;
+		}
+		const int64_t found = chunk->bitboard.FindNextSolidLeft(yIndex % kChunkSize, start - chunkLeft);
+		if (found != MapChipBitboard::kNotFound) {
+			return chunkLeft + found;
+		}
+	}
+	return MapChipBitboard::kNotFound;
+}
+
+bool MapChipField::IsSolidTile(uint32_t xIndex, uint32_t yIndex) const {
+
+	if (!streamer_) {
+		return bitboard_->IsSolid(xIndex, yIndex);
+	}
+
+	const ResidentChunk* chunk = FindResidentChunk(xIndex / kChunkSize, yIndex / kChunkSize);
+	return !chunk || chunk->bitboard.IsSolid(xIndex % kChunkSize, yIndex % kChunkSize);
+}
+
+uint32_t MapChipField::GetEmptyLevel(uint32_t xIndex, uint32_t yIndex) const {
+
+	if (!streamer_) {
+		return occupancy_->GetEmptyLevel(xIndex, yIndex);
+	}
+
+	// チャンクのピラミッドの最も粗いレベルはチャンク全体なので、空いている範囲はチャンクからはみ出さない
+	const ResidentChunk* chunk = FindResidentChunk(xIndex / kChunkSize, yIndex / kChunkSize);
+	assert(chunk);
+	return chunk->occupancy.GetEmptyLevel(xIndex % kChunkSize, yIndex % kChunkSize);
+}
+
+float MapChipField::GetTileDistance(uint32_t xIndex, uint32_t yIndex) const {
+
+	if (!streamer_) {
+		return distanceField_->GetDistance(xIndex, yIndex);
+	}
+
+	const ResidentChunk* chunk = FindResidentChunk(xIndex / kChunkSize, yIndex / kChunkSize);
+	if (!chunk) {
+		return 0.0f;
+	}
+
+	// チャンクの距離場は外のブロックを知らないので、チャンクの外で最も近いタイルまでの距離で抑える
+	const uint32_t localX = xIndex % kChunkSize;
+	const uint32_t localY = yIndex % kChunkSize;
+	const uint32_t toEdge = std::min({localX + 1, kChunkSize - localX, localY + 1, kChunkSize - localY});
+	return std::min(chunk->distanceField.GetDistance(localX, localY), static_cast<float>(toEdge));
+}
+
+void MapChipField::TestSolidPoints(const float* xs, const float* ys, uint32_t count, uint8_t* solid) const {
+
+	// GetMapChipIndexSetByPosition と同じ計算。負の番号は uint32_t にすると範囲外になるので、マップ外としてまとめて 0 にする
+	auto solidAt = [this](uint32_t xIndex, uint32_t yIndex) -> uint8_t { return (xIndex < mapChipData_.width && yIndex < mapChipData_.height && IsSolidTile(xIndex, yIndex)) ? 1 : 0; };
+
+	const int32_t top = static_cast<int32_t>(mapChipData_.height) - 1;
+	const __m128 halfWidth = _mm_set1_ps(kBlockWidth / 2.0f);
+	const __m128 halfHeight = _mm_set1_ps(kBlockHeight / 2.0f);
+	const __m128 invWidth = _mm_set1_ps(1.0f / kBlockWidth);
+	const __m128 invHeight = _mm_set1_ps(1.0f / kBlockHeight);
+	const __m128i topIndex = _mm_set1_epi32(top);
+
+	alignas(16) int32_t xIndices[4];
+	alignas(16) int32_t yIndices[4];
+
+	uint32_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const __m128i x = _mm_cvttps_epi32(_mm_mul_ps(_mm_add_ps(_mm_loadu_ps(xs + i), halfWidth), invWidth));
+		const __m128i y = _mm_sub_epi32(topIndex, _mm_cvttps_epi32(_mm_mul_ps(_mm_add_ps(_mm_loadu_ps(ys + i), halfHeight), invHeight)));
+		_mm_store_si128(reinterpret_cast<__m128i*>(xIndices), x);
+		_mm_store_si128(reinterpret_cast<__m128i*>(yIndices), y);
+
+		for (uint32_t lane = 0; lane < 4; ++lane) {
+			solid[i + lane] = solidAt(static_cast<uint32_t>(xIndices[lane]), static_cast<uint32_t>(yIndices[lane]));
+		}
+	}
+
+	// 端数
+	for (; i < count; ++i) {
+		const int32_t x = static_cast<int32_t>((xs[i] + kBlockWidth / 2.0f) / kBlockWidth);
+		const int32_t y = top - static_cast<int32_t>((ys[i] + kBlockHeight / 2.0f) / kBlockHeight);
+		solid[i] = solidAt(static_cast<uint32_t>(x), static_cast<uint32_t>(y));
+	}
+}
+
+void MapChipField::OnMapChipRegionChanged(uint32_t xIndex, uint32_t yIndex, uint32_t numX, uint32_t numY) {
+
+	// マップの大きさが変わったら作り直し、そうでなければ変更された範囲だけ更新する
+	if (!occupancy_->IsBuiltFor(mapChipData_)) {
+		occupancy_->Build(mapChipData_);
+	} else {
+		occupancy_->UpdateRegion(xIndex, yIndex, numX, numY);
+	}
+
+	if (!bitboard_->IsBuiltFor(mapChipData_)) {
+		bitboard_->Build(mapChipData_);
+	} else {
+		bitboard_->UpdateRegion(mapChipData_, xIndex, yIndex, numX, numY);
+	}
+
+	if (!distanceField_->IsBuiltFor(mapChipData_)) {
+		distanceField_->Build(mapChipData_);
+	} else {
+		distanceField_->UpdateRegion(mapChipData_, xIndex, yIndex, numX, numY);
+	}
+}
+
+Vector3 MapChipField::GetMapChipPositionByIndex(uint32_t xIndex, uint32_t yIndex) { return Vector3(kBlockWidth * xIndex, kBlockHeight * (mapChipData_.height - 1 - yIndex), 0); }
 
 IndexSet MapChipField::GetMapChipIndexSetByPosition(const Vector3& position) {
 
 	IndexSet indexSet = {};
 
 	indexSet.xIndex = static_cast<uint32_t>((position.x + kBlockWidth / 2.0f) / kBlockWidth);
-	indexSet.yIndex = kNumBlockVirtical - 1 - static_cast<uint32_t>((position.y + kBlockHeight / 2.0f) / kBlockHeight);
+	indexSet.yIndex = mapChipData_.height - 1 - static_cast<uint32_t>((position.y + kBlockHeight / 2.0f) / kBlockHeight);
 
 	return indexSet;
 }
@@ -142,4 +908,333 @@ RangeRect MapChipField::GetRectIndex(uint32_t xIndex, uint32_t yIndex) {
 	rect.top = center.y + kBlockHeight / 2.0f;
 
 	return rect;
-}
\ No newline at end of file
+}
+
+bool MapChipField::Raycast(const Vector3& origin, const Vector3& direction, float maxDistance, MapChipRaycastHit& hit) const {
+
+	// XY 平面上の向きを正規化する
+	const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+	if (length <= 0.0f || mapChipData_.width == 0 || mapChipData_.height == 0) {
+		return false;
+	}
+	const float dirX = direction.x / length;
+	const float dirY = direction.y / length;
+
+	// タイル単位のグリッド座標（y は上向き。yIndex = height - 1 - cellY）
+	int64_t cellX = static_cast<int64_t>(std::floor((origin.x + kBlockWidth / 2.0f) / kBlockWidth));
+	int64_t cellY = static_cast<int64_t>(std::floor((origin.y + kBlockHeight / 2.0f) / kBlockHeight));
+
+	const int64_t width = mapChipData_.width;
+	const int64_t height = mapChipData_.height;
+
+	// タイルの境界座標
+	auto cellLeft = [](int64_t x) { return static_cast<float>(x) * kBlockWidth - kBlockWidth / 2.0f; };
+	auto cellBottom = [](int64_t y) { return static_cast<float>(y) * kBlockHeight - kBlockHeight / 2.0f; };
+
+	// Amanatides-Woo の DDA
+	// 境界までの距離は毎回タイル座標から求め直す（空き領域を読み飛ばした後もそのまま続けられるように）
+	const float kInfinity = std::numeric_limits<float>::infinity();
+	const int64_t stepX = (dirX > 0.0f) ? 1 : ((dirX < 0.0f) ? -1 : 0);
+	const int64_t stepY = (dirY > 0.0f) ? 1 : ((dirY < 0.0f) ? -1 : 0);
+
+	// 進行方向にある縦（横）の境界までの距離
+	auto boundaryX = [&](int64_t x) { return (stepX == 0) ? kInfinity : (cellLeft(stepX > 0 ? x + 1 : x) - origin.x) / dirX; };
+	auto boundaryY = [&](int64_t y) { return (stepY == 0) ? kInfinity : (cellBottom(stepY > 0 ? y + 1 : y) - origin.y) / dirY; };
+
+	float t = 0.0f;
+	Vector3 normal(0.0f, 0.0f, 0.0f);
+
+	while (true) {
+		if (cellX >= 0 && cellX < width && cellY >= 0 && cellY < height) {
+			const uint32_t xIndex = static_cast<uint32_t>(cellX);
+			const uint32_t yIndex = static_cast<uint32_t>(height - 1 - cellY);
+
+			if (IsSolidTile(xIndex, yIndex)) {
+				// 始点がブロック内なら法線は 0
+				hit.index.xIndex = xIndex;
+				hit.index.yIndex = yIndex;
+				hit.point = Vector3(origin.x + dirX * t, origin.y + dirY * t, origin.z);
+				hit.normal = normal;
+				hit.distance = t;
+				return true;
+			}
+
+			// 周囲がまとめて空いていれば、その範囲を抜ける所まで一気に進む
+			const uint32_t level = GetEmptyLevel(xIndex, yIndex);
+			if (level > 0) {
+				// 空いている範囲（上向きのグリッド座標）
+				const int64_t size = int64_t(1) << level;
+				const int64_t x0 = (static_cast<int64_t>(xIndex) >> level) << level;
+				const int64_t x1 = x0 + size - 1;
+				const int64_t yIndex0 = (static_cast<int64_t>(yIndex) >> level) << level;
+				const int64_t y0 = height - 1 - (yIndex0 + size - 1);
+				const int64_t y1 = height - 1 - yIndex0;
+
+				const float exitX = boundaryX(stepX > 0 ? x1 : x0);
+				const float exitY = boundaryY(stepY > 0 ? y1 : y0);
+
+				if (exitX < exitY) {
+					t = std::max(t, exitX);
+					cellX = (stepX > 0) ? x1 + 1 : x0 - 1;
+					cellY = std::clamp(static_cast<int64_t>(std::floor((origin.y + dirY * t + kBlockHeight / 2.0f) / kBlockHeight)), y0, y1);
+					normal = Vector3(static_cast<float>(-stepX), 0.0f, 0.0f);
+				} else {
+					t = std::max(t, exitY);
+					cellY = (stepY > 0) ? y1 + 1 : y0 - 1;
+					cellX = std::clamp(static_cast<int64_t>(std::floor((origin.x + dirX * t + kBlockWidth / 2.0f) / kBlockWidth)), x0, x1);
+					normal = Vector3(0.0f, static_cast<float>(-stepY), 0.0f);
+				}
+
+				if (t > maxDistance) {
+					return false;
+				}
+				continue;
+			}
+		} else if ((cellX < 0 && stepX <= 0) || (cellX >= width && stepX >= 0) || (cellY < 0 && stepY <= 0) || (cellY >= height && stepY >= 0)) {
+			// マップ外へ離れていく場合はもう当たらない
+			return false;
+		}
+
+		// 近い方の境界を跨いで隣のタイルへ進む
+		const float tMaxX = boundaryX(cellX);
+		const float tMaxY = boundaryY(cellY);
+		if (tMaxX < tMaxY) {
+			t = std::max(t, tMaxX);
+			cellX += stepX;
+			normal = Vector3(static_cast<float>(-stepX), 0.0f, 0.0f);
+		} else {
+			t = std::max(t, tMaxY);
+			cellY += stepY;
+			normal = Vector3(0.0f, static_cast<float>(-stepY), 0.0f);
+		}
+
+		if (t > maxDistance) {
+			return false;
+		}
+	}
+}
+
+MapChipSweepResult MapChipField::SweepAABB(const AABB& box, const Vector3& velocity, float skin) const {
+
+	MapChipSweepResult result;
+	result.velocity = velocity;
+
+	if (mapChipData_.width == 0 || mapChipData_.height == 0) {
+		return result;
+	}
+
+	// タイルの境界座標
+	auto cellLeft = [](int64_t cellX) { return static_cast<float>(cellX) * kBlockWidth - kBlockWidth / 2.0f; };
+	auto cellBottom = [](int64_t cellY) { return static_cast<float>(cellY) * kBlockHeight - kBlockHeight / 2.0f; };
+
+	// 箱が通過する帯（上向きのグリッド座標、両端を含む）が丸ごと空いているか
+	const int64_t width = mapChipData_.width;
+	const int64_t height = mapChipData_.height;
+	auto isBandEmpty = [&](int64_t x0, int64_t y0, int64_t x1, int64_t y1) {
+		x0 = std::max(x0, int64_t(0));
+		y0 = std::max(y0, int64_t(0));
+		x1 = std::min(x1, width - 1);
+		y1 = std::min(y1, height - 1);
+		if (x0 > x1 || y0 > y1) {
+			return true;
+		}
+		// 常駐していないチャンクが掛かっていれば空いていない（タイルを調べる）
+		return IsRegionEmpty(static_cast<uint32_t>(x0), static_cast<uint32_t>(height - 1 - y1), static_cast<uint32_t>(x1), static_cast<uint32_t>(height - 1 - y0));
+	};
+
+	/*-------------- 縦方向 --------------*/
+	if (velocity.y != 0.0f) {
+		// 箱が横に掛かっているタイル列（辺が接しているだけの列は含めない）
+		const int64_t cellX0 = CellOfX(box.min.x + kEdgeEpsilon);
+		const int64_t cellX1 = CellOfX(box.max.x - kEdgeEpsilon);
+
+		if (velocity.y > 0.0f) {
+			// 上端より上にあるタイル行を近い順に調べる
+			const int64_t first = CellOfY(box.max.y - kEdgeEpsilon) + 1;
+			const int64_t last = CellOfY(box.max.y + velocity.y + skin);
+			// 帯が丸ごと空いていればタイルを調べない
+			const bool empty = isBandEmpty(cellX0, first, cellX1, last);
+			for (int64_t cellY = first; !empty && cellY <= last; ++cellY) {
+				if (IsRowSpanSolid(cellY, cellX0, cellX1, result.tileQueries)) {
+					result.velocity.y = std::max(0.0f, cellBottom(cellY) - box.max.y - skin);
+					result.ceilingCollision = true;
+					break;
+				}
+			}
+		} else {
+			// 下端より下にあるタイル行を近い順に調べる
+			const int64_t first = CellOfY(box.min.y + kEdgeEpsilon) - 1;
+			const int64_t last = CellOfY(box.min.y + velocity.y - skin);
+			// 帯が丸ごと空いていればタイルを調べない
+			const bool empty = isBandEmpty(cellX0, last, cellX1, first);
+			for (int64_t cellY = first; !empty && cellY >= last; --cellY) {
+				if (IsRowSpanSolid(cellY, cellX0, cellX1, result.tileQueries)) {
+					result.velocity.y = std::min(0.0f, cellBottom(cellY) + kBlockHeight - box.min.y + skin);
+					result.landing = true;
+					break;
+				}
+			}
+		}
+	}
+
+	/*-------------- 横方向（縦に動いた後の箱で調べる） --------------*/
+	if (velocity.x != 0.0f) {
+		const int64_t cellY0 = CellOfY(box.min.y + result.velocity.y + kEdgeEpsilon);
+		const int64_t cellY1 = CellOfY(box.max.y + result.velocity.y - kEdgeEpsilon);
+
+		if (velocity.x > 0.0f) {
+			// 右端より右にあるタイル列を近い順に調べる
+			const int64_t first = CellOfX(box.max.x - kEdgeEpsilon) + 1;
+			const int64_t last = CellOfX(box.max.x + velocity.x + skin);
+			// 帯が丸ごと空いていればタイルを調べない
+			const bool empty = isBandEmpty(first, cellY0, last, cellY1);
+			for (int64_t cellX = first; !empty && cellX <= last; ++cellX) {
+				if (IsColumnSpanSolid(cellX, cellY0, cellY1, result.tileQueries)) {
+					result.velocity.x = std::max(0.0f, cellLeft(cellX) - box.max.x - skin);
+					result.hitWall = true;
+					result.hitWallRight = true;
+					break;
+				}
+			}
+		} else {
+			// 左端より左にあるタイル列を近い順に調べる
+			const int64_t first = CellOfX(box.min.x + kEdgeEpsilon) - 1;
+			const int64_t last = CellOfX(box.min.x + velocity.x - skin);
+			// 帯が丸ごと空いていればタイルを調べない
+			const bool empty = isBandEmpty(last, cellY0, first, cellY1);
+			for (int64_t cellX = first; !empty && cellX >= last; --cellX) {
+				if (IsColumnSpanSolid(cellX, cellY0, cellY1, result.tileQueries)) {
+					result.velocity.x = std::min(0.0f, cellLeft(cellX) + kBlockWidth - box.min.x + skin);
+					result.hitWall = true;
+					result.hitWallRight = false;
+					break;
+				}
+			}
+		}
+	}
+
+	return result;
+}
+
+bool MapChipField::IsGroundBelow(const AABB& box, float depth) const {
+
+	if (mapChipData_.width == 0 || mapChipData_.height == 0) {
+		return false;
+	}
+
+	// SweepAABB の着地判定と同じく、箱が横に掛かっているタイル列（辺が接しているだけの列は含めない）を調べる
+	uint32_t tileQueries = 0;
+	return IsRowSpanSolid(CellOfY(box.min.y - depth), CellOfX(box.min.x + kEdgeEpsilon), CellOfX(box.max.x - kEdgeEpsilon), tileQueries);
+}
+
+bool MapChipField::IsRowSpanSolid(int64_t cellY, int64_t cellX0, int64_t cellX1, uint32_t& tileQueries) const {
+
+	const int64_t height = mapChipData_.height;
+	if (cellY < 0 || cellY >= height) {
+		return false;
+	}
+
+	// マップ内の範囲に切り詰める
+	cellX0 = std::max(cellX0, int64_t(0));
+	cellX1 = std::min(cellX1, static_cast<int64_t>(mapChipData_.width) - 1);
+	if (cellX0 > cellX1) {
+		return false;
+	}
+
+	// 行の範囲はビットボードでまとめて調べる
+	++tileQueries;
+	return AnySolidInRow(static_cast<uint32_t>(height - 1 - cellY), static_cast<uint32_t>(cellX0), static_cast<uint32_t>(cellX1));
+}
+
+bool MapChipField::IsColumnSpanSolid(int64_t cellX, int64_t cellY0, int64_t cellY1, uint32_t& tileQueries) const {
+
+	if (cellX < 0 || cellX >= static_cast<int64_t>(mapChipData_.width)) {
+		return false;
+	}
+
+	// マップ内の範囲に切り詰める
+	const int64_t height = mapChipData_.height;
+	cellY0 = std::max(cellY0, int64_t(0));
+	cellY1 = std::min(cellY1, height - 1);
+
+	for (int64_t cellY = cellY0; cellY <= cellY1; ++cellY) {
+		++tileQueries;
+		const uint32_t yIndex = static_cast<uint32_t>(height - 1 - cellY);
+		if (IsSolidTile(static_cast<uint32_t>(cellX), yIndex)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+float MapChipField::GetSafeDistance(const Vector3& position) const {
+
+	// タイルは正方形の前提（距離場はタイル単位）
+	assert(kBlockWidth == kBlockHeight);
+
+	const int64_t width = mapChipData_.width;
+	const int64_t height = mapChipData_.height;
+
+	const int64_t cellX = static_cast<int64_t>(std::floor((position.x + kBlockWidth / 2.0f) / kBlockWidth));
+	const int64_t cellY = static_cast<int64_t>(std::floor((position.y + kBlockHeight / 2.0f) / kBlockHeight));
+
+	// マップ外は空白なので、マップの矩形までの距離が下限になる
+	if (cellX < 0 || cellX >= width || cellY < 0 || cellY >= height) {
+		const float left = -kBlockWidth / 2.0f;
+		const float right = static_cast<float>(width) * kBlockWidth - kBlockWidth / 2.0f;
+		const float bottom = -kBlockHeight / 2.0f;
+		const float top = static_cast<float>(height) * kBlockHeight - kBlockHeight / 2.0f;
+		const float dx = std::max({left - position.x, 0.0f, position.x - right});
+		const float dy = std::max({bottom - position.y, 0.0f, position.y - top});
+		return std::sqrt(dx * dx + dy * dy);
+	}
+
+	// タイル中心同士の距離から、ブロックの半対角線と、タイル中心から位置までのずれを引く
+	const float kHalfDiagonal = 0.70710678f;
+	const float distance = GetTileDistance(static_cast<uint32_t>(cellX), static_cast<uint32_t>(height - 1 - cellY));
+	const float offsetX = position.x - static_cast<float>(cellX) * kBlockWidth;
+	const float offsetY = position.y - static_cast<float>(cellY) * kBlockHeight;
+
+	return std::max(0.0f, (distance - kHalfDiagonal) * kBlockWidth - std::sqrt(offsetX * offsetX + offsetY * offsetY));
+}
+
+bool MapChipField::SphereTrace(const Vector3& origin, const Vector3& direction, float maxDistance, MapChipRaycastHit& hit) const {
+
+	// XY 平面上の向きを正規化する
+	const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+	if (length <= 0.0f || mapChipData_.width == 0 || mapChipData_.height == 0) {
+		return false;
+	}
+	const Vector3 dir(direction.x / length, direction.y / length, 0.0f);
+
+	// 安全な距離がこれより短ければタイルを辿る
+	const float kMinStep = kBlockWidth / 2.0f;
+	// タイルを辿るときに1度に進む距離
+	const float kRaycastSpan = kBlockWidth * 2.0f;
+
+	float t = 0.0f;
+	while (t <= maxDistance) {
+		const Vector3 position(origin.x + dir.x * t, origin.y + dir.y * t, origin.z);
+
+		// ブロックから離れていれば安全な距離だけまとめて進む
+		const float safeDistance = GetSafeDistance(position);
+		if (safeDistance >= kMinStep) {
+			t += safeDistance;
+			continue;
+		}
+
+		// ブロックの近くでは少しだけタイルを辿る
+		const float span = std::min(maxDistance - t, kRaycastSpan);
+		if (Raycast(position, dir, span, hit)) {
+			hit.distance += t;
+			return true;
+		}
+		if (span <= 0.0f) {
+			break;
+		}
+		t += span;
+	}
+
+	return false;
+}
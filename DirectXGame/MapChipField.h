@@ -1,9 +1,18 @@
 #pragma once
 #include "Math.h"
 #include "KamataEngine.h"
+#include <cassert>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
-enum class MapChipType {
+class MapChipBitboard;
+class MapChipDistanceField;
+class MapChipOccupancyPyramid;
+class MapChipStreamer;
+
+// 1タイル1バイトで保持する
+enum class MapChipType : uint8_t {
 	kBlank, // 空白
 	kBlock, // ブロック
 };
@@ -17,8 +26,11 @@ enum class EnemyType {
 };
 
 // マップチップの構造体
+// 行優先（Data[y * width + x]）で1本の連続したバッファに詰めて保持する
 struct MapChipData {
-	std::vector<std::vector<MapChipType>> Data;
+	std::vector<MapChipType> Data;
+	uint32_t width = 0;
+	uint32_t height = 0;
 };
 
 struct IndexSet {
@@ -32,6 +44,29 @@ struct EnemySpawn {
 	IndexSet index;
 };
 
+// ベイク済みマップ（バイナリ）のフォーマットバージョン
+// フォーマットを変更したら上げること（古いファイルは読み込みを拒否して CSV にフォールバックする）
+inline constexpr uint32_t kMapChipBinaryVersion = 1;
+
+// ベイク済みマップのファイルヘッダ
+// ファイル構成: [ヘッダ][タイル配列 width*height バイト][敵スポーン表]
+struct MapChipBinaryHeader {
+	char magic[4];             // "MCHP"
+	uint32_t version;          // フォーマットのバージョン
+	uint32_t width;            // 横のタイル数
+	uint32_t height;           // 縦のタイル数
+	uint32_t enemySpawnCount;  // 敵スポーン数
+	uint32_t tileOffset;       // タイル配列の先頭オフセット（バイト）
+	uint32_t enemySpawnOffset; // 敵スポーン表の先頭オフセット（バイト）
+};
+
+// ベイク済みマップの敵スポーン表の1要素
+struct MapChipBinaryEnemySpawn {
+	uint32_t type;
+	uint32_t xIndex;
+	uint32_t yIndex;
+};
+
 // 範囲矩形
 struct RangeRect {
 	float left;   // 左端
@@ -40,8 +75,70 @@ struct RangeRect {
 	float top;    // 上端
 };
 
+// レイキャストの結果
+struct MapChipRaycastHit {
+	IndexSet index;               // 当たったタイル
+	KamataEngine::Vector3 point;  // 当たった位置（タイルの境界上）
+	KamataEngine::Vector3 normal; // 当たった面の法線（始点がブロック内なら 0）
+	float distance;               // 始点からの距離
+};
+
+// AABB スイープの結果（CollisionMapInfo 相当）
+struct MapChipSweepResult {
+	bool ceilingCollision = false;  // 天井衝突フラグ
+	bool landing = false;           // 着地フラグ
+	bool hitWall = false;           // 壁接触フラグ
+	bool hitWallRight = false;      // 右の壁に当たった（false なら左）
+	KamataEngine::Vector3 velocity; // 衝突で調整した移動量
+	uint32_t tileQueries = 0;       // タイルの問い合わせ回数（行の範囲の問い合わせは1回と数える）
+};
+
+// チャンクイベントの種類
+enum class MapChipChunkEventType : uint8_t {
+	kLoaded,   // 読み込まれた
+	kUnloaded, // 解放された
+	kModified, // タイルが変更された（チャンクの見た目を作り直す）
+};
+
+// チャンクの読み込み・解放・変更イベント
+struct MapChipChunkEvent {
+	uint32_t chunkX;
+	uint32_t chunkY;
+	MapChipChunkEventType type;
+};
+
+// ストリーミングの統計情報
+struct MapChipStreamingStats {
+	uint32_t residentChunks = 0;       // 常駐しているチャンク数
+	uint32_t pendingChunks = 0;        // 読み込み待ちのチャンク数
+	uint32_t loadedChunksTotal = 0;    // これまでに読み込んだチャンク数
+	uint32_t discardedChunksTotal = 0; // 読み込み中に範囲から離れて捨てたチャンク数
+	float lastLoadLatencyMs = 0.0f;    // 直近のチャンク読み込みにかかった時間（ミリ秒）
+	float averageLoadLatencyMs = 0.0f; // チャンク読み込みにかかった時間の平均（ミリ秒）
+};
+
+/// <summary>
+/// マップチップのフィールド
+///
+/// ストリーミング中の常駐していないチャンクの扱い（問い合わせの種類ごとに1つに決めている）
+///   タイルの読み出し（GetMapChipTypeByIndex）  : 空白。読み込まれている中身だけを返す（メッシュの作成用。常駐しているかは IsChunkResident で調べる）
+///   当たり判定（それ以外の問い合わせすべて）  : ブロック。読み込み前の場所に入り込んだり通り抜けたりしないよう、壁があるものとして扱う
+///     SweepAABB / IsGroundBelow / IsRegionEmpty / AnySolidInRow / FindNextSolidRight / FindNextSolidLeft /
+///     TestSolidPoints / Raycast / GetSafeDistance / SphereTrace
+/// マップ外はどの問い合わせでも空白として扱う
+/// </summary>
 class MapChipField {
 public:
+	// ストリーミングの単位となるチャンクの一辺のタイル数
+	static inline const uint32_t kChunkSize = 32;
+
+	// 1ブロックのサイズ
+	static inline const float kBlockWidth = 2.0f;
+	static inline const float kBlockHeight = 2.0f;
+
+	MapChipField();
+	~MapChipField();
+
 	/// <summary>
 	/// 読み込みデータのリセット
 	/// </summary>
@@ -54,12 +151,99 @@ public:
 	void LoadMapChipCsv(const std::string& filePath);
 
 	/// <summary>
-	/// マップチップ種別の取得
+	/// ベイク済みマップ（バイナリ）をメモリマップして読み込む
+	/// </summary>
+	/// <param name="filePath"></param>
+	/// <returns>ファイルが無い・壊れている・バージョン違いなら false</returns>
+	bool LoadMapChipBinary(const std::string& filePath);
+
+	/// <summary>
+	/// ベイク済みマップを優先して読み込み、使えない場合は CSV にフォールバックする
+	/// （CSV の方が新しい場合も CSV を読む）
+	/// </summary>
+	/// <param name="binaryPath"></param>
+	/// <param name="csvPath"></param>
+	/// <param name="streaming">true ならベイク済みマップをストリーミングで読み込む（使えなければ CSV からベイクし直してから開く）</param>
+	void LoadMapChip(const std::string& binaryPath, const std::string& csvPath, bool streaming = false);
+
+	/// <summary>
+	/// 現在のマップデータをバイナリで書き出す
+	/// </summary>
+	/// <param name="filePath"></param>
+	/// <returns>書き出しに成功したら true（ストリーミング中はマップ全体を持っていないので false）</returns>
+	bool SaveMapChipBinary(const std::string& filePath) const;
+
+	/// <summary>
+	/// CSV をベイク済みマップに変換する（オフラインのベイク用）
+	/// </summary>
+	/// <param name="csvPath"></param>
+	/// <param name="binaryPath"></param>
+	/// <returns>書き出しに成功したら true</returns>
+	static bool BakeMapChipCsv(const std::string& csvPath, const std::string& binaryPath);
+
+	/*-------------- ストリーミング --------------*/
+
+	/// <summary>
+	/// ベイク済みマップをストリーミング用に開く
+	/// マップ全体のタイルは持たず、UpdateStreaming で読み込んだチャンクごとにタイルと派生データ（占有ピラミッド・ビットボード・距離場）を持つ
+	/// （常駐していないチャンクの扱いはクラスのコメントを参照）
+	/// </summary>
+	/// <param name="filePath"></param>
+	/// <returns>ファイルが無い・壊れている・バージョン違いなら false</returns>
+	bool OpenMapChipStream(const std::string& filePath);
+
+	/// <summary>
+	/// 中心座標の周囲のチャンクを読み込み、離れたチャンクを解放する
+	/// （読み込み中に範囲から離れたチャンクは、読み込みが終わっても反映しない）
+	/// </summary>
+	/// <param name="center">中心のワールド座標（カメラの追尾対象）</param>
+	/// <param name="waitForLoads">true なら読み込みが終わるまで待つ（初期化時用）</param>
+	void UpdateStreaming(const KamataEngine::Vector3& center, bool waitForLoads = false);
+
+	/// <summary>
+	/// 前回の呼び出し以降に発生したチャンクの読み込み・解放・変更イベントを受け取る
+	/// （変更イベントはストリーミングしていなくても SetMapChipType で発生する）
+	/// </summary>
+	/// <param name="events">受け取り先（中身は置き換えられる）</param>
+	void TakeChunkEvents(std::vector<MapChipChunkEvent>& events);
+
+	// 常駐させる範囲（中心チャンクからのチャンク数）
+	void SetStreamingRadius(uint32_t radiusChunks) { streamingRadius_ = radiusChunks; }
+
+	// チャンクが常駐しているか（ストリーミングしていない場合は全て常駐）
+	bool IsChunkResident(uint32_t chunkX, uint32_t chunkY) const;
+
+	bool IsStreaming() const { return streamer_ != nullptr; }
+	const MapChipStreamingStats& GetStreamingStats() const { return streamingStats_; }
+	uint32_t GetNumChunkHorizontal() const { return (mapChipData_.width + kChunkSize - 1) / kChunkSize; }
+	uint32_t GetNumChunkVirtical() const { return (mapChipData_.height + kChunkSize - 1) / kChunkSize; }
+
+	/// <summary>
+	/// マップチップ種別の取得（範囲外と常駐していないチャンクは kBlank を返す）
 	/// </summary>
 	/// <param name="xIndex"></param>
 	/// <param name="yIndex"></param>
 	/// <returns></returns>
-	MapChipType GetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex);
+	MapChipType GetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex) const {
+		if (xIndex >= mapChipData_.width || yIndex >= mapChipData_.height) {
+			return MapChipType::kBlank;
+		}
+		return GetMapChipTypeByIndexUnchecked(xIndex, yIndex);
+	}
+
+	/// <summary>
+	/// マップチップ種別の取得（範囲チェックなし。呼び出し側で範囲内を保証すること）
+	/// </summary>
+	/// <param name="xIndex"></param>
+	/// <param name="yIndex"></param>
+	/// <returns></returns>
+	MapChipType GetMapChipTypeByIndexUnchecked(uint32_t xIndex, uint32_t yIndex) const {
+		assert(xIndex < mapChipData_.width && yIndex < mapChipData_.height);
+		if (streamer_) {
+			return GetStreamedMapChipType(xIndex, yIndex);
+		}
+		return mapChipData_.Data[static_cast<size_t>(yIndex) * mapChipData_.width + xIndex];
+	}
 
 	/// <summary>
 	/// マップチップ座標の取得
@@ -69,16 +253,111 @@ public:
 	/// <returns></returns>
 	KamataEngine::Vector3 GetMapChipPositionByIndex(uint32_t xIndex, uint32_t yIndex);
 
+	/// <summary>
+	/// マップチップ種別の変更（範囲外は無視する）
+	/// ストリーミング中は常駐しているチャンクだけ変更でき、チャンクを解放すると変更も失われる
+	/// 見た目が変わるチャンク（チャンクの端のタイルなら隣のチャンクも）に変更イベントを出す
+	/// </summary>
+	/// <param name="xIndex"></param>
+	/// <param name="yIndex"></param>
+	/// <param name="type"></param>
+	void SetMapChipType(uint32_t xIndex, uint32_t yIndex, MapChipType type);
+
+	/// <summary>
+	/// 範囲（両端を含む）にブロックが1つも無いか（占有ピラミッドで空いている所をまとめて読み飛ばす）
+	/// </summary>
+	bool IsRegionEmpty(uint32_t xIndex0, uint32_t yIndex0, uint32_t xIndex1, uint32_t yIndex1) const;
+
+	/// <summary>
+	/// 行 yIndex の xIndex0..xIndex1（両端を含む）にブロックがあるか（ビットボードで 64 タイルずつ調べる）
+	/// </summary>
+	bool AnySolidInRow(uint32_t yIndex, uint32_t xIndex0, uint32_t xIndex1) const;
+
+	/// <summary>
+	/// 行 yIndex で xIndex から右（xIndex を含む）に向かって最初のブロックの xIndex（無ければ -1）
+	/// </summary>
+	int64_t FindNextSolidRight(uint32_t yIndex, uint32_t xIndex) const;
+
+	/// <summary>
+	/// 行 yIndex で xIndex から左（xIndex を含む）に向かって最初のブロックの xIndex（無ければ -1）
+	/// </summary>
+	int64_t FindNextSolidLeft(uint32_t yIndex, uint32_t xIndex) const;
+
+	/// <summary>
+	/// 点がブロックのタイルに入っているかをまとめて調べる（タイル番号は SSE2 で4点ずつ計算する）
+	/// </summary>
+	/// <param name="xs">点の x 座標</param>
+	/// <param name="ys">点の y 座標</param>
+	/// <param name="count">点の数</param>
+	/// <param name="solid">結果（ブロックと常駐していないチャンクなら 1、それ以外とマップ外は 0）</param>
+	void TestSolidPoints(const float* xs, const float* ys, uint32_t count, uint8_t* solid) const;
+
 	IndexSet GetMapChipIndexSetByPosition(const KamataEngine::Vector3& position);
 
 	RangeRect GetRectIndex(uint32_t xIndex, uint32_t yIndex);
 
+	/// <summary>
+	/// ワールド座標の矩形に掛かるタイルの範囲（両端を含む）。マップと重ならなければ false
+	/// </summary>
+	/// <param name="rect">ワールド座標の矩形</param>
+	/// <param name="minIndex">左上のタイル</param>
+	/// <param name="maxIndex">右下のタイル</param>
+	bool GetIndexRangeInRect(const RangeRect& rect, IndexSet& minIndex, IndexSet& maxIndex) const;
+
+	/// <summary>
+	/// レイキャスト（XY 平面上でレイが通るタイルを順に辿り、最初のブロックを返す）
+	/// </summary>
+	/// <param name="origin">始点</param>
+	/// <param name="direction">向き（正規化は不要。Z 成分は無視する）</param>
+	/// <param name="maxDistance">最大距離</param>
+	/// <param name="hit">当たった場合の結果</param>
+	/// <returns>maxDistance 以内でブロックに当たったら true</returns>
+	bool Raycast(const KamataEngine::Vector3& origin, const KamataEngine::Vector3& direction, float maxDistance, MapChipRaycastHit& hit) const;
+
+	/// <summary>
+	/// AABB を移動量の分だけ動かしたときのブロックとの衝突を求める
+	/// 縦→横の順に軸ごとに、箱が通過するタイルだけを近い順に調べて衝突までの移動量に切り詰める
+	/// （移動量が大きくてもすり抜けない。始めから重なっているタイルは無視する）
+	/// </summary>
+	/// <param name="box">移動前の AABB</param>
+	/// <param name="velocity">移動量</param>
+	/// <param name="skin">ブロックとの間に空ける隙間</param>
+	/// <returns>調整後の移動量と接触情報</returns>
+	MapChipSweepResult SweepAABB(const AABB& box, const KamataEngine::Vector3& velocity, float skin = 0.0f) const;
+
+	/// <summary>
+	/// AABB の下端から depth だけ下の行に足場があるか（着地中の落下判定用）
+	/// SweepAABB の着地と同じタイル列を同じ方法で調べるので、SweepAABB で着地した箱はここでも足場があると判定される
+	/// </summary>
+	/// <param name="box">AABB</param>
+	/// <param name="depth">下端から調べる深さ</param>
+	bool IsGroundBelow(const AABB& box, float depth) const;
+
+	/// <summary>
+	/// 位置から最も近いブロックまでの安全な距離（これ以上近くにブロックは無いことが保証される下限）
+	/// 円形の物体は自分の半径を引いて使う
+	/// </summary>
+	/// <param name="position">位置（Z は無視する）</param>
+	/// <returns>距離（ワールド単位）</returns>
+	float GetSafeDistance(const KamataEngine::Vector3& position) const;
+
+	/// <summary>
+	/// 距離場を使ったレイキャスト（スフィアトレース）
+	/// ブロックから離れている間は安全な距離だけまとめて進み、近くでは Raycast でタイルを辿る
+	/// </summary>
+	/// <param name="origin">始点</param>
+	/// <param name="direction">向き（正規化は不要。Z 成分は無視する）</param>
+	/// <param name="maxDistance">最大距離</param>
+	/// <param name="hit">当たった場合の結果</param>
+	/// <returns>maxDistance 以内でブロックに当たったら true</returns>
+	bool SphereTrace(const KamataEngine::Vector3& origin, const KamataEngine::Vector3& direction, float maxDistance, MapChipRaycastHit& hit) const;
+
 	// 読み込んだ敵の一覧を取得
 	const std::vector<EnemySpawn>& GetEnemySpawns() const { return enemySpawns_; }
 
 	// アクセッサー
-	uint32_t GetNumBlockVirtical() { return kNumBlockVirtical; };
-	uint32_t GetNumBlockHorizontal() { return kNumBlockHorizontal; };
+	uint32_t GetNumBlockVirtical() const { return mapChipData_.height; };
+	uint32_t GetNumBlockHorizontal() const { return mapChipData_.width; };
 	float GetBlockWidth() { return kBlockWidth; };
 	float GetBlockHeight() { return kBlockHeight; };
 
@@ -89,11 +368,90 @@ private:
 	// 読み込んだ敵スポーン情報
 	std::vector<EnemySpawn> enemySpawns_;
 
-	// 1ブロックのサイズ
-	static inline const float kBlockWidth = 2.0f;
-	static inline const float kBlockHeight = 2.0f;
+	/// <summary>
+	/// タイル行 cellY（上向きのグリッド座標）の cellX0..cellX1 にブロックがあるか（SweepAABB・IsGroundBelow 用）
+	/// </summary>
+	bool IsRowSpanSolid(int64_t cellY, int64_t cellX0, int64_t cellX1, uint32_t& tileQueries) const;
+
+	/// <summary>
+	/// タイル列 cellX の cellY0..cellY1（上向きのグリッド座標）にブロックがあるか（SweepAABB 用）
+	/// </summary>
+	bool IsColumnSpanSolid(int64_t cellX, int64_t cellY0, int64_t cellY1, uint32_t& tileQueries) const;
+
+	/// <summary>
+	/// マップ内のタイルがブロックか（常駐していないチャンクはブロック）
+	/// </summary>
+	bool IsSolidTile(uint32_t xIndex, uint32_t yIndex) const;
+
+	/// <summary>
+	/// マップ内の空白のタイルを含むセルが空になっている最も粗いレベル（ストリーミング中はチャンクの中だけで求める）
+	/// </summary>
+	uint32_t GetEmptyLevel(uint32_t xIndex, uint32_t yIndex) const;
+
+	/// <summary>
+	/// マップ内のタイルの中心から最も近いブロックの中心までの距離の下限（タイル単位。常駐していないチャンクは 0）
+	/// </summary>
+	float GetTileDistance(uint32_t xIndex, uint32_t yIndex) const;
+
+	/// <summary>
+	/// タイルが変更されたときに呼ぶ（タイルから作る派生データを更新する。ストリーミングしていないとき用）
+	/// </summary>
+	void OnMapChipRegionChanged(uint32_t xIndex, uint32_t yIndex, uint32_t numX, uint32_t numY);
+
+	// ブロックの占有ピラミッド（ストリーミング中はチャンクごとに持つので空）
+	std::unique_ptr<MapChipOccupancyPyramid> occupancy_;
+
+	// 行ごとのブロックのビットボード（ストリーミング中はチャンクごとに持つので空）
+	std::unique_ptr<MapChipBitboard> bitboard_;
+
+	// ブロックまでの距離場（ストリーミング中はチャンクごとに持つので空）
+	std::unique_ptr<MapChipDistanceField> distanceField_;
+
+	/*-------------- ストリーミング --------------*/
+
+	// チャンクの状態
+	enum class ChunkState : uint8_t {
+		kUnloaded, // 未読み込み
+		kLoading,  // 読み込み中
+		kResident, // 常駐
+	};
+
+	// 常駐しているチャンクのタイルと派生データ（解放するとまとめて消える）
+	struct ResidentChunk;
+
+	/// <summary>
+	/// 常駐しているチャンク（常駐していなければ nullptr）
+	/// </summary>
+	const ResidentChunk* FindResidentChunk(uint32_t chunkX, uint32_t chunkY) const { return residentChunkData_[static_cast<size_t>(chunkY) * GetNumChunkHorizontal() + chunkX].get(); }
+
+	/// <summary>
+	/// ストリーミング中のマップ内のタイルの種別（常駐していないチャンクは kBlank）
+	/// </summary>
+	MapChipType GetStreamedMapChipType(uint32_t xIndex, uint32_t yIndex) const;
+
+	/// <summary>
+	/// チャンクに変更イベントを出す（常駐していないチャンクと、受け取られていない変更イベントがあるチャンクには出さない）
+	/// </summary>
+	void AddChunkModifiedEvent(uint32_t chunkX, uint32_t chunkY);
+
+	// バックグラウンドローダー（ストリーミングしていなければ nullptr）
+	std::unique_ptr<MapChipStreamer> streamer_;
+
+	// チャンクごとの状態
+	std::vector<ChunkState> chunkStates_;
+
+	// チャンクごとのタイルと派生データ（常駐しているチャンクだけ持つ）
+	std::vector<std::unique_ptr<ResidentChunk>> residentChunkData_;
+
+	// 常駐しているチャンクの番号（chunkY * チャンク横数 + chunkX）
+	std::vector<uint32_t> residentChunks_;
+
+	// 未受け取りのチャンクイベント（ストリーミングしていなくても変更イベントは溜まる）
+	std::vector<MapChipChunkEvent> chunkEvents_;
+
+	// 常駐させる範囲（中心チャンクからのチャンク数）
+	uint32_t streamingRadius_ = 2;
 
-	// ブロックの個数
-	static inline const uint32_t kNumBlockVirtical = 25;
-	static inline const uint32_t kNumBlockHorizontal = 100;
+	// 統計情報
+	MapChipStreamingStats streamingStats_;
 };
@@ -0,0 +1,226 @@
+#define NOMINMAX
+#include "MapChipMeshBuilder.h"
+#include "Math.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace KamataEngine;
+
+namespace {
+
+Vector3 Cross(const Vector3& a, const Vector3& b) { return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x}; }
+
+float Dot(const Vector3& a, const Vector3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+float Component(const Vector3& v, int axis) { return axis == 0 ? v.x : (axis == 1 ? v.y : v.z); }
+
+} // namespace
+
+void MapChipMeshBuilder::BuildChunk(const MapChipField& field, uint32_t chunkX, uint32_t chunkY, MapChipMesh& mesh) {
+	mesh.vertices.clear();
+	mesh.indices.clear();
+	mesh.blockCount = 0;
+
+	const uint32_t height = field.GetNumBlockVirtical();
+
+	// チャンク内のタイル範囲（マップ端のチャンクは小さくなる）
+	const uint32_t beginX = chunkX * MapChipField::kChunkSize;
+	const uint32_t beginY = chunkY * MapChipField::kChunkSize;
+	const uint32_t endX = std::min(beginX + MapChipField::kChunkSize, field.GetNumBlockHorizontal());
+	const uint32_t endY = std::min(beginY + MapChipField::kChunkSize, height);
+	if (beginX >= endX || beginY >= endY) {
+		return;
+	}
+
+	const float w = MapChipField::kBlockWidth;
+	const float h = MapChipField::kBlockHeight;
+	// ブロックは立方体なので奥行きは幅と同じ
+	const float halfDepth = w / 2.0f;
+
+	// タイルの端のワールド座標（y は上から数える番号を下から数える座標に直す）
+	auto left = [&](uint32_t x) { return x * w - w / 2.0f; };
+	auto right = [&](uint32_t x) { return x * w + w / 2.0f; };
+	auto top = [&](uint32_t y) { return (height - 1 - y) * h + h / 2.0f; };
+	auto bottom = [&](uint32_t y) { return (height - 1 - y) * h - h / 2.0f; };
+
+	// 範囲外は kBlank が返るので、マップの外に面した面も作られる（0 - 1 は大きな値になって範囲外になる）
+	auto isBlock = [&](uint32_t x, uint32_t y) { return field.GetMapChipTypeByIndex(x, y) == MapChipType::kBlock; };
+
+	/*-------------- 前後の面：ブロックを長方形にまとめる --------------*/
+	const uint32_t numX = endX - beginX;
+	const uint32_t numY = endY - beginY;
+	std::vector<uint8_t> used(static_cast<size_t>(numX) * numY, 0);
+	auto isFree = [&](uint32_t x, uint32_t y) { return !used[static_cast<size_t>(y - beginY) * numX + (x - beginX)] && isBlock(x, y); };
+
+	for (uint32_t y = beginY; y < endY; ++y) {
+		for (uint32_t x = beginX; x < endX; ++x) {
+			if (!isFree(x, y)) {
+				continue;
+			}
+
+			// 右へ伸ばす
+			uint32_t x1 = x;
+			while (x1 + 1 < endX && isFree(x1 + 1, y)) {
+				++x1;
+			}
+
+			// 下へ、行の全てが使えるあいだ伸ばす
+			uint32_t y1 = y;
+			while (y1 + 1 < endY) {
+				bool rowFree = true;
+				for (uint32_t i = x; i <= x1 && rowFree; ++i) {
+					rowFree = isFree(i, y1 + 1);
+				}
+				if (!rowFree) {
+					break;
+				}
+				++y1;
+			}
+
+			for (uint32_t j = y; j <= y1; ++j) {
+				for (uint32_t i = x; i <= x1; ++i) {
+					used[static_cast<size_t>(j - beginY) * numX + (i - beginX)] = 1;
+				}
+			}
+			mesh.blockCount += (x1 - x + 1) * (y1 - y + 1);
+
+			const float l = left(x);
+			const float r = right(x1);
+			const float t = top(y);
+			const float b = bottom(y1);
+			AddQuad(mesh, {{l, t, -halfDepth}, {r, t, -halfDepth}, {r, b, -halfDepth}, {l, b, -halfDepth}}, {0.0f, 0.0f, -1.0f});
+			AddQuad(mesh, {{r, t, halfDepth}, {l, t, halfDepth}, {l, b, halfDepth}, {r, b, halfDepth}}, {0.0f, 0.0f, 1.0f});
+		}
+	}
+
+	/*-------------- 上下の面：行ごとに横へまとめる --------------*/
+	for (uint32_t y = beginY; y < endY; ++y) {
+		for (int side = 0; side < 2; ++side) {
+			// side 0 は上の面（上のタイルを見る）、1 は下の面
+			const uint32_t neighborY = side == 0 ? y - 1 : y + 1;
+			const float faceY = side == 0 ? top(y) : bottom(y);
+			const Vector3 normal = side == 0 ? Vector3{0.0f, 1.0f, 0.0f} : Vector3{0.0f, -1.0f, 0.0f};
+
+			uint32_t x = beginX;
+			while (x < endX) {
+				if (!isBlock(x, y) || isBlock(x, neighborY)) {
+					++x;
+					continue;
+				}
+				uint32_t x1 = x;
+				while (x1 + 1 < endX && isBlock(x1 + 1, y) && !isBlock(x1 + 1, neighborY)) {
+					++x1;
+				}
+
+				const float l = left(x);
+				const float r = right(x1);
+				AddQuad(mesh, {{l, faceY, -halfDepth}, {r, faceY, -halfDepth}, {r, faceY, halfDepth}, {l, faceY, halfDepth}}, normal);
+				x = x1 + 1;
+			}
+		}
+	}
+
+	/*-------------- 左右の面：列ごとに縦へまとめる --------------*/
+	for (uint32_t x = beginX; x < endX; ++x) {
+		for (int side = 0; side < 2; ++side) {
+			// side 0 は右の面（右のタイルを見る）、1 は左の面
+			const uint32_t neighborX = side == 0 ? x + 1 : x - 1;
+			const float faceX = side == 0 ? right(x) : left(x);
+			const Vector3 normal = side == 0 ? Vector3{1.0f, 0.0f, 0.0f} : Vector3{-1.0f, 0.0f, 0.0f};
+
+			uint32_t y = beginY;
+			while (y < endY) {
+				if (!isBlock(x, y) || isBlock(neighborX, y)) {
+					++y;
+					continue;
+				}
+				uint32_t y1 = y;
+				while (y1 + 1 < endY && isBlock(x, y1 + 1) && !isBlock(neighborX, y1 + 1)) {
+					++y1;
+				}
+
+				const float t = top(y);
+				const float b = bottom(y1);
+				AddQuad(mesh, {{faceX, t, -halfDepth}, {faceX, b, -halfDepth}, {faceX, b, halfDepth}, {faceX, t, halfDepth}}, normal);
+				y = y1 + 1;
+			}
+		}
+	}
+}
+
+std::vector<Matrix4x4> MapChipMeshBuilder::MakeFaceUVTransforms(Mesh& mesh) {
+	std::vector<Matrix4x4> transforms(kFaceCount, Matrix4x4{});
+
+	const std::vector<Mesh::VertexPosNormalUv>& vertices = mesh.GetVertices();
+	const std::vector<uint32_t>& indices = mesh.GetIndices();
+
+	for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+		const Mesh::VertexPosNormalUv& v0 = vertices[indices[i]];
+		const Mesh::VertexPosNormalUv& v1 = vertices[indices[i + 1]];
+		const Mesh::VertexPosNormalUv& v2 = vertices[indices[i + 2]];
+
+		// 法線の一番大きい軸から面を決める
+		const Vector3& n = v0.normal;
+		const float ax = std::abs(n.x);
+		const float ay = std::abs(n.y);
+		const float az = std::abs(n.z);
+		int normalAxis = 2;
+		if (ax >= ay && ax >= az) {
+			normalAxis = 0;
+		} else if (ay >= az) {
+			normalAxis = 1;
+		}
+		const int face = normalAxis * 2 + (Component(n, normalAxis) > 0.0f ? 0 : 1);
+
+		// 面の上の2軸 (a, b) で u = c0 * a + c1 * b + c2 を3頂点から解く
+		const int axisA = (normalAxis + 1) % 3;
+		const int axisB = (normalAxis + 2) % 3;
+		const float a0 = Component(v0.pos, axisA), b0 = Component(v0.pos, axisB);
+		const float a1 = Component(v1.pos, axisA), b1 = Component(v1.pos, axisB);
+		const float a2 = Component(v2.pos, axisA), b2 = Component(v2.pos, axisB);
+		const float det = (a1 - a0) * (b2 - b0) - (a2 - a0) * (b1 - b0);
+		if (std::abs(det) < 1e-6f) {
+			continue;
+		}
+
+		Matrix4x4& transform = transforms[face];
+		transform = {};
+		const float uv0[2] = {v0.uv.x, v0.uv.y};
+		const float uv1[2] = {v1.uv.x, v1.uv.y};
+		const float uv2[2] = {v2.uv.x, v2.uv.y};
+		for (int c = 0; c < 2; ++c) {
+			const float c0 = ((uv1[c] - uv0[c]) * (b2 - b0) - (uv2[c] - uv0[c]) * (b1 - b0)) / det;
+			const float c1 = ((a1 - a0) * (uv2[c] - uv0[c]) - (a2 - a0) * (uv1[c] - uv0[c])) / det;
+			transform.m[axisA][c] = c0;
+			transform.m[axisB][c] = c1;
+			transform.m[3][c] = uv0[c] - c0 * a0 - c1 * b0;
+		}
+	}
+
+	return transforms;
+}
+
+void MapChipMeshBuilder::AddQuad(MapChipMesh& mesh, const Vector3 (&corners)[4], const Vector3& normal) {
+	const float w = MapChipField::kBlockWidth;
+	const float h = MapChipField::kBlockHeight;
+
+	// UV はタイル単位（シェーダーではワールド座標から求め直すので、デバッグ表示用）
+	const Vector3 edgeU = corners[1] - corners[0];
+	const Vector3 edgeV = corners[3] - corners[0];
+	const float lengthU = std::sqrt(Dot(edgeU, edgeU)) / w;
+	const float lengthV = std::sqrt(Dot(edgeV, edgeV)) / h;
+	const Vector2 uvs[4] = {{0.0f, 0.0f}, {lengthU, 0.0f}, {lengthU, lengthV}, {0.0f, lengthV}};
+
+	const uint32_t base = static_cast<uint32_t>(mesh.vertices.size());
+	for (int i = 0; i < 4; ++i) {
+		mesh.vertices.push_back({corners[i], normal, uvs[i]});
+	}
+
+	// 時計回りが表（左手座標系で (v1 - v0) x (v2 - v0) が外向き）になるように並べる
+	const Vector3 faceNormal = Cross(edgeU, corners[2] - corners[0]);
+	if (Dot(faceNormal, normal) >= 0.0f) {
+		mesh.indices.insert(mesh.indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+	} else {
+		mesh.indices.insert(mesh.indices.end(), {base, base + 2, base + 1, base, base + 3, base + 2});
+	}
+}
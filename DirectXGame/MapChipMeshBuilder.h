@@ -0,0 +1,53 @@
+#pragma once
+#include "KamataEngine.h"
+#include "MapChipField.h"
+#include <vector>
+
+// マップチップから作ったメッシュ（頂点はワールド座標）
+struct MapChipMesh {
+	std::vector<KamataEngine::Mesh::VertexPosNormalUv> vertices;
+	std::vector<uint32_t> indices;
+	uint32_t blockCount = 0; // 含まれるブロックの数
+};
+
+/// <summary>
+/// ブロックの見えている面だけを、隣り合う面を大きな四角形にまとめてメッシュにする
+/// </summary>
+class MapChipMeshBuilder {
+public:
+	// 面の番号
+	enum Face {
+		kRight,  // +X
+		kLeft,   // -X
+		kTop,    // +Y
+		kBottom, // -Y
+		kBack,   // +Z
+		kFront,  // -Z（カメラ側）
+
+		kFaceCount,
+	};
+
+	// ブロックを立方体のまま描いたときの1つ分の三角形の数
+	static inline const uint32_t kTrianglesPerBlock = 12;
+
+	/// <summary>
+	/// チャンクのメッシュを作る
+	/// 前後の面は長方形に、上下左右の面は一列ずつにまとめる。隣がブロックの面は作らない（マップの外は空白扱い）
+	/// </summary>
+	/// <param name="field">マップチップフィールド</param>
+	/// <param name="chunkX">チャンクの横番号</param>
+	/// <param name="chunkY">チャンクの縦番号</param>
+	/// <param name="mesh">作ったメッシュ（以前の内容は消す）</param>
+	static void BuildChunk(const MapChipField& field, uint32_t chunkX, uint32_t chunkY, MapChipMesh& mesh);
+
+	/// <summary>
+	/// ブロックのモデルから、面ごとの「ブロック内の座標 → UV」の変換行列を作る（LevelMeshPS.hlsl で使う）
+	/// </summary>
+	/// <param name="mesh">ブロックのメッシュ（原点を中心とした立方体）</param>
+	/// <returns>Face の順に並んだ変換行列</returns>
+	static std::vector<KamataEngine::Matrix4x4> MakeFaceUVTransforms(KamataEngine::Mesh& mesh);
+
+private:
+	// 四角形を1枚追加する（corners は外側から見て一周する順。表が外側を向くように並びを合わせる）
+	static void AddQuad(MapChipMesh& mesh, const KamataEngine::Vector3 (&corners)[4], const KamataEngine::Vector3& normal);
+};
@@ -0,0 +1,151 @@
+#define NOMINMAX
+#include "MapChipOccupancyPyramid.h"
+#include <algorithm>
+
+void MapChipOccupancyPyramid::Build(const MapChipData& data) {
+
+	data_ = &data;
+	width_ = data.width;
+	height_ = data.height;
+
+	levels_.clear();
+
+	// 1セルがマップ全体を覆うまでレベルを重ねる
+	uint32_t width = width_;
+	uint32_t height = height_;
+	while (width > 1 || height > 1) {
+		width = (width + 1) / 2;
+		height = (height + 1) / 2;
+
+		Level level;
+		level.width = width;
+		level.height = height;
+		level.occupied.assign(static_cast<size_t>(width) * height, 0);
+		levels_.push_back(std::move(level));
+	}
+
+	UpdateRegion(0, 0, width_, height_);
+}
+
+void MapChipOccupancyPyramid::UpdateRegion(uint32_t xIndex, uint32_t yIndex, uint32_t numX, uint32_t numY) {
+
+	if (numX == 0 || numY == 0 || xIndex >= width_ || yIndex >= height_) {
+		return;
+	}
+
+	// マップ内に切り詰めた範囲（両端を含む）
+	uint32_t x0 = xIndex;
+	uint32_t y0 = yIndex;
+	uint32_t x1 = std::min(xIndex + numX, width_) - 1;
+	uint32_t y1 = std::min(yIndex + numY, height_) - 1;
+
+	// 細かいレベルから順に、範囲に掛かるセルを作り直す
+	for (uint32_t level = 1; level <= levels_.size(); ++level) {
+		x0 >>= 1;
+		y0 >>= 1;
+		x1 >>= 1;
+		y1 >>= 1;
+
+		for (uint32_t cellY = y0; cellY <= y1; ++cellY) {
+			for (uint32_t cellX = x0; cellX <= x1; ++cellX) {
+				UpdateCell(level, cellX, cellY);
+			}
+		}
+	}
+}
+
+bool MapChipOccupancyPyramid::IsRegionEmpty(uint32_t xIndex0, uint32_t yIndex0, uint32_t xIndex1, uint32_t yIndex1) const {
+
+	if (!data_ || xIndex0 > xIndex1 || yIndex0 > yIndex1 || xIndex0 >= width_ || yIndex0 >= height_) {
+		return true;
+	}
+
+	xIndex1 = std::min(xIndex1, width_ - 1);
+	yIndex1 = std::min(yIndex1, height_ - 1);
+
+	// 範囲が縦横とも2セル以内に収まる最も細かいレベルから辿る（最上位から降りると、狭い範囲でも全レベルを通ることになる）
+	uint32_t level = 0;
+	while (level < levels_.size() && ((xIndex1 >> level) - (xIndex0 >> level) > 1 || (yIndex1 >> level) - (yIndex0 >> level) > 1)) {
+		++level;
+	}
+
+	for (uint32_t cellY = yIndex0 >> level; cellY <= (yIndex1 >> level); ++cellY) {
+		for (uint32_t cellX = xIndex0 >> level; cellX <= (xIndex1 >> level); ++cellX) {
+			if (!IsCellRegionEmpty(level, cellX, cellY, xIndex0, yIndex0, xIndex1, yIndex1)) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+uint32_t MapChipOccupancyPyramid::GetEmptyLevel(uint32_t xIndex, uint32_t yIndex) const {
+
+	// 親が空なら子も空なので、細かい方から最初に埋まっているレベルを探す
+	uint32_t level = 0;
+	while (level < levels_.size() && !IsOccupied(level + 1, xIndex >> (level + 1), yIndex >> (level + 1))) {
+		++level;
+	}
+
+	return level;
+}
+
+void MapChipOccupancyPyramid::UpdateCell(uint32_t level, uint32_t cellX, uint32_t cellY) {
+
+	// 1つ下のレベルの 2x2 セルのどれかが埋まっていれば埋まっている
+	const uint32_t childX = cellX * 2;
+	const uint32_t childY = cellY * 2;
+
+	const bool occupied = IsOccupied(level - 1, childX, childY) || IsOccupied(level - 1, childX + 1, childY) || IsOccupied(level - 1, childX, childY + 1) ||
+	                      IsOccupied(level - 1, childX + 1, childY + 1);
+
+	Level& target = levels_[level - 1];
+	target.occupied[static_cast<size_t>(cellY) * target.width + cellX] = occupied ? 1 : 0;
+}
+
+bool MapChipOccupancyPyramid::IsCellRegionEmpty(
+    uint32_t level, uint32_t cellX, uint32_t cellY, uint32_t xIndex0, uint32_t yIndex0, uint32_t xIndex1, uint32_t yIndex1) const {
+
+	// セルが覆うタイル範囲
+	const uint64_t cellX0 = static_cast<uint64_t>(cellX) << level;
+	const uint64_t cellY0 = static_cast<uint64_t>(cellY) << level;
+	const uint64_t cellX1 = cellX0 + (uint64_t(1) << level) - 1;
+	const uint64_t cellY1 = cellY0 + (uint64_t(1) << level) - 1;
+
+	// 範囲と重ならない、または空のセルは読み飛ばす
+	if (cellX0 > xIndex1 || cellX1 < xIndex0 || cellY0 > yIndex1 || cellY1 < yIndex0 || !IsOccupied(level, cellX, cellY)) {
+		return true;
+	}
+
+	// 埋まっているセルが範囲に含まれていれば空ではない
+	if (level == 0 || (cellX0 >= xIndex0 && cellX1 <= xIndex1 && cellY0 >= yIndex0 && cellY1 <= yIndex1)) {
+		return false;
+	}
+
+	// 一部だけ重なっている場合は子を調べる
+	for (uint32_t child = 0; child < 4; ++child) {
+		if (!IsCellRegionEmpty(level - 1, cellX * 2 + (child & 1), cellY * 2 + (child >> 1), xIndex0, yIndex0, xIndex1, yIndex1)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool MapChipOccupancyPyramid::IsOccupied(uint32_t level, uint32_t cellX, uint32_t cellY) const {
+
+	if (level == 0) {
+		if (cellX >= width_ || cellY >= height_) {
+			return false;
+		}
+		return data_->Data[static_cast<size_t>(cellY) * width_ + cellX] == MapChipType::kBlock;
+	}
+
+	const Level& source = levels_[level - 1];
+	if (cellX >= source.width || cellY >= source.height) {
+		return false;
+	}
+
+	return source.occupied[static_cast<size_t>(cellY) * source.width + cellX] != 0;
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include "MapChipField.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// マップチップのブロック占有ピラミッド
+/// レベル k の1セルは 2^k x 2^k タイルの範囲に「ブロックが1つでもあるか」を持つ（レベル 0 はタイルそのもの）
+/// 空いている広い範囲をまとめて読み飛ばすのに使う
+/// </summary>
+class MapChipOccupancyPyramid {
+public:
+	/// <summary>
+	/// マップ全体から全レベルを作り直す
+	/// </summary>
+	/// <param name="data">参照するマップチップデータ（以後の問い合わせでも参照し続ける）</param>
+	void Build(const MapChipData& data);
+
+	/// <summary>
+	/// タイルが変更された範囲に掛かるセルだけを作り直す
+	/// </summary>
+	/// <param name="xIndex">範囲の左端</param>
+	/// <param name="yIndex">範囲の上端</param>
+	/// <param name="numX">横のタイル数</param>
+	/// <param name="numY">縦のタイル数</param>
+	void UpdateRegion(uint32_t xIndex, uint32_t yIndex, uint32_t numX, uint32_t numY);
+
+	/// <summary>
+	/// 範囲（両端を含む）にブロックが1つも無いか（マップ外は空白扱い）
+	/// </summary>
+	bool IsRegionEmpty(uint32_t xIndex0, uint32_t yIndex0, uint32_t xIndex1, uint32_t yIndex1) const;
+
+	/// <summary>
+	/// タイルを含むセルが空になっている最も粗いレベル（タイルを含む 2x2 のセルにもブロックがあれば 0）
+	/// </summary>
+	uint32_t GetEmptyLevel(uint32_t xIndex, uint32_t yIndex) const;
+
+	// 作成済みのマップと大きさが一致しているか
+	bool IsBuiltFor(const MapChipData& data) const { return data_ == &data && width_ == data.width && height_ == data.height; }
+
+private:
+	// 1レベル分の占有情報
+	struct Level {
+		std::vector<uint8_t> occupied; // 行優先。0 なら空
+		uint32_t width = 0;
+		uint32_t height = 0;
+	};
+
+	/// <summary>
+	/// セルの占有情報を1つ下のレベルから求める
+	/// </summary>
+	void UpdateCell(uint32_t level, uint32_t cellX, uint32_t cellY);
+
+	/// <summary>
+	/// セル以下に範囲と重なるブロックが無いか
+	/// </summary>
+	bool IsCellRegionEmpty(uint32_t level, uint32_t cellX, uint32_t cellY, uint32_t xIndex0, uint32_t yIndex0, uint32_t xIndex1, uint32_t yIndex1) const;
+
+	// 指定レベルのセルの占有（レベル 0 はタイルを見る）
+	bool IsOccupied(uint32_t level, uint32_t cellX, uint32_t cellY) const;
+
+	// 参照するマップチップデータ
+	const MapChipData* data_ = nullptr;
+
+	// 作成時のマップの大きさ
+	uint32_t width_ = 0;
+	uint32_t height_ = 0;
+
+	// levels_[k - 1] がレベル k（2^k x 2^k タイル）
+	std::vector<Level> levels_;
+};
@@ -0,0 +1,122 @@
+#define NOMINMAX
+#include "MapChipStreamer.h"
+#include <algorithm>
+#include <cstring>
+
+MapChipStreamer::~MapChipStreamer() { Stop(); }
+
+bool MapChipStreamer::Open(const std::string& filePath) {
+
+	Stop();
+
+	return file_.Open(filePath);
+}
+
+void MapChipStreamer::Start(uint32_t width, uint32_t height, uint32_t tileOffset) {
+
+	width_ = width;
+	height_ = height;
+	tileOffset_ = tileOffset;
+
+	stopRequested_ = false;
+	worker_ = std::thread(&MapChipStreamer::WorkerMain, this);
+}
+
+void MapChipStreamer::Stop() {
+
+	// ワーカースレッドを止める
+	if (worker_.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stopRequested_ = true;
+		}
+		requestCondition_.notify_all();
+		worker_.join();
+	}
+
+	requests_.clear();
+	completed_.clear();
+	inFlight_ = 0;
+
+	file_.Close();
+}
+
+void MapChipStreamer::Request(uint32_t chunkX, uint32_t chunkY) {
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		requests_.push_back(LoadRequest{chunkX, chunkY, std::chrono::steady_clock::now()});
+	}
+	requestCondition_.notify_one();
+}
+
+void MapChipStreamer::TakeCompleted(std::vector<LoadResult>& results) {
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	if (completed_.empty()) {
+		return;
+	}
+
+	results.insert(results.end(), std::make_move_iterator(completed_.begin()), std::make_move_iterator(completed_.end()));
+	completed_.clear();
+}
+
+void MapChipStreamer::WaitIdle() {
+
+	std::unique_lock<std::mutex> lock(mutex_);
+	idleCondition_.wait(lock, [this] { return requests_.empty() && inFlight_ == 0; });
+}
+
+void MapChipStreamer::WorkerMain() {
+
+	while (true) {
+		LoadRequest request;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			requestCondition_.wait(lock, [this] { return stopRequested_ || !requests_.empty(); });
+
+			if (stopRequested_) {
+				return;
+			}
+
+			request = requests_.front();
+			requests_.pop_front();
+			++inFlight_;
+		}
+
+		// ロックの外でファイルから読み出す（ページインが発生してもメインスレッドを止めない）
+		LoadResult result;
+		ReadChunk(request, result);
+		result.latencyMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - request.requestTime).count();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			completed_.push_back(result);
+			--inFlight_;
+		}
+		idleCondition_.notify_all();
+	}
+}
+
+void MapChipStreamer::ReadChunk(const LoadRequest& request, LoadResult& result) const {
+
+	const uint32_t kChunkSize = MapChipField::kChunkSize;
+
+	result.chunkX = request.chunkX;
+	result.chunkY = request.chunkY;
+	result.tiles.fill(MapChipType::kBlank);
+
+	// マップ端のチャンクはマップ内の部分だけコピーする
+	const uint32_t x0 = request.chunkX * kChunkSize;
+	const uint32_t y0 = request.chunkY * kChunkSize;
+	const uint32_t columns = std::min(kChunkSize, width_ - x0);
+	const uint32_t rows = std::min(kChunkSize, height_ - y0);
+
+	// タイルのバイトは MapChipField::OpenMapChipStream が開くときに検証済み（空白かブロックだけ）
+	const uint8_t* tiles = file_.GetData() + tileOffset_;
+
+	for (uint32_t y = 0; y < rows; ++y) {
+		std::memcpy(&result.tiles[y * kChunkSize], tiles + static_cast<size_t>(y0 + y) * width_ + x0, columns);
+	}
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include "MapChipField.h"
+#include "MappedFile.h"
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// ベイク済みマップからチャンク単位でタイルを読み出すバックグラウンドローダー
+/// 読み出しはワーカースレッドで行い、結果はメインスレッドが TakeCompleted で受け取って反映する
+/// </summary>
+class MapChipStreamer {
+public:
+	// 1チャンク分のタイル数
+	static inline const uint32_t kChunkTileCount = MapChipField::kChunkSize * MapChipField::kChunkSize;
+
+	// 読み込み結果
+	struct LoadResult {
+		uint32_t chunkX = 0;
+		uint32_t chunkY = 0;
+		// チャンク内のタイル（行優先、kChunkSize x kChunkSize）
+		std::array<MapChipType, kChunkTileCount> tiles = {};
+		// リクエストから読み込み完了までの時間（ミリ秒）
+		float latencyMs = 0.0f;
+	};
+
+	MapChipStreamer() = default;
+	~MapChipStreamer();
+
+	// コピー禁止
+	MapChipStreamer(const MapChipStreamer&) = delete;
+	MapChipStreamer& operator=(const MapChipStreamer&) = delete;
+
+	/// <summary>
+	/// ベイク済みマップをメモリマップする（ヘッダの検証は呼び出し側で行う）
+	/// </summary>
+	/// <param name="filePath"></param>
+	/// <returns>成功したら true</returns>
+	bool Open(const std::string& filePath);
+
+	/// <summary>
+	/// ワーカースレッドを開始する
+	/// </summary>
+	/// <param name="width">マップの横のタイル数</param>
+	/// <param name="height">マップの縦のタイル数</param>
+	/// <param name="tileOffset">ファイル内のタイル配列の先頭オフセット</param>
+	void Start(uint32_t width, uint32_t height, uint32_t tileOffset);
+
+	/// <summary>
+	/// ワーカースレッドを停止してファイルを閉じる
+	/// </summary>
+	void Stop();
+
+	/// <summary>
+	/// チャンクの読み込みをリクエストする
+	/// </summary>
+	void Request(uint32_t chunkX, uint32_t chunkY);
+
+	/// <summary>
+	/// 読み込みが終わったチャンクを受け取る
+	/// </summary>
+	/// <param name="results">受け取り先（末尾に追加される）</param>
+	void TakeCompleted(std::vector<LoadResult>& results);
+
+	/// <summary>
+	/// リクエスト済みのチャンクが全て読み込み終わるまで待つ
+	/// </summary>
+	void WaitIdle();
+
+	// マップしたファイル
+	const MappedFile& GetFile() const { return file_; }
+
+private:
+	// 読み込みリクエスト
+	struct LoadRequest {
+		uint32_t chunkX;
+		uint32_t chunkY;
+		std::chrono::steady_clock::time_point requestTime;
+	};
+
+	/// <summary>
+	/// ワーカースレッドの処理
+	/// </summary>
+	void WorkerMain();
+
+	/// <summary>
+	/// マップしたファイルから1チャンク分のタイルをコピーする
+	/// </summary>
+	void ReadChunk(const LoadRequest& request, LoadResult& result) const;
+
+	// ベイク済みマップ
+	MappedFile file_;
+
+	// マップのサイズとタイル配列の位置
+	uint32_t width_ = 0;
+	uint32_t height_ = 0;
+	uint32_t tileOffset_ = 0;
+
+	// ワーカースレッド
+	std::thread worker_;
+
+	// 以下は mutex_ で保護する
+	std::mutex mutex_;
+	std::condition_variable requestCondition_;
+	std::condition_variable idleCondition_;
+	std::deque<LoadRequest> requests_;
+	std::vector<LoadResult> completed_;
+	// ワーカーが処理中のリクエスト数
+	uint32_t inFlight_ = 0;
+	// 停止フラグ
+	bool stopRequested_ = false;
+};
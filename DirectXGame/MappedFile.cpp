@@ -0,0 +1,121 @@
+#define NOMINMAX
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() { Close(); }
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& filePath) {
+
+	// 既に開いていたら閉じる
+	Close();
+
+	// ファイルを開く
+	HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	// ファイルサイズの取得（空ファイルはマップできない）
+	LARGE_INTEGER fileSize = {};
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0) {
+		CloseHandle(file);
+		return false;
+	}
+
+	// 読み取り専用でマップする
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping) {
+		CloseHandle(file);
+		return false;
+	}
+
+	const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	file_ = file;
+	mapping_ = mapping;
+	data_ = static_cast<const uint8_t*>(view);
+	size_ = static_cast<size_t>(fileSize.QuadPart);
+
+	return true;
+}
+
+void MappedFile::Close() {
+
+	if (data_) {
+		UnmapViewOfFile(data_);
+		data_ = nullptr;
+	}
+
+	if (mapping_) {
+		CloseHandle(mapping_);
+		mapping_ = nullptr;
+	}
+
+	if (file_) {
+		CloseHandle(file_);
+		file_ = nullptr;
+	}
+
+	size_ = 0;
+}
+
+#else
+
+// Windows 以外（テストのビルド）では mmap でマップする。マップはファイルを閉じても残るので、ハンドルは持たない
+bool MappedFile::Open(const std::string& filePath) {
+
+	// 既に開いていたら閉じる
+	Close();
+
+	// ファイルを開く
+	const int file = open(filePath.c_str(), O_RDONLY);
+	if (file < 0) {
+		return false;
+	}
+
+	// ファイルサイズの取得（空ファイルはマップできない）
+	struct stat fileStat = {};
+	if (fstat(file, &fileStat) != 0 || fileStat.st_size <= 0) {
+		close(file);
+		return false;
+	}
+
+	// 読み取り専用でマップする
+	void* view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (view == MAP_FAILED) {
+		return false;
+	}
+
+	data_ = static_cast<const uint8_t*>(view);
+	size_ = static_cast<size_t>(fileStat.st_size);
+
+	return true;
+}
+
+void MappedFile::Close() {
+
+	if (data_) {
+		munmap(const_cast<uint8_t*>(data_), size_);
+		data_ = nullptr;
+	}
+
+	size_ = 0;
+}
+
+#endif
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// <summary>
+/// 読み取り専用のメモリマップドファイル
+/// ファイル全体をアドレス空間にマップし、コピーせずに参照する
+/// </summary>
+class MappedFile {
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	// コピー禁止（マッピングハンドルを二重に閉じないため）
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/// <summary>
+	/// ファイルを開いてマップする
+	/// </summary>
+	/// <param name="filePath">ファイルパス</param>
+	/// <returns>成功したら true</returns>
+	bool Open(const std::string& filePath);
+
+	/// <summary>
+	/// マップを解除してファイルを閉じる
+	/// </summary>
+	void Close();
+
+	// アクセッサ
+	bool IsOpen() const { return data_ != nullptr; }
+	const uint8_t* GetData() const { return data_; }
+	size_t GetSize() const { return size_; }
+
+private:
+	// ファイルハンドル
+	void* file_ = nullptr;
+
+	// ファイルマッピングハンドル
+	void* mapping_ = nullptr;
+
+	// マップされた先頭アドレス
+	const uint8_t* data_ = nullptr;
+
+	// ファイルサイズ
+	size_t size_ = 0;
+};
@@ -1,6 +1,7 @@
 #include "Math.h"
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <numbers>
 
 using namespace KamataEngine;
@@ -299,8 +300,8 @@ Matrix4x4 Math::MakeRotateXMatrix(float radian) {
 	Matrix4x4 result;
 
 	// cos(radian)とsin(radian)を計算
-	float cosRadian = std::cosf(radian);
-	float sinRadian = std::sinf(radian);
+	float cosRadian = std::cos(radian);
+	float sinRadian = std::sin(radian);
 
 	// X軸回転行列を作成
 	result.m[0][0] = 1.0f;
@@ -333,8 +334,8 @@ Matrix4x4 Math::MakeRotateYMatrix(float radian) {
 	Matrix4x4 result;
 
 	// cos(radian)とsin(radian)を計算
-	float cosRadian = std::cosf(radian);
-	float sinRadian = std::sinf(radian);
+	float cosRadian = std::cos(radian);
+	float sinRadian = std::sin(radian);
 
 	// Y軸回転行列を作成
 	result.m[0][0] = cosRadian;
@@ -367,8 +368,8 @@ Matrix4x4 Math::MakeRotateZMatrix(float radian) {
 	Matrix4x4 result;
 
 	// cos(radian)とsin(radian)を計算
-	float cosRadian = std::cosf(radian);
-	float sinRadian = std::sinf(radian);
+	float cosRadian = std::cos(radian);
+	float sinRadian = std::sin(radian);
 
 	// Z軸回転行列を作成
 	result.m[0][0] = cosRadian;
@@ -528,14 +529,14 @@ KamataEngine::Vector3 Math::Transform(const KamataEngine::Vector3& vector, Kamat
 
 float Math::EaseIn(float t, float x1, float x2) {
 
-	float easedT = std::powf(std::clamp(t, 0.0f, 1.0f), 2.0f);
+	float easedT = std::pow(std::clamp(t, 0.0f, 1.0f), 2.0f);
 
 	return (1.0f - easedT) * x1 + easedT * x2;
 }
 
 float Math::EaseOut(float t, float x1, float x2) {
 
-	float easedT = 1.0f - std::powf(1.0f - std::clamp(t, 0.0f, 1.0f), 3.0f);
+	float easedT = 1.0f - std::pow(1.0f - std::clamp(t, 0.0f, 1.0f), 3.0f);
 
 	return (1.0f - easedT) * x1 + easedT * x2;
 }
@@ -0,0 +1,49 @@
+#include "ModelInstanceBuffer.h"
+#include <cassert>
+#include <cstring>
+
+using namespace KamataEngine;
+
+void ModelInstanceBuffer::Create(const std::vector<Matrix4x4>& worldMatrices) {
+	Release();
+
+	worldMatrices_ = worldMatrices;
+	if (worldMatrices_.empty()) {
+		return;
+	}
+
+	// デバイスが無い環境（描画を記録するだけの場合）では CPU 側の写しだけを持つ
+	ID3D12Device* device = DirectXCommon::GetInstance()->GetDevice();
+	if (!device) {
+		return;
+	}
+
+	// 一度書き込んだら書き換えないので、アップロードヒープに置いてそのまま読ませる
+	D3D12_HEAP_PROPERTIES heapProperties{};
+	heapProperties.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+	D3D12_RESOURCE_DESC resourceDesc{};
+	resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+	resourceDesc.Width = sizeof(Matrix4x4) * worldMatrices_.size();
+	resourceDesc.Height = 1;
+	resourceDesc.DepthOrArraySize = 1;
+	resourceDesc.MipLevels = 1;
+	resourceDesc.SampleDesc.Count = 1;
+	resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+	HRESULT result = device->CreateCommittedResource(
+	    &heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&resource_));
+	assert(SUCCEEDED(result));
+
+	// 行列を書き込む
+	void* mapped = nullptr;
+	result = resource_->Map(0, nullptr, &mapped);
+	assert(SUCCEEDED(result));
+	std::memcpy(mapped, worldMatrices_.data(), static_cast<size_t>(resourceDesc.Width));
+	resource_->Unmap(0, nullptr);
+}
+
+void ModelInstanceBuffer::Release() {
+	worldMatrices_.clear();
+	resource_.Reset();
+}
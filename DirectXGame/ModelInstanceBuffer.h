@@ -0,0 +1,37 @@
+#pragma once
+#include "KamataEngine.h"
+#include <vector>
+
+/// <summary>
+/// インスタンス描画用のワールド行列バッファ
+/// 生成後は書き換えない静的なオブジェクト（マップのブロックなど）向け
+/// </summary>
+class ModelInstanceBuffer {
+public:
+	/// <summary>
+	/// 行列の配列からバッファを生成する（以前の内容は破棄する）
+	/// </summary>
+	/// <param name="worldMatrices">インスタンスごとのワールド行列</param>
+	void Create(const std::vector<KamataEngine::Matrix4x4>& worldMatrices);
+
+	/// <summary>
+	/// バッファを破棄する
+	/// </summary>
+	void Release();
+
+	// インスタンス数の getter
+	uint32_t GetInstanceCount() const { return static_cast<uint32_t>(worldMatrices_.size()); }
+
+	// ワールド行列の getter（CPU 側の写し）
+	const std::vector<KamataEngine::Matrix4x4>& GetWorldMatrices() const { return worldMatrices_; }
+
+	// GPU アドレスの getter（GPU バッファが無ければ 0）
+	D3D12_GPU_VIRTUAL_ADDRESS GetGPUVirtualAddress() const { return resource_ ? resource_->GetGPUVirtualAddress() : 0; }
+
+private:
+	// ワールド行列（CPU 側の写し。描画の記録やカリングで使う）
+	std::vector<KamataEngine::Matrix4x4> worldMatrices_;
+
+	// GPU 上のバッファ（StructuredBuffer として頂点シェーダーから読む）
+	Microsoft::WRL::ComPtr<ID3D12Resource> resource_;
+};
@@ -0,0 +1,36 @@
+#include "ModelRenderBackend.h"
+#include <cassert>
+
+using namespace KamataEngine;
+
+void ModelRenderBackend::BeginPass(const RenderPipelineKey& pipelineKey) {
+	const ModelCommon::PipelineSetKey key = RenderQueue::ToPipelineSetKey(pipelineKey);
+	Model::PreDraw(key.cullingMode, key.blendMode, key.depthTestMode);
+}
+
+void ModelRenderBackend::EndPass() { Model::PostDraw(); }
+
+void ModelRenderBackend::BindRenderer(InstancedModelRenderer& renderer) {
+	assert(camera_);
+	renderer.BeginPass(*camera_);
+}
+
+void ModelRenderBackend::UnbindRenderer(InstancedModelRenderer& renderer) { renderer.EndPass(); }
+
+void ModelRenderBackend::Draw(const RenderPacket& packet) {
+	assert(camera_);
+
+	switch (packet.type) {
+	case RenderPacket::Type::kModel:
+		packet.model->Draw(*packet.worldTransform, *camera_);
+		break;
+
+	case RenderPacket::Type::kInstanced:
+		packet.renderer->Draw(*packet.model, packet.instances, packet.instanceCount, *camera_);
+		break;
+
+	case RenderPacket::Type::kInstancedIndexed:
+		packet.renderer->DrawIndexed(*packet.vbView, *packet.ibView, packet.indexCount, *packet.material, *packet.matrices, packet.instanceCount, *camera_);
+		break;
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "RenderQueue.h"
+
+/// <summary>
+/// エンジンの Model と InstancedModelRenderer で実際に描画する実行先
+/// </summary>
+class ModelRenderBackend : public RenderBackend {
+public:
+	/// <summary>
+	/// 描画に使うカメラを設定する（Execute の前に呼ぶ）
+	/// </summary>
+	/// <param name="camera">カメラ</param>
+	void SetCamera(const KamataEngine::Camera& camera) { camera_ = &camera; }
+
+	/// <summary>
+	/// パスの開始（Model::PreDraw）
+	/// </summary>
+	void BeginPass(const RenderPipelineKey& pipelineKey) override;
+
+	/// <summary>
+	/// パスの終了（Model::PostDraw）
+	/// </summary>
+	void EndPass() override;
+
+	/// <summary>
+	/// インスタンス描画のパイプラインと共通の定数を積む
+	/// </summary>
+	void BindRenderer(InstancedModelRenderer& renderer) override;
+
+	/// <summary>
+	/// インスタンス描画のパイプラインから離れる
+	/// </summary>
+	void UnbindRenderer(InstancedModelRenderer& renderer) override;
+
+	/// <summary>
+	/// 描画
+	/// </summary>
+	void Draw(const RenderPacket& packet) override;
+
+private:
+	// 描画に使うカメラ
+	const KamataEngine::Camera* camera_ = nullptr;
+};
@@ -29,6 +29,13 @@ void Player::Initialize(Model* model, Camera* camera, const Vector3& position) {
 	// 弾モデルの生成
 	bulletModel_ = Model::CreateFromOBJ("Block", true);
 
+	// 弾（ここで配列を全部確保し、以後は使い回す）
+	projectiles_.Initialize(kProjectileCapacity);
+	projectiles_.SetMapChipField(mapChipField_);
+
+	// ワイヤーの鎖（射程いっぱいの分をここで確保する）
+	wireChain_.Initialize(GetWireChainCapacity());
+
 	// ワールド変換の初期化
 	worldTransformPlayer_.Initialize();
 
@@ -96,9 +103,6 @@ void Player::Update() {
 		// リロード中は発射不可
 		if (!isReloading_ && currentBullets_ > 0 && fireTimer_ <= 0.0f) {
 			if (Input::GetInstance()->PushKey(DIK_J)) {
-				// 弾の生成
-				auto* newBullet = new Bullet();
-
 				Vector3 bulletDir;
 
 				if (lrDirection_ == LRDirection::kRight) {
@@ -107,19 +111,17 @@ void Player::Update() {
 					bulletDir = {-1.0f, 0.0f, 0.0f}; // 左
 				}
 
-				newBullet->Initialize(bulletModel_, camera_, worldTransformPlayer_.translation_, bulletDir);
-
-				bullets_.push_back(newBullet);
-
-				newBullet->SetMapChipField(mapChipField_);
+				// 弾の生成（空きスロットを使い回す。空きが無ければ撃たない）
+				Bullet newBullet = projectiles_.Spawn(bulletModel_, worldTransformPlayer_.translation_, bulletDir);
+				if (newBullet.IsValid()) {
+					// 弾消費
+					currentBullets_--;
 
-				// 弾消費
-				currentBullets_--;
+					currentBullets_ = std::max(currentBullets_, 0);
 
-				currentBullets_ = std::max(currentBullets_, 0);
-
-				// 発射クールタイムリセット
-				fireTimer_ = fireInterval_;
+					// 発射クールタイムリセット
+					fireTimer_ = fireInterval_;
+				}
 			}
 		}
 
@@ -164,14 +166,11 @@ void Player::Update() {
 		}
 	}
 
-	// 弾の更新
-	for (auto* bullet : bullets_) {
-
-		bullet->Update();
-	}
+	// 弾の更新（使用中の弾をまとめて進める）
+	projectiles_.Update();
 
 	// Note:
-	// 死んだ弾の削除は Update の最後にまとめて行うようにしました。
+	// 死んだ弾の返却は Update の最後にまとめて行うようにしました。
 	// これにより同一ポインタを複数箇所で delete してしまう事態（double delete）を避け、
 	// wire 処理での削除は「IsDead() を立てる」だけに統一します。
 
@@ -306,18 +305,15 @@ void Player::Update() {
 	// ----------------------
 	if (wireMode_ == WireMode::Shot) {
 		// 射出用弾が存在するかをチェック。弾自身の当たり判定で刺さったら hooked_ が立つ。
-		if (wireProjectile_) {
+		if (wireProjectile_.IsValid()) {
 			// プレイヤーからの距離チェック（最大射程）
-			float distFromPlayer = math.Length(wireProjectile_->GetPosition() - worldTransformPlayer_.translation_);
+			float distFromPlayer = math.Length(wireProjectile_.GetPosition() - worldTransformPlayer_.translation_);
 			if (distFromPlayer > wireMaxDistance_) {
 				// 射程オーバー: ワイヤーをキャンセルして弾を削除
-				for (auto* b : wireBullets_) {
-					// 所有は bullets_ にあるため、ここでは削除フラグを立てるだけにする
-					if (b)
-						b->Kill();
-				}
-				wireBullets_.clear();
-				wireProjectile_ = nullptr;
+				// 中身は projectiles_ にあるため、ここでは削除フラグを立てるだけにする
+				wireProjectile_.Kill();
+				wireProjectile_ = {};
+				wireChain_.Clear();
 
 				// 空中でワイヤーが外れたら滑空開始
 				if (!onGround_) {
@@ -327,54 +323,18 @@ void Player::Update() {
 
 				wireMode_ = WireMode::None;
 
-			} else if (wireProjectile_->IsHooked()) {
+			} else if (wireProjectile_.IsHooked()) {
 
 				// フック弾がブロックに刺さった -> 引っ張りに移行
-				wireHitPos_ = wireProjectile_->GetPosition();
+				wireHitPos_ = wireProjectile_.GetPosition();
 				wireMode_ = WireMode::Pulling;
 
 				// 慣性を一旦止める
 				velocity_ = {0, 0, 0};
 
-				// ワイヤーの可視化：プレイヤーから hook まで等間隔で弾モデルを配置する
-				// 既に bullets_ に wireProjectile_ が入っている想定なので、
-				// 以前の中間セグメントがあれば削除してから新規作成する
-				// まず既存のセグメント（hook 以外）を削除（ここでは削除フラグのみ）
-				for (auto* b : wireBullets_) {
-					if (b != wireProjectile_) {
-						if (b)
-							b->Kill();
-					}
-				}
-				wireBullets_.clear();
-
-				Vector3 start = worldTransformPlayer_.translation_;
-				Vector3 end = wireHitPos_;
-				Vector3 to = end - start;
-				float totalDist = math.Length(to);
-				if (totalDist > 0.001f) {
-					Vector3 dirSeg = math.Normalize(to);
-					// セグメント数は start から end まで wireSegmentSpacing_ 毎
-					int segCount = static_cast<int>(std::floor(totalDist / wireSegmentSpacing_));
-					// segCount が 0 の場合は hook のみ
-					// 我々は配列を「プレイヤー寄り → フック」の順に保持する
-					for (int i = 1; i < segCount; ++i) {
-						Vector3 segPos = start + dirSeg * (i * wireSegmentSpacing_);
-						auto* segBullet = new Bullet();
-						// 使用モデルは wireSegmentModel_ が優先（nullptr の場合は通常弾モデル）
-						KamataEngine::Model* segModel = (wireSegmentModel_) ? wireSegmentModel_ : bulletModel_;
-						// 移動しないので direction はゼロ
-						segBullet->Initialize(segModel, camera_, segPos, Vector3{0.0f, 0.0f, 0.0f});
-						segBullet->SetMapChipField(mapChipField_);
-						segBullet->SetPersistent(true);
-						segBullet->SetPosition(segPos);
-						// 管理リストへ（先に push すると順序はプレイヤー側から並ぶ）
-						bullets_.push_back(segBullet);
-						wireBullets_.push_back(segBullet);
-					}
-				}
-				// 最後に hook を配列末尾に置く（wireBullets_ の最後が hook）
-				wireBullets_.push_back(wireProjectile_);
+				// ワイヤーの可視化：プレイヤーから hook まで等間隔にセグメントを並べる
+				// セグメントは位置だけを鎖のリングバッファに持ち、「プレイヤー寄り → フック」の順に並ぶ
+				wireChain_.Build(worldTransformPlayer_.translation_, wireHitPos_, wireSegmentSpacing_);
 
 				// アキュムレータをリセット
 				wirePullAccumulatedDistance_ = 0.0f;
@@ -408,15 +368,10 @@ void Player::Update() {
 				glideTimer_ = kGlideDuration;
 			}
 
-			// ワイヤーが終わったのでワイヤー用の弾を消す（プレイヤー移動終了時に消す要件）
-			for (auto* b : wireBullets_) {
-				// hook は bullets_ にも入っているためまとめて削除フラグを立てる
-				if (b)
-					b->Kill();
-			}
-
-			wireBullets_.clear();
-			wireProjectile_ = nullptr;
+			// ワイヤーが終わったのでフックと鎖を消す（プレイヤー移動終了時に消す要件）
+			wireProjectile_.Kill();
+			wireProjectile_ = {};
+			wireChain_.Clear();
 
 		} else {
 			// 正規化（距離が非常に小さい場合はゼロベクトルを使う）
@@ -456,16 +411,10 @@ void Player::Update() {
 				// onGround_ は false のままにする（空中扱い）
 				onGround_ = false;
 
-				// 引っ張り中に衝突で解除された場合もワイヤー用の弾を消す（削除フラグのみ）
-				for (auto* b : wireBullets_) {
-					if (b) {
-						// hook は残す or 既に persistent なら Kill() で統一
-						b->Kill();
-					}
-				}
-
-				wireBullets_.clear();
-				wireProjectile_ = nullptr;
+				// 引っ張り中に衝突で解除された場合もフックと鎖を消す（フックは削除フラグのみ）
+				wireProjectile_.Kill();
+				wireProjectile_ = {};
+				wireChain_.Clear();
 
 			} else {
 
@@ -479,19 +428,9 @@ void Player::Update() {
 				float moved = math.Length(pullInfo.velocity);
 				wirePullAccumulatedDistance_ += moved;
 
-				while (wirePullAccumulatedDistance_ >= wireSegmentSpacing_ && wireBullets_.size() > 1) {
-					// wireBullets_ の先頭はプレイヤー寄りのセグメント、末尾が hook として作成している
-					Bullet* removeSeg = wireBullets_.front();
-					// 念のため hook は残す（末尾）
-					if (removeSeg == wireProjectile_) {
-						// もし先頭が hook だったら終了
-						break;
-					}
-					// リストから即座に取り除かず、削除フラグを立てる
-					if (removeSeg)
-						removeSeg->Kill();
-					// vector の先頭を消す
-					wireBullets_.erase(wireBullets_.begin());
+				while (wirePullAccumulatedDistance_ >= wireSegmentSpacing_ && wireChain_.GetSegmentCount() > 0) {
+					// 鎖の先頭はプレイヤー寄りのセグメント（フックは鎖に含まない）
+					wireChain_.PopFront();
 					wirePullAccumulatedDistance_ -= wireSegmentSpacing_;
 					// 続けて削除するループ
 				}
@@ -503,29 +442,73 @@ void Player::Update() {
 		}
 	}
 
-	// 死んだ弾の削除（Update の最後にまとめて行う）
-	bullets_.remove_if([](Bullet* bullet) {
-		if (bullet->IsDead()) {
-			delete bullet;
-			return true;
-		}
-		return false;
-	});
+	// 死んだ弾を返す（Update の最後にまとめて行う）
+	projectiles_.ReleaseDead();
 
 	// 行列の変換と転送
 	math.worldTransformUpdate(worldTransformPlayer_);
 }
 
-void Player::Draw() {
+void Player::Draw(RenderQueue& queue, const RangeRect& visibleRect) {
 
 	// モデルの描画
-	model_->Draw(worldTransformPlayer_, *camera_);
+	queue.SubmitModel(*model_, worldTransformPlayer_);
 
-	// ---- 弾の描画 ----
-	for (auto* bullet : bullets_) {
-		bullet->Draw();
+	// ---- 弾の描画（カメラに映る範囲のものだけ） ----
+	drawnBulletCount_ = 0;
+	for (BulletBatch& batch : bulletBatches_) {
+		batch.worldMatrices.clear();
 	}
 
+	// モデルごとに行列を集める（モデルは通常弾・フック・鎖の数種類だけなので線形に探す）
+	for (uint32_t i = 0; i < projectiles_.GetActiveCount(); ++i) {
+		if (!projectiles_.IsActiveVisible(i)) {
+			continue;
+		}
+
+		const Vector3 position = projectiles_.GetActivePosition(i);
+		if (position.x < visibleRect.left || position.x > visibleRect.right || position.y < visibleRect.bottom || position.y > visibleRect.top) {
+			continue;
+		}
+
+		Model* model = projectiles_.GetActiveModel(i);
+		auto batch = std::find_if(bulletBatches_.begin(), bulletBatches_.end(), [model](const BulletBatch& b) { return b.model == model; });
+		if (batch == bulletBatches_.end()) {
+			bulletBatches_.push_back({model, {}});
+			batch = bulletBatches_.end() - 1;
+		}
+		batch->worldMatrices.push_back(projectiles_.MakeActiveWorldMatrix(i));
+		++drawnBulletCount_;
+	}
+
+	// モデル1つにつき1回の描画。行列はオブジェクトごとの定数バッファではなく、フレームのリングバッファから切り出して渡す
+	if (bulletRenderer_ && frameRing_) {
+		// ワイヤーの鎖も1回の描画
+		KamataEngine::Model* segModel = (wireSegmentModel_) ? wireSegmentModel_ : bulletModel_;
+		if (segModel) {
+			wireChain_.Draw(queue, *bulletRenderer_, *frameRing_, *segModel, visibleRect);
+		}
+
+		for (const BulletBatch& batch : bulletBatches_) {
+			if (batch.worldMatrices.empty()) {
+				continue;
+			}
+
+			FrameRingBuffer::Allocation allocation;
+			if (!frameRing_->Write(batch.worldMatrices.data(), batch.worldMatrices.size(), allocation)) {
+				// リングバッファが足りないフレームは描画しない（失敗回数は統計に残る）
+				continue;
+			}
+
+			// 深度は先頭の弾の位置で代表する
+			const Matrix4x4& front = batch.worldMatrices.front();
+			queue.SubmitInstanced(*bulletRenderer_, *batch.model, allocation.gpuAddress, static_cast<uint32_t>(batch.worldMatrices.size()), {front.m[3][0], front.m[3][1], front.m[3][2]});
+		}
+	}
+}
+
+void Player::DrawAim() {
+
 	// ---- ワイヤー狙い用の矢印表示 ----
 	// ワイヤーモードで、まだワイヤーを射出していない（狙い中）の場合に表示
 	if (fireMode_ == FireMode::Wire && wireMode_ == WireMode::None) {
@@ -743,237 +726,32 @@ Vector3 Player::CornerPosition(const Vector3& center, Corner corner) {
 }
 
 void Player::CollisionDetection(CollisionMapInfo& info) {
-	CollisionDetectionUp(info);
-	CollisionDetectionDown(info);
-	CollisionDetectionRight(info);
-	CollisionDetectionLeft(info);
-}
-
-// 上方向当たり判定
-void Player::CollisionDetectionUp(CollisionMapInfo& info) {
-	// 上昇あり？
-	if (info.velocity.y < 0) {
-		return;
-	}
-
-	MapChipType mapChipType;
-	MapChipType mapChipTypeNext;
-
-	// 真上の当たり判定を行う
-	bool hit = false;
-
-	// 移動後の4つの角の座標
-	std::array<Vector3, kNumCorner> positionsNew;
-
-	for (uint32_t i = 0; i < positionsNew.size(); ++i) {
-		positionsNew[i] = CornerPosition(worldTransformPlayer_.translation_ + info.velocity, static_cast<Corner>(i));
-	}
-
-	// 左上点の判定
-	IndexSet indexSet;
-	indexSet = mapChipField_->GetMapChipIndexSetByPosition(positionsNew[kLeftTop]);
-	mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
-	mapChipTypeNext = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex + 1);
-
-	if (mapChipType == MapChipType::kBlock && mapChipTypeNext != MapChipType::kBlock) {
-		hit = true;
-	}
-
-	// 右上点の判定
-	indexSet = mapChipField_->GetMapChipIndexSetByPosition(positionsNew[kRightTop]);
-	mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
-	mapChipTypeNext = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex + 1);
-
-	if (mapChipType == MapChipType::kBlock && mapChipTypeNext != MapChipType::kBlock) {
-		hit = true;
-	}
-
-	// ブロックのヒット判定
-	if (hit) {
-
-		// めり込みを排除する方向に移動量を設定する
-		indexSet = mapChipField_->GetMapChipIndexSetByPosition(worldTransformPlayer_.translation_ + info.velocity + Vector3(0, +kHeight / 2.0f, 0));
 
-		IndexSet indexSetNow;
-		indexSetNow = mapChipField_->GetMapChipIndexSetByPosition(worldTransformPlayer_.translation_ + Vector3(0, +kHeight / 2.0f, 0));
+	// 現在位置の当たり判定の箱
+	AABB box;
+	box.min = worldTransformPlayer_.translation_ - Vector3(kWidth / 2.0f, kHeight / 2.0f, 0.0f);
+	box.max = worldTransformPlayer_.translation_ + Vector3(kWidth / 2.0f, kHeight / 2.0f, 0.0f);
 
-		if (indexSetNow.yIndex != indexSet.yIndex) {
+	// 箱が通過するタイルだけを調べて移動量を切り詰める
+	MapChipSweepResult sweep = mapChipField_->SweepAABB(box, info.velocity, kBlank);
 
-			// めり込み先のブロックの範囲矩形
-			RangeRect rect = mapChipField_->GetRectIndex(indexSet.xIndex, indexSet.yIndex);
-			info.velocity.y = std::max(0.0f, rect.bottom - worldTransformPlayer_.translation_.y - (kHeight / 2.0f + kBlank));
+	info.velocity = sweep.velocity;
 
-			// 天井に当たったことを記録
-			info.ceilingCollision = true;
-		}
+	if (sweep.ceilingCollision) {
+		// 天井に当たったことを記録
+		info.ceilingCollision = true;
 	}
-}
 
-// 下方向当たり判定
-void Player::CollisionDetectionDown(CollisionMapInfo& info) {
-	// 下昇あり？
-	if (info.velocity.y >= 0) {
-		return;
+	if (sweep.landing) {
+		// 地面に当たったことを記録
+		info.landing = true;
 	}
 
-	MapChipType mapChipType;
-	MapChipType mapChipTypeNext;
-
-	// 真上の当たり判定を行う
-	bool hit = false;
-
-	// 移動後の4つの角の座標
-	std::array<Vector3, kNumCorner> positionsNew;
-
-	for (uint32_t i = 0; i < positionsNew.size(); ++i) {
-		positionsNew[i] = CornerPosition(worldTransformPlayer_.translation_ + info.velocity, static_cast<Corner>(i));
-	}
-
-	// 左下点の判定
-	IndexSet indexSet;
-	indexSet = mapChipField_->GetMapChipIndexSetByPosition(positionsNew[kLeftBottom]);
-	mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
-	mapChipTypeNext = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex - 1);
-
-	if (mapChipType == MapChipType::kBlock && mapChipTypeNext != MapChipType::kBlock) {
-		hit = true;
-	}
-
-	// 右下点の判定
-	indexSet = mapChipField_->GetMapChipIndexSetByPosition(positionsNew[kRightBottom]);
-	mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
-	mapChipTypeNext = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex - 1);
-
-	if (mapChipType == MapChipType::kBlock && mapChipTypeNext != MapChipType::kBlock) {
-		hit = true;
-	}
-
-	// ブロックのヒット判定
-	if (hit) {
-
-		// めり込みを排除する方向に移動量を設定する
-		indexSet = mapChipField_->GetMapChipIndexSetByPosition(worldTransformPlayer_.translation_ + info.velocity + Vector3(0, -kHeight / 2.0f, 0));
-
-		IndexSet indexSetNow;
-		indexSetNow = mapChipField_->GetMapChipIndexSetByPosition(worldTransformPlayer_.translation_ + Vector3(0, -kHeight / 2.0f, 0));
-
-		if (indexSetNow.yIndex != indexSet.yIndex) {
+	// 壁にヒット？
+	if (sweep.hitWall) {
 
-			// めり込み先のブロックの範囲矩形
-			RangeRect rect = mapChipField_->GetRectIndex(indexSet.xIndex, indexSet.yIndex);
-			info.velocity.y = std::min(0.0f, rect.top - worldTransformPlayer_.translation_.y + (kHeight / 2.0f + kBlank));
-
-			// 地面に当たったことを記録
-			info.landing = true;
-		}
-	}
-}
-
-// 右方向当たり判定
-void Player::CollisionDetectionRight(CollisionMapInfo& info) {
-	// 移動後の4つの角の座標
-	std::array<Vector3, kNumCorner> positionsNew;
-
-	for (uint32_t i = 0; i < positionsNew.size(); ++i) {
-		positionsNew[i] = CornerPosition(worldTransformPlayer_.translation_ + info.velocity, static_cast<Corner>(i));
-	}
-
-	MapChipType mapChipType;
-	MapChipType mapChipTypeNext;
-
-	// 右側の当たり判定
-	bool hit = false;
-
-	// 右上点の判定
-	IndexSet indexSet;
-	indexSet = mapChipField_->GetMapChipIndexSetByPosition(positionsNew[kRightTop]);
-	mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
-	mapChipTypeNext = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex - 1, indexSet.yIndex);
-
-	if (mapChipType == MapChipType::kBlock && mapChipTypeNext != MapChipType::kBlock) {
-		hit = true;
-	}
-
-	// 右下点の判定
-	indexSet = mapChipField_->GetMapChipIndexSetByPosition(positionsNew[kRightBottom]);
-	mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
-	mapChipTypeNext = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex - 1, indexSet.yIndex);
-
-	if (mapChipType == MapChipType::kBlock && mapChipTypeNext != MapChipType::kBlock) {
-		hit = true;
-	}
-
-	// ブロックにヒット？
-	if (hit) {
-
-		// 壁方向の記録（右の壁に触れた）
-		wallTouchDirection_ = LRDirection::kRight;
-
-		// 空中かつ落下中のときのみ壁キック可能
-		if (!onGround_ && velocity_.y < 0.0f) {
-			canWallKick_ = true;
-		} else {
-			canWallKick_ = false;
-		}
-
-		// めり込みを排除する方向に移動量を設定する
-		indexSet = mapChipField_->GetMapChipIndexSetByPosition(worldTransformPlayer_.translation_ + info.velocity + Vector3(+kWidth / 2.0f, 0, 0));
-
-		// 現在座標が壁の外か判定
-		IndexSet indexSetNow;
-		indexSetNow = mapChipField_->GetMapChipIndexSetByPosition(worldTransformPlayer_.translation_ + Vector3(+kWidth / 2.0f, 0, 0));
-
-		if (indexSetNow.xIndex != indexSet.xIndex) {
-
-			// めり込み先のブロックの範囲矩形
-			RangeRect rect = mapChipField_->GetRectIndex(indexSet.xIndex, indexSet.yIndex);
-			info.velocity.x = std::max(0.0f, rect.left - worldTransformPlayer_.translation_.x - (kWidth / 2.0f + kBlank));
-
-			// 壁に当たったことを記録
-			info.hitWall = true;
-		}
-	}
-}
-
-// 左方向当たり判定
-void Player::CollisionDetectionLeft(CollisionMapInfo& info) {
-	// 移動後の4つの角の座標
-	std::array<Vector3, kNumCorner> positionsNew;
-
-	for (uint32_t i = 0; i < positionsNew.size(); ++i) {
-		positionsNew[i] = CornerPosition(worldTransformPlayer_.translation_ + info.velocity, static_cast<Corner>(i));
-	}
-
-	MapChipType mapChipType;
-	MapChipType mapChipTypeNext;
-
-	// 右側の当たり判定
-	bool hit = false;
-
-	// 左上点の判定
-	IndexSet indexSet;
-	indexSet = mapChipField_->GetMapChipIndexSetByPosition(positionsNew[kLeftTop]);
-	mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
-	mapChipTypeNext = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex + 1, indexSet.yIndex);
-
-	if (mapChipType == MapChipType::kBlock && mapChipTypeNext != MapChipType::kBlock) {
-		hit = true;
-	}
-
-	// 左下点の判定
-	indexSet = mapChipField_->GetMapChipIndexSetByPosition(positionsNew[kLeftBottom]);
-	mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
-	mapChipTypeNext = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex + 1, indexSet.yIndex);
-
-	if (mapChipType == MapChipType::kBlock && mapChipTypeNext != MapChipType::kBlock) {
-		hit = true;
-	}
-
-	// ブロックにヒット？
-	if (hit) {
-
-		// 壁方向の記録（左の壁に触れた）
-		wallTouchDirection_ = LRDirection::kLeft;
+		// 壁方向の記録
+		wallTouchDirection_ = sweep.hitWallRight ? LRDirection::kRight : LRDirection::kLeft;
 
 		// 空中かつ落下中のときのみ壁キック可能
 		if (!onGround_ && velocity_.y < 0.0f) {
@@ -982,20 +760,8 @@ void Player::CollisionDetectionLeft(CollisionMapInfo& info) {
 			canWallKick_ = false;
 		}
 
-		// めり込みを排除する方向に移動量を設定する
-		indexSet = mapChipField_->GetMapChipIndexSetByPosition(worldTransformPlayer_.translation_ + info.velocity + Vector3(-kWidth / 2.0f, 0, 0));
-
-		// 現在座標が壁の外か判定
-		IndexSet indexSetNow;
-		indexSetNow = mapChipField_->GetMapChipIndexSetByPosition(worldTransformPlayer_.translation_ + Vector3(-kWidth / 2.0f, 0, 0));
-
-		if (indexSetNow.xIndex != indexSet.xIndex) {
-
-			RangeRect rect = mapChipField_->GetRectIndex(indexSet.xIndex, indexSet.yIndex);
-			info.velocity.x = std::min(0.0f, rect.right + (kWidth / 2.0f + kBlank) - worldTransformPlayer_.translation_.x);
-			// 壁に当たったことを記録
-			info.hitWall = true;
-		}
+		// 壁に当たったことを記録
+		info.hitWall = true;
 	}
 }
 
@@ -1013,31 +779,13 @@ void Player::UpdateOnGround(const CollisionMapInfo& info) {
 		} else {
 			// 落下判定
 
-			MapChipType mapChipType;
-
-			bool hit = false;
-
-			// 移動後の4つの角の座標
-			std::array<Vector3, kNumCorner> positionsNew;
+			// 足元の少し下に足場があるか（SweepAABB の着地と同じ列・同じ方針で調べる。常駐していないチャンクも足場になる）
+			const Vector3 position = worldTransformPlayer_.translation_ + info.velocity;
+			AABB box;
+			box.min = position - Vector3(kWidth / 2.0f, kHeight / 2.0f, 0.0f);
+			box.max = position + Vector3(kWidth / 2.0f, kHeight / 2.0f, 0.0f);
 
-			for (uint32_t i = 0; i < positionsNew.size(); ++i) {
-				positionsNew[i] = CornerPosition(worldTransformPlayer_.translation_ + info.velocity, static_cast<Corner>(i));
-			}
-
-			// 左下点の判定
-			IndexSet indexSet;
-			indexSet = mapChipField_->GetMapChipIndexSetByPosition(positionsNew[kLeftBottom] + Vector3(0, -kGroundSearchHeight, 0));
-			mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
-			if (mapChipType == MapChipType::kBlock) {
-				hit = true;
-			}
-
-			// 右下点の判定
-			indexSet = mapChipField_->GetMapChipIndexSetByPosition(positionsNew[kRightBottom] + Vector3(0, -kGroundSearchHeight, 0));
-			mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
-			if (mapChipType == MapChipType::kBlock) {
-				hit = true;
-			}
+			bool hit = mapChipField_->IsGroundBelow(box, kGroundSearchHeight);
 
 			// 落下なら空中状態に切り替え
 			if (!hit) {
@@ -1082,34 +830,34 @@ void Player::UpdateOnWall(const CollisionMapInfo& info) {
 }
 
 void Player::ShootWire(const Vector3& dir) {
-	wireMode_ = WireMode::Shot;
-
 	// 方向ベクトル（正規化）
 	Vector3 nd = math.Normalize(dir);
-	wireDir_ = nd; // 保存
-
-	// 弾の生成（フック弾）
-	auto* newBullet = new Bullet();
 
 	// 使用するモデルは優先順位: wireProjectileModel_ -> bulletModel_
 	KamataEngine::Model* projModel = (wireProjectileModel_) ? wireProjectileModel_ : bulletModel_;
 
-	newBullet->Initialize(projModel, camera_, worldTransformPlayer_.translation_, nd);
-	newBullet->SetMapChipField(mapChipField_);
-	newBullet->SetPersistent(true); // ブロックに刺さったら残す
+	// 弾の生成（フック弾。空きが無ければ撃たない）
+	Bullet newBullet = projectiles_.Spawn(projModel, worldTransformPlayer_.translation_, nd);
+	if (!newBullet.IsValid()) {
+		return;
+	}
+
+	wireMode_ = WireMode::Shot;
+	wireDir_ = nd; // 保存
+
+	newBullet.SetPersistent(true); // ブロックに刺さったら残す
+	newBullet.SetSwept(true);      // 飛んだ線分で当たりを見て、ブロックの表面で止める（wireHitPos_ が行き過ぎた位置にならない）
 
 	// 発射速度を上書き（Bullet の速度フィールドを直接設定）
-	newBullet->SetVelocity(nd * wireProjectileSpeed_);
+	newBullet.SetVelocity(nd * wireProjectileSpeed_);
 
 	// フックを発射方向に傾ける
-	newBullet->SetRotationFromDirection(nd);
+	newBullet.SetRotationFromDirection(nd);
 
 	// フック弾のサイズ（既にあるなら上書きしないでください）
-	newBullet->SetScale(Vector3{0.5f, 0.5f, 0.5f});
+	newBullet.SetScale(Vector3{0.5f, 0.5f, 0.5f});
 
 	// 保持しておく
-	bullets_.push_back(newBullet);
-	wireBullets_.push_back(newBullet);
 	wireProjectile_ = newBullet;
 }
 
@@ -1123,12 +871,18 @@ void Player::SetWireProjectileSpeed(float speed) {
 	wireProjectileSpeed_ = speed;
 	// 互換のため既存 wireSpeed_ も更新しておく
 	wireSpeed_ = speed;
+
+	// 鎖の容量はフックが1フレームに進む分を含むので合わせ直す
+	wireChain_.Initialize(GetWireChainCapacity());
 }
 
 void Player::SetWireSegmentSpacing(float spacing) {
 	// 安全値チェック
 	if (spacing > 0.01f) {
 		wireSegmentSpacing_ = spacing;
+
+		// 射程いっぱいの鎖が入るように容量を合わせる
+		wireChain_.Initialize(GetWireChainCapacity());
 	}
 }
 
@@ -1,7 +1,12 @@
 #pragma once
 #include "Bullet.h"
+#include "ProjectileSystem.h"
+#include "FrameRingBuffer.h"
 #include "MapChipField.h"
 #include "Math.h"
+#include "RenderQueue.h"
+#include "WireRenderer.h"
+#include <cmath>
 #include <vector>
 
 enum class LRDirection {
@@ -49,9 +54,17 @@ public:
 	void Update();
 
 	/// <summary>
-	/// プレイヤーの描画
+	/// プレイヤーの描画（描画キューに積む）
+	/// 弾はモデルごとにまとめ、行列をフレームのリングバッファに書き込んでインスタンス描画する
 	/// </summary>
-	void Draw();
+	/// <param name="queue">描画キュー</param>
+	/// <param name="visibleRect">カメラに映る範囲（外にある弾は描画しない）</param>
+	void Draw(RenderQueue& queue, const RangeRect& visibleRect);
+
+	/// <summary>
+	/// ワイヤー狙い用の矢印の描画（スプライト。3D の描画の後に呼ぶ）
+	/// </summary>
+	void DrawAim();
 
 	/// <summary>
 	/// プレイヤーの移動
@@ -67,35 +80,11 @@ public:
 	KamataEngine::Vector3 CornerPosition(const KamataEngine::Vector3& center, Corner corner);
 
 	/// <summary>
-	/// マップの衝突判定
+	/// マップの衝突判定（MapChipField::SweepAABB で移動量を切り詰める）
 	/// </summary>
 	/// <param name="info">当たり判定の情報</param>
 	void CollisionDetection(CollisionMapInfo& info);
 
-	/// <summary>
-	/// マップの衝突判定上方向
-	/// </summary>
-	/// <param name="info">当たり判定の情報</param>
-	void CollisionDetectionUp(CollisionMapInfo& info);
-
-	/// <summary>
-	/// マップの衝突判定下方向
-	/// </summary>
-	/// <param name="info">当たり判定の情報</param>
-	void CollisionDetectionDown(CollisionMapInfo& info);
-
-	/// <summary>
-	/// マップの衝突判定右方向
-	/// </summary>
-	/// <param name="info">当たり判定の情報</param>
-	void CollisionDetectionRight(CollisionMapInfo& info);
-
-	/// <summary>
-	/// マップの衝突判定左方向
-	/// </summary>
-	/// <param name="info">当たり判定の情報</param>
-	void CollisionDetectionLeft(CollisionMapInfo& info);
-
 	/// <summary>
 	/// 接地状態の切り替えの処理
 	/// </summary>
@@ -111,7 +100,7 @@ public:
 	void ShootWire(const KamataEngine::Vector3& dir);
 
 	/*-------------- ワイヤー設定 API --------------*/
-	// ワイヤー発射で使うフック弾モデルとセグメント弾モデルを設定する（nullptr なら通常弾モデルを使用）
+	// ワイヤー発射で使うフック弾モデルと鎖のセグメントのモデルを設定する（nullptr なら通常弾モデルを使用）
 	void SetWireModels(KamataEngine::Model* projectileModel, KamataEngine::Model* segmentModel);
 
 	// ワイヤーのフック弾速度（発射時の速度）
@@ -129,15 +118,29 @@ public:
 
 	const KamataEngine::Vector3& getvelocity() const { return velocity_; }
 
-	void SetMapChipField(MapChipField* mapChipField) { this->mapChipField_ = mapChipField; };
+	void SetMapChipField(MapChipField* mapChipField) {
+		this->mapChipField_ = mapChipField;
+		projectiles_.SetMapChipField(mapChipField);
+	};
+
+	// 弾の描画に使うレンダラーとフレームのリングバッファのセット（どちらかが無ければ弾は描画しない）
+	void SetBulletRenderer(InstancedModelRenderer* renderer, FrameRingBuffer* frameRing) {
+		bulletRenderer_ = renderer;
+		frameRing_ = frameRing;
+	}
 
 	int GetCurrentBullets() const { return currentBullets_; }
 	int GetMaxBullets() const { return maxBullets_; }
 	bool IsReloading() const { return isReloading_; }
 	float GetReloadTimer() const { return reloadTimer_; }
 	float GetReloadTime() const { return kReloadTime; }
-	// 弾リストの読み取り用アクセサ（GameScene から当たり判定に利用）
-	const std::list<Bullet*>& GetBullets() const { return bullets_; }
+	// 弾のアクセサ（GameScene から当たり判定に利用）
+	ProjectileSystem& GetProjectileSystem() { return projectiles_; }
+	const ProjectileSystem& GetProjectileSystem() const { return projectiles_; }
+	// 直近の描画で描いた弾の数
+	uint32_t GetDrawnBulletCount() const { return drawnBulletCount_; }
+	// ワイヤーの鎖の getter
+	const WireRenderer& GetWireChain() const { return wireChain_; }
 
 private:
 	/*---  ---*/
@@ -217,8 +220,29 @@ private:
 
 	/*-------------- プレイヤーの弾に関わる系 --------------*/
 
-	// 弾のリスト
-	std::list<Bullet*> bullets_;
+	// 弾（通常弾・ワイヤーのフックとセグメントをすべてここから出す）
+	ProjectileSystem projectiles_;
+
+	// 弾の容量（通常弾は寿命5秒で十数発、ワイヤーは射程25 / 間隔0.6 で40個程度）
+	static inline const uint32_t kProjectileCapacity = 256;
+
+	// 直近の描画で描いた弾の数
+	uint32_t drawnBulletCount_ = 0;
+
+	// モデルごとにまとめた描画する弾の行列
+	struct BulletBatch {
+		KamataEngine::Model* model = nullptr;
+		std::vector<KamataEngine::Matrix4x4> worldMatrices;
+	};
+
+	// 弾の描画の作業用（毎フレーム中身だけ空にして使い回す）
+	std::vector<BulletBatch> bulletBatches_;
+
+	// 弾のインスタンス描画
+	InstancedModelRenderer* bulletRenderer_ = nullptr;
+
+	// 弾の行列を書き込むフレームのリングバッファ
+	FrameRingBuffer* frameRing_ = nullptr;
 
 	// 弾モデル
 	KamataEngine::Model* bulletModel_ = nullptr;
@@ -275,10 +299,12 @@ private:
 	// プル（引っ張り）速度（既存メンバ）
 	float wirePullSpeed_ = 0.4f;
 
-	// ワイヤー用に作成した弾（フック＋等間隔で並べた弾）の管理
-	std::vector<Bullet*> wireBullets_;
-	// ワイヤー射出用の弾（飛翔するフック弾）へのポインタ（nullptr なら未発射）
-	Bullet* wireProjectile_ = nullptr;
+	// ワイヤー射出用の弾（飛翔するフック弾）のハンドル（無効なら未発射。弾が返された後はスロットが使い回されても無効のまま）
+	Bullet wireProjectile_;
+	// ワイヤーの鎖（フックが刺さったときにプレイヤーからフックまで等間隔に並べる）
+	WireRenderer wireChain_;
+	// 鎖の容量（射程いっぱいに、フックが射程判定の前に1フレーム進む分を足した長さ）
+	uint32_t GetWireChainCapacity() const { return static_cast<uint32_t>(std::ceil((wireMaxDistance_ + wireProjectileSpeed_) / wireSegmentSpacing_)) + 1; }
 	// ワイヤーを構成する等間隔の間隔（大きめに）
 	// 既定値は下の wireSegmentSpacing_ にコピーされる
 	static inline const float kWireSegmentSpacing = 0.9f;
@@ -288,7 +314,7 @@ private:
 
 	// 発射用フック弾のモデル（nullptr なら bulletModel_ を使う）
 	KamataEngine::Model* wireProjectileModel_ = nullptr;
-	// セグメント用弾のモデル（nullptr なら bulletModel_ を使う）
+	// 鎖のセグメントのモデル（nullptr なら bulletModel_ を使う）
 	KamataEngine::Model* wireSegmentModel_ = nullptr;
 	// 発射フック弾の速度（インスタンス上で制御可能）
 	float wireProjectileSpeed_ = wireSpeed_;
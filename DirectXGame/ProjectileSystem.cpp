@@ -0,0 +1,234 @@
+#include "ProjectileSystem.h"
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <emmintrin.h>
+
+using namespace KamataEngine;
+
+void ProjectileSystem::Initialize(uint32_t capacity) {
+
+	posX_.assign(capacity, 0.0f);
+	posY_.assign(capacity, 0.0f);
+	posZ_.assign(capacity, 0.0f);
+	velX_.assign(capacity, 0.0f);
+	velY_.assign(capacity, 0.0f);
+	velZ_.assign(capacity, 0.0f);
+	lifeTime_.assign(capacity, 0.0f);
+	lifeDecay_.assign(capacity, 0.0f);
+	flags_.assign(capacity, 0);
+
+	models_.assign(capacity, nullptr);
+	scales_.assign(capacity, kDefaultScale);
+	rotationCos_.assign(capacity, 1.0f);
+	rotationSin_.assign(capacity, 0.0f);
+	solid_.assign(capacity, 0);
+
+	slots_.Initialize(capacity);
+
+	stats_ = {};
+	stats_.capacity = capacity;
+}
+
+Bullet ProjectileSystem::Spawn(Model* model, const Vector3& position, const Vector3& direction) {
+
+	// NULLチェック
+	assert(model);
+
+	// 使用中の並びの末尾に置く
+	const SlotHandle handle = slots_.Allocate();
+	if (handle.generation == 0) {
+		++stats_.failedSpawnCount;
+		return {};
+	}
+	const uint32_t i = slots_.GetCount() - 1;
+
+	posX_[i] = position.x;
+	posY_[i] = position.y;
+	posZ_[i] = position.z;
+	velX_[i] = direction.x * kBulletSpeed;
+	velY_[i] = direction.y * kBulletSpeed;
+	velZ_[i] = direction.z * kBulletSpeed;
+	lifeTime_[i] = kLifeTime;
+	lifeDecay_[i] = kLifeDecay;
+	flags_[i] = 0;
+
+	models_[i] = model;
+	scales_[i] = kDefaultScale;
+	rotationCos_[i] = 1.0f;
+	rotationSin_[i] = 0.0f;
+	SetRotationFromDirection(i, direction);
+
+	++stats_.spawnCount;
+	stats_.activeCount = slots_.GetCount();
+	if (stats_.activeCount > stats_.peakActiveCount) {
+		stats_.peakActiveCount = stats_.activeCount;
+	}
+
+	return Bullet(this, handle);
+}
+
+void ProjectileSystem::Update() {
+
+	const uint32_t count = slots_.GetCount();
+
+	// ---- 移動と寿命（4発ずつ） ----
+	const __m128 zero = _mm_setzero_ps();
+	uint32_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_ps(&posX_[i], _mm_add_ps(_mm_loadu_ps(&posX_[i]), _mm_loadu_ps(&velX_[i])));
+		_mm_storeu_ps(&posY_[i], _mm_add_ps(_mm_loadu_ps(&posY_[i]), _mm_loadu_ps(&velY_[i])));
+		_mm_storeu_ps(&posZ_[i], _mm_add_ps(_mm_loadu_ps(&posZ_[i]), _mm_loadu_ps(&velZ_[i])));
+
+		// ワイヤー用は減る量が 0 なので寿命で消えない
+		const __m128 life = _mm_sub_ps(_mm_loadu_ps(&lifeTime_[i]), _mm_loadu_ps(&lifeDecay_[i]));
+		_mm_storeu_ps(&lifeTime_[i], life);
+
+		// 寿命が尽きた弾は4発の中でもまれなので、ビットが立っているものだけ書き込む
+		int expired = _mm_movemask_ps(_mm_cmple_ps(life, zero));
+		while (expired) {
+			const uint32_t lane = static_cast<uint32_t>(std::countr_zero(static_cast<uint32_t>(expired)));
+			flags_[i + lane] |= kDead;
+			expired &= expired - 1;
+		}
+	}
+
+	// 端数
+	for (; i < count; ++i) {
+		posX_[i] += velX_[i];
+		posY_[i] += velY_[i];
+		posZ_[i] += velZ_[i];
+		lifeTime_[i] -= lifeDecay_[i];
+		if (lifeTime_[i] <= 0.0f) {
+			flags_[i] |= kDead;
+		}
+	}
+
+	// ---- マップ壁との当たり（移動後の位置をまとめて問い合わせる） ----
+	stats_.tileTests = 0;
+	stats_.sweptTests = 0;
+	if (!mapChipField_ || count == 0) {
+		return;
+	}
+
+	mapChipField_->TestSolidPoints(posX_.data(), posY_.data(), count, solid_.data());
+	stats_.tileTests = count;
+
+	for (i = 0; i < count; ++i) {
+		if (flags_[i] & kSwept) {
+			// 移動前の位置から移動した線分を辿り、途中でブロックに入ったらその境界まで戻す
+			if (!Sweep(i)) {
+				continue;
+			}
+		} else if (!solid_[i]) {
+			continue;
+		}
+
+		if (flags_[i] & kPersistent) {
+			// ワイヤー弾：ブロックに刺さって停止する（以後描画は残す）
+			velX_[i] = 0.0f;
+			velY_[i] = 0.0f;
+			velZ_[i] = 0.0f;
+			flags_[i] |= kHooked;
+		} else {
+			// 通常弾は消える
+			flags_[i] |= kDead;
+		}
+	}
+}
+
+bool ProjectileSystem::Sweep(uint32_t i) {
+	// 止まっている弾（刺さったワイヤー弾など）は調べない
+	const float length = std::sqrt(velX_[i] * velX_[i] + velY_[i] * velY_[i]);
+	if (length <= 0.0f) {
+		return false;
+	}
+
+	++stats_.sweptTests;
+
+	const Vector3 velocity = {velX_[i], velY_[i], velZ_[i]};
+	const Vector3 previous = {posX_[i] - velocity.x, posY_[i] - velocity.y, posZ_[i] - velocity.z};
+
+	MapChipRaycastHit hit;
+	if (!mapChipField_->Raycast(previous, velocity, length, hit)) {
+		return false;
+	}
+
+	// 行き過ぎた位置ではなく、ブロックの境界で当たった位置に置く（Z は進んだ割合で補間する）
+	posX_[i] = hit.point.x;
+	posY_[i] = hit.point.y;
+	posZ_[i] = previous.z + velocity.z * (hit.distance / length);
+	return true;
+}
+
+void ProjectileSystem::Release(const SlotHandle& handle) {
+	const uint32_t i = slots_.Find(handle);
+	if (i == SlotMap::kInvalid) {
+		return;
+	}
+	ReleaseAt(i);
+}
+
+void ProjectileSystem::ReleaseAt(uint32_t i) {
+	// 末尾の弾を空いた位置に移して詰める
+	const uint32_t last = slots_.Release(i);
+	if (i != last) {
+		Move(last, i);
+	}
+
+	++stats_.releaseCount;
+	stats_.activeCount = slots_.GetCount();
+}
+
+void ProjectileSystem::ReleaseDead() {
+	// 後ろから見ていけば、詰めるときに移ってくるのは確認済みの弾だけになる
+	for (uint32_t i = slots_.GetCount(); i > 0; --i) {
+		if (flags_[i - 1] & kDead) {
+			ReleaseAt(i - 1);
+		}
+	}
+}
+
+void ProjectileSystem::ReleaseAll() {
+	while (slots_.GetCount() > 0) {
+		ReleaseAt(slots_.GetCount() - 1);
+	}
+}
+
+Matrix4x4 ProjectileSystem::MakeActiveWorldMatrix(uint32_t i) const {
+	// Math::MakeAffineMatrix(scale, {0, 0, z}, translate) と同じ行列
+	const Vector3& s = scales_[i];
+	const float c = rotationCos_[i];
+	const float sn = rotationSin_[i];
+	return {
+	    {{s.x * c, s.x * sn, 0.0f, 0.0f}, {-s.y * sn, s.y * c, 0.0f, 0.0f}, {0.0f, 0.0f, s.z, 0.0f}, {posX_[i], posY_[i], posZ_[i], 1.0f}}
+    };
+}
+
+void ProjectileSystem::Move(uint32_t from, uint32_t to) {
+	posX_[to] = posX_[from];
+	posY_[to] = posY_[from];
+	posZ_[to] = posZ_[from];
+	velX_[to] = velX_[from];
+	velY_[to] = velY_[from];
+	velZ_[to] = velZ_[from];
+	lifeTime_[to] = lifeTime_[from];
+	lifeDecay_[to] = lifeDecay_[from];
+	flags_[to] = flags_[from];
+	models_[to] = models_[from];
+	scales_[to] = scales_[from];
+	rotationCos_[to] = rotationCos_[from];
+	rotationSin_[to] = rotationSin_[from];
+}
+
+void ProjectileSystem::SetRotationFromDirection(uint32_t dense, const Vector3& direction) {
+	// ベクトル長がゼロに近い場合は処理しない（XY 成分が無い向きも atan2(0, 0) と同じく回さない）
+	const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+	if (length < 1e-6f) {
+		return;
+	}
+
+	// モデルが +X 方向を前方としている想定で Z 回転を設定（角度 atan2(y, x) の cos / sin は、XY 平面で正規化した x / y）
+	rotationCos_[dense] = direction.x / length;
+	rotationSin_[dense] = direction.y / length;
+}
@@ -0,0 +1,163 @@
+#pragma once
+#include "Bullet.h"
+#include "KamataEngine.h"
+#include "MapChipField.h"
+#include "SlotMap.h"
+#include <vector>
+
+/// <summary>
+/// 弾の中身をまとめて持つ（位置・速度・寿命・フラグは成分ごとの配列に並べる）
+/// 更新は SSE で4発ずつ進め、マップとの当たりは MapChipField にまとめて問い合わせる
+/// 速い弾は Bullet::SetSwept で、移動前から移動後までの線分をタイルに沿って辿るようにできる（すり抜けず、当たった位置で止まる）
+/// 外からは Bullet（スロット番号と世代だけを持つハンドル）で触る
+/// </summary>
+class ProjectileSystem {
+public:
+	// 状態のビット
+	enum Flag : uint8_t {
+		kDead = 1 << 0,       // 消滅
+		kPersistent = 1 << 1, // ワイヤー用（寿命で消えず、ブロックに刺さったら止まる）
+		kHooked = 1 << 2,     // ブロックに刺さって止まった
+		kSwept = 1 << 3,      // 移動した線分でマップとの当たりを調べる（終点だけでなく途中のタイルも見る）
+	};
+
+	// 使用状況
+	struct Stats {
+		uint32_t capacity = 0;         // 容量
+		uint32_t activeCount = 0;      // 使用中の弾の数
+		uint32_t peakActiveCount = 0;  // 使用中の弾の数の最大値
+		uint32_t spawnCount = 0;       // 出した回数（累計）
+		uint32_t releaseCount = 0;     // 返した回数（累計）
+		uint32_t failedSpawnCount = 0; // 空きが無くて出せなかった回数（累計）
+		uint32_t tileTests = 0;        // 直近の Update でマップに問い合わせた点の数
+		uint32_t sweptTests = 0;       // 直近の Update で線分を辿った弾の数
+	};
+
+	/// <summary>
+	/// 初期化（配列をすべて確保し、以前の弾はすべて捨てる）
+	/// </summary>
+	/// <param name="capacity">容量</param>
+	void Initialize(uint32_t capacity);
+
+	// マップチップフィールドの setter（nullptr ならマップとの当たりを調べない）
+	void SetMapChipField(const MapChipField* mapChipField) { mapChipField_ = mapChipField; }
+
+	/// <summary>
+	/// 弾を出す（O(1)）
+	/// </summary>
+	/// <param name="model">モデル</param>
+	/// <param name="position">位置</param>
+	/// <param name="direction">向き（長さ1。速さは kBulletSpeed）</param>
+	/// <returns>空きが無ければ無効なハンドル</returns>
+	Bullet Spawn(KamataEngine::Model* model, const KamataEngine::Vector3& position, const KamataEngine::Vector3& direction);
+
+	/// <summary>
+	/// 更新（移動・寿命・マップとの当たり）
+	/// </summary>
+	void Update();
+
+	/// <summary>
+	/// 弾を返す（O(1)。返した後のハンドルは無効になる。無効なハンドルなら何もしない）
+	/// </summary>
+	/// <param name="handle">弾のハンドル</param>
+	void Release(const SlotHandle& handle);
+
+	/// <summary>
+	/// 死んだ弾をまとめて返す（フレームの最後に呼ぶ）
+	/// </summary>
+	void ReleaseDead();
+
+	/// <summary>
+	/// すべての弾を返す
+	/// </summary>
+	void ReleaseAll();
+
+	// 使用中の弾の数の getter
+	uint32_t GetActiveCount() const { return slots_.GetCount(); }
+
+	// 使用中の i 番目（0～GetActiveCount()-1）の弾のハンドル（順番は返すたびに入れ替わる。走査中に Spawn / Release しないこと）
+	Bullet GetActive(uint32_t i) { return Bullet(this, slots_.GetHandle(i)); }
+
+	// 使用中の i 番目の弾の位置
+	KamataEngine::Vector3 GetActivePosition(uint32_t i) const { return {posX_[i], posY_[i], posZ_[i]}; }
+
+	// 使用中の i 番目の弾のモデル
+	KamataEngine::Model* GetActiveModel(uint32_t i) const { return models_[i]; }
+
+	// 使用中の i 番目の弾を描画するか
+	bool IsActiveVisible(uint32_t i) const { return !(flags_[i] & kDead); }
+
+	/// <summary>
+	/// 使用中の i 番目の弾のワールド行列を作る（回転は Z 軸だけなので、拡大縮小・回転・平行移動を直接並べる）
+	/// </summary>
+	KamataEngine::Matrix4x4 MakeActiveWorldMatrix(uint32_t i) const;
+
+	// 使用状況の getter
+	const Stats& GetStats() const { return stats_; }
+
+	// 弾の速さ
+	static inline const float kBulletSpeed = 0.6f;
+
+	// 寿命（秒）
+	static inline const float kLifeTime = 5.0f;
+
+	// 1フレームに減る寿命
+	static inline const float kLifeDecay = 1.0f / 60.0f;
+
+	// 出したときの大きさ
+	static inline const KamataEngine::Vector3 kDefaultScale = {0.2f, 0.2f, 0.2f};
+
+private:
+	friend class Bullet;
+
+	// ハンドルの使用中の並びでの位置（返された弾のハンドルなら SlotMap::kInvalid）
+	uint32_t Find(const SlotHandle& handle) const { return slots_.Find(handle); }
+
+	// 並びの位置 i の弾を返す
+	void ReleaseAt(uint32_t i);
+
+	/// <summary>
+	/// 並びの位置 i の弾が今回移動した線分とブロックとの当たり（当たったら位置を当たった所に戻す）
+	/// </summary>
+	/// <returns>当たったら true</returns>
+	bool Sweep(uint32_t i);
+
+	// 並びの位置 from の中身を to に移す（詰めるとき用）
+	void Move(uint32_t from, uint32_t to);
+
+	// 向きから Z 回転を決める
+	void SetRotationFromDirection(uint32_t dense, const KamataEngine::Vector3& direction);
+
+	/*-------------- 使用中の弾（先頭から GetActiveCount() 個を詰めて並べる） --------------*/
+
+	// 毎フレーム触るもの（成分ごとに並べて4発ずつ読み書きする）
+	std::vector<float> posX_;
+	std::vector<float> posY_;
+	std::vector<float> posZ_;
+	std::vector<float> velX_;
+	std::vector<float> velY_;
+	std::vector<float> velZ_;
+	std::vector<float> lifeTime_;
+	// 1フレームに減る寿命（ワイヤー用は 0 で、寿命で消えない）
+	std::vector<float> lifeDecay_;
+	std::vector<uint8_t> flags_;
+
+	// 描画のときだけ使うもの
+	std::vector<KamataEngine::Model*> models_;
+	std::vector<KamataEngine::Vector3> scales_;
+	// Z 回転の cos / sin（向きを正規化した x / y そのもの）
+	std::vector<float> rotationCos_;
+	std::vector<float> rotationSin_;
+
+	// マップとの当たりの結果（作業用）
+	std::vector<uint8_t> solid_;
+
+	// スロットと並びの位置の対応（世代付き）
+	SlotMap slots_;
+
+	// マップチップによるフィールド
+	const MapChipField* mapChipField_ = nullptr;
+
+	// 使用状況
+	Stats stats_;
+};
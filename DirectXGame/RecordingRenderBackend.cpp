@@ -0,0 +1,46 @@
+#include "RecordingRenderBackend.h"
+
+void RecordingRenderBackend::BeginPass(const RenderPipelineKey& pipelineKey) {
+	Command command;
+	command.type = Command::Type::kBeginPass;
+	command.pipelineKey = pipelineKey;
+	commands_.push_back(command);
+}
+
+void RecordingRenderBackend::EndPass() {
+	Command command;
+	command.type = Command::Type::kEndPass;
+	commands_.push_back(command);
+}
+
+void RecordingRenderBackend::BindRenderer(InstancedModelRenderer& renderer) {
+	Command command;
+	command.type = Command::Type::kBindRenderer;
+	command.renderer = &renderer;
+	commands_.push_back(command);
+}
+
+void RecordingRenderBackend::UnbindRenderer(InstancedModelRenderer& renderer) {
+	Command command;
+	command.type = Command::Type::kUnbindRenderer;
+	command.renderer = &renderer;
+	commands_.push_back(command);
+}
+
+void RecordingRenderBackend::Draw(const RenderPacket& packet) {
+	Command command;
+	command.type = Command::Type::kDraw;
+	command.renderer = packet.renderer;
+	command.packet = packet;
+	commands_.push_back(command);
+}
+
+uint32_t RecordingRenderBackend::CountCommands(Command::Type type) const {
+	uint32_t count = 0;
+	for (const Command& command : commands_) {
+		if (command.type == type) {
+			++count;
+		}
+	}
+	return count;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "RenderPacket.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 描画せずに、RenderQueue から来た命令を順番に記録するだけの実行先（並べ替えや切り替え回数の確認用）
+/// エンジンのヘッダーを読まないので、デバイスの無い環境のテストでも使える
+/// </summary>
+class RecordingRenderBackend : public RenderBackend {
+public:
+	// 記録した命令
+	struct Command {
+		enum class Type {
+			kBeginPass,
+			kEndPass,
+			kBindRenderer,
+			kUnbindRenderer,
+			kDraw,
+		};
+
+		Type type = Type::kDraw;
+
+		// kBeginPass のときのパイプライン
+		RenderPipelineKey pipelineKey;
+
+		// kBindRenderer / kUnbindRenderer のときのレンダラー
+		const InstancedModelRenderer* renderer = nullptr;
+
+		// kDraw のときの描画
+		RenderPacket packet;
+	};
+
+	// RenderBackend の各命令（描画はせずに記録する）
+	void BeginPass(const RenderPipelineKey& pipelineKey) override;
+
+	void EndPass() override;
+
+	void BindRenderer(InstancedModelRenderer& renderer) override;
+
+	void UnbindRenderer(InstancedModelRenderer& renderer) override;
+
+	void Draw(const RenderPacket& packet) override;
+
+	/// <summary>
+	/// 記録を消す
+	/// </summary>
+	void Clear() { commands_.clear(); }
+
+	// 記録した命令の getter
+	const std::vector<Command>& GetCommands() const { return commands_; }
+
+	/// <summary>
+	/// 種類ごとの命令の数
+	/// </summary>
+	uint32_t CountCommands(Command::Type type) const;
+
+private:
+	// 記録した命令
+	std::vector<Command> commands_;
+};
@@ -0,0 +1,105 @@
+#pragma once
+#include <cstdint>
+
+// 描画1回分の情報はポインタとアドレスだけで持ち、エンジンや D3D12 のヘッダーを読まずに扱えるようにする
+// （並べ替えと実行先の記録は、デバイスの無い環境のテストでも動かす）
+namespace KamataEngine {
+class Material;
+class Model;
+class WorldTransform;
+} // namespace KamataEngine
+
+class InstancedModelRenderer;
+class ModelInstanceBuffer;
+struct D3D12_VERTEX_BUFFER_VIEW;
+struct D3D12_INDEX_BUFFER_VIEW;
+
+// 描画の層（上の桁に入るので、値の小さい層から描く）
+enum class RenderLayer : uint32_t {
+	kOpaque = 0, // 不透明なもの
+	kSky = 1,    // スカイドーム（最後に描いて、手前のもので隠れた部分の描画を深度テストで省く）
+};
+
+// エンジンのパイプラインの組（ModelCommon::PipelineSetKey の各モードの値）
+struct RenderPipelineKey {
+	uint8_t cullingMode = 0;
+	uint8_t blendMode = 0;
+	uint8_t depthTestMode = 0;
+
+	bool operator==(const RenderPipelineKey& other) const = default;
+
+	// 並べ替えのキーに入れる 12 ビット（ModelCommon::PipelineSetKeyHash と同じ並び）
+	uint32_t GetBits() const { return static_cast<uint32_t>(cullingMode) | (static_cast<uint32_t>(blendMode) << 4) | (static_cast<uint32_t>(depthTestMode) << 8); }
+};
+
+/// <summary>
+/// 描画1回分の情報
+/// </summary>
+struct RenderPacket {
+	// 描画の種類
+	enum class Type {
+		kModel,            // Model::Draw
+		kInstanced,        // InstancedModelRenderer::Draw（行列は GPU アドレス）
+		kInstancedIndexed, // InstancedModelRenderer::DrawIndexed
+	};
+
+	// 並べ替えのキー
+	uint64_t key = 0;
+
+	// 積まれた順番（キーが同じときの並び）
+	uint32_t sequence = 0;
+
+	Type type = Type::kModel;
+
+	// エンジンのパイプライン（インスタンス描画では、パスを開くときに使う）
+	RenderPipelineKey pipelineKey;
+
+	// kModel
+	KamataEngine::Model* model = nullptr;
+	const KamataEngine::WorldTransform* worldTransform = nullptr;
+
+	// kInstanced / kInstancedIndexed
+	InstancedModelRenderer* renderer = nullptr;
+	uint64_t instances = 0; // 行列の GPU アドレス（D3D12_GPU_VIRTUAL_ADDRESS）
+	uint32_t instanceCount = 0;
+
+	// kInstancedIndexed（ビューは Execute まで書き換えないこと）
+	const D3D12_VERTEX_BUFFER_VIEW* vbView = nullptr;
+	const D3D12_INDEX_BUFFER_VIEW* ibView = nullptr;
+	uint32_t indexCount = 0;
+	KamataEngine::Material* material = nullptr;
+	const ModelInstanceBuffer* matrices = nullptr;
+};
+
+/// <summary>
+/// 描画の実行先（実際に描画するものと、テスト用に記録するものを差し替える）
+/// </summary>
+class RenderBackend {
+public:
+	virtual ~RenderBackend() = default;
+
+	/// <summary>
+	/// パスの開始（Model::PreDraw に当たる）
+	/// </summary>
+	virtual void BeginPass(const RenderPipelineKey& pipelineKey) = 0;
+
+	/// <summary>
+	/// パスの終了（Model::PostDraw に当たる）
+	/// </summary>
+	virtual void EndPass() = 0;
+
+	/// <summary>
+	/// インスタンス描画のパイプラインに切り替える
+	/// </summary>
+	virtual void BindRenderer(InstancedModelRenderer& renderer) = 0;
+
+	/// <summary>
+	/// インスタンス描画のパイプラインから離れる
+	/// </summary>
+	virtual void UnbindRenderer(InstancedModelRenderer& renderer) = 0;
+
+	/// <summary>
+	/// 描画
+	/// </summary>
+	virtual void Draw(const RenderPacket& packet) = 0;
+};
@@ -0,0 +1,94 @@
+#include "RenderPacketSorter.h"
+#include <algorithm>
+
+namespace {
+
+// 何もしない実行先（積まれた順に描いた場合の切り替え回数を数えるのに使う）
+class NullRenderBackend : public RenderBackend {
+public:
+	void BeginPass(const RenderPipelineKey&) override {}
+	void EndPass() override {}
+	void BindRenderer(InstancedModelRenderer&) override {}
+	void UnbindRenderer(InstancedModelRenderer&) override {}
+	void Draw(const RenderPacket&) override {}
+};
+
+} // namespace
+
+void RenderPacketSorter::Push(const RenderPacket& packet) {
+	packets_.push_back(packet);
+	packets_.back().sequence = static_cast<uint32_t>(packets_.size() - 1);
+}
+
+void RenderPacketSorter::Execute(RenderBackend& backend) {
+	stats_ = {};
+	stats_.packets = static_cast<uint32_t>(packets_.size());
+
+	// 並べ替える前の順で描いたときの切り替え回数（比較用）
+	NullRenderBackend nullBackend;
+	uint32_t unsortedPasses = 0;
+	Run(nullBackend, unsortedPasses, stats_.unsortedPipelineSwitches);
+
+	// キーで並べ替える（同じキーは積まれた順）
+	std::sort(packets_.begin(), packets_.end(), [](const RenderPacket& a, const RenderPacket& b) { return a.key != b.key ? a.key < b.key : a.sequence < b.sequence; });
+
+	Run(backend, stats_.passes, stats_.pipelineSwitches);
+}
+
+uint64_t RenderPacketSorter::MakeKey(RenderLayer layer, uint32_t rendererId, const RenderPipelineKey& pipelineKey, uint32_t materialId, uint32_t depth) {
+	const uint64_t pipelineBits = pipelineKey.GetBits() & 0xFFF;
+	return (static_cast<uint64_t>(layer) << kLayerShift) | (static_cast<uint64_t>(rendererId & 0xFF) << kRendererShift) | (pipelineBits << kPipelineShift) |
+	       (static_cast<uint64_t>(materialId & 0xFFFF) << kMaterialShift) | (depth & kDepthMask);
+}
+
+void RenderPacketSorter::Run(RenderBackend& backend, uint32_t& passes, uint32_t& pipelineSwitches) const {
+	bool passOpen = false;
+	RenderPipelineKey passKey;
+	InstancedModelRenderer* boundRenderer = nullptr;
+
+	for (const RenderPacket& packet : packets_) {
+		if (packet.type == RenderPacket::Type::kModel) {
+			// エンジンのパイプラインが違う、またはインスタンス描画のパイプラインに切り替えていたらパスを開き直す
+			if (!passOpen || boundRenderer || !(passKey == packet.pipelineKey)) {
+				if (boundRenderer) {
+					backend.UnbindRenderer(*boundRenderer);
+					boundRenderer = nullptr;
+				}
+				if (passOpen) {
+					backend.EndPass();
+				}
+				backend.BeginPass(packet.pipelineKey);
+				passOpen = true;
+				passKey = packet.pipelineKey;
+				++passes;
+				++pipelineSwitches;
+			}
+		} else {
+			// インスタンス描画はパイプラインを自分で持つので、開いているパスの種類は問わない
+			if (!passOpen) {
+				backend.BeginPass(packet.pipelineKey);
+				passOpen = true;
+				passKey = packet.pipelineKey;
+				++passes;
+				++pipelineSwitches;
+			}
+			if (boundRenderer != packet.renderer) {
+				if (boundRenderer) {
+					backend.UnbindRenderer(*boundRenderer);
+				}
+				backend.BindRenderer(*packet.renderer);
+				boundRenderer = packet.renderer;
+				++pipelineSwitches;
+			}
+		}
+
+		backend.Draw(packet);
+	}
+
+	if (boundRenderer) {
+		backend.UnbindRenderer(*boundRenderer);
+	}
+	if (passOpen) {
+		backend.EndPass();
+	}
+}
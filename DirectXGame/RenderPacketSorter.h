@@ -0,0 +1,62 @@
+#pragma once
+#include "RenderPacket.h"
+#include <vector>
+
+/// <summary>
+/// 積まれた描画をキーで並べ替えて実行先に流す（エンジンに依存しない部分）
+/// パイプラインが変わるところでだけパスの開き直しやパイプラインの切り替えを行う
+/// </summary>
+class RenderPacketSorter {
+public:
+	// キーの並び（上位から 層4 / レンダラー8 / パイプライン12 / マテリアル16 / 深度24 ビット）
+	static inline const uint32_t kLayerShift = 60;
+	static inline const uint32_t kRendererShift = 52;
+	static inline const uint32_t kPipelineShift = 40;
+	static inline const uint32_t kMaterialShift = 24;
+	static inline const uint64_t kDepthMask = (uint64_t(1) << kMaterialShift) - 1;
+
+	// 直近の Execute の統計
+	struct Stats {
+		uint32_t packets = 0;                  // 積まれた描画の数
+		uint32_t passes = 0;                   // PreDraw/PostDraw の組の数
+		uint32_t pipelineSwitches = 0;         // パイプラインを切り替えた回数（パスの開始も含む）
+		uint32_t unsortedPipelineSwitches = 0; // 積まれた順に描いていたら必要だった切り替えの回数
+	};
+
+	/// <summary>
+	/// 積んだ描画を捨てる
+	/// </summary>
+	void Clear() { packets_.clear(); }
+
+	/// <summary>
+	/// 描画を積む（key は MakeKey で作っておく。sequence はここで振る）
+	/// </summary>
+	void Push(const RenderPacket& packet);
+
+	/// <summary>
+	/// 並べ替えて実行する
+	/// </summary>
+	/// <param name="backend">実行先</param>
+	void Execute(RenderBackend& backend);
+
+	// 積まれた描画の getter（Execute の後は並べ替え済み）
+	const std::vector<RenderPacket>& GetPackets() const { return packets_; }
+
+	// 統計の getter
+	const Stats& GetStats() const { return stats_; }
+
+	/// <summary>
+	/// キーを作る
+	/// </summary>
+	static uint64_t MakeKey(RenderLayer layer, uint32_t rendererId, const RenderPipelineKey& pipelineKey, uint32_t materialId, uint32_t depth);
+
+private:
+	// 描画を実行先に流す（パスと切り替えの回数を数える）
+	void Run(RenderBackend& backend, uint32_t& passes, uint32_t& pipelineSwitches) const;
+
+	// 積まれた描画
+	std::vector<RenderPacket> packets_;
+
+	// 統計
+	Stats stats_;
+};
@@ -0,0 +1,112 @@
+#define NOMINMAX
+#include "RenderQueue.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace KamataEngine;
+
+void RenderQueue::Begin(const Camera& camera) {
+	camera_ = &camera;
+	sorter_.Clear();
+}
+
+void RenderQueue::SubmitModel(Model& model, const WorldTransform& worldTransform, RenderLayer layer, const ModelCommon::PipelineSetKey& pipelineKey) {
+	RenderPacket packet;
+	packet.type = RenderPacket::Type::kModel;
+	packet.pipelineKey = ToRenderPipelineKey(pipelineKey);
+	packet.model = &model;
+	packet.worldTransform = &worldTransform;
+
+	// 位置はワールド行列の平行移動成分
+	const Matrix4x4& m = worldTransform.matWorld_;
+	Push(packet, layer, 0, &model, {m.m[3][0], m.m[3][1], m.m[3][2]});
+}
+
+void RenderQueue::SubmitInstanced(InstancedModelRenderer& renderer, Model& model, D3D12_GPU_VIRTUAL_ADDRESS instances, uint32_t instanceCount, const Vector3& center) {
+	if (instanceCount == 0) {
+		return;
+	}
+
+	RenderPacket packet;
+	packet.type = RenderPacket::Type::kInstanced;
+	packet.pipelineKey = ToRenderPipelineKey(kOpaquePipelineKey);
+	packet.model = &model;
+	packet.renderer = &renderer;
+	packet.instances = instances;
+	packet.instanceCount = instanceCount;
+	Push(packet, RenderLayer::kOpaque, GetRendererId(&renderer), &model, center);
+}
+
+void RenderQueue::SubmitInstancedIndexed(
+    InstancedModelRenderer& renderer, const D3D12_VERTEX_BUFFER_VIEW& vbView, const D3D12_INDEX_BUFFER_VIEW& ibView, uint32_t indexCount, Material& material,
+    const ModelInstanceBuffer& matrices, uint32_t instanceCount, const Vector3& center) {
+	if (indexCount == 0 || instanceCount == 0) {
+		return;
+	}
+
+	RenderPacket packet;
+	packet.type = RenderPacket::Type::kInstancedIndexed;
+	packet.pipelineKey = ToRenderPipelineKey(kOpaquePipelineKey);
+	packet.renderer = &renderer;
+	packet.instanceCount = instanceCount;
+	packet.vbView = &vbView;
+	packet.ibView = &ibView;
+	packet.indexCount = indexCount;
+	packet.material = &material;
+	packet.matrices = &matrices;
+	Push(packet, RenderLayer::kOpaque, GetRendererId(&renderer), &material, center);
+}
+
+void RenderQueue::Execute(RenderBackend& backend) {
+	assert(camera_);
+	sorter_.Execute(backend);
+}
+
+RenderPipelineKey RenderQueue::ToRenderPipelineKey(const ModelCommon::PipelineSetKey& pipelineKey) {
+	return {static_cast<uint8_t>(pipelineKey.cullingMode), static_cast<uint8_t>(pipelineKey.blendMode), static_cast<uint8_t>(pipelineKey.depthTestMode)};
+}
+
+ModelCommon::PipelineSetKey RenderQueue::ToPipelineSetKey(const RenderPipelineKey& pipelineKey) {
+	ModelCommon::PipelineSetKey result;
+	result.cullingMode = static_cast<ModelCommon::CullingMode>(pipelineKey.cullingMode);
+	result.blendMode = static_cast<ModelCommon::BlendMode>(pipelineKey.blendMode);
+	result.depthTestMode = static_cast<ModelCommon::DepthTestMode>(pipelineKey.depthTestMode);
+	return result;
+}
+
+void RenderQueue::Push(RenderPacket& packet, RenderLayer layer, uint32_t rendererId, const void* material, const Vector3& position) {
+	packet.key = RenderPacketSorter::MakeKey(layer, rendererId, packet.pipelineKey, GetMaterialId(material), QuantizeDepth(position));
+	sorter_.Push(packet);
+}
+
+uint32_t RenderQueue::GetMaterialId(const void* material) {
+	auto it = materialIds_.find(material);
+	if (it != materialIds_.end()) {
+		return it->second;
+	}
+
+	const uint32_t id = static_cast<uint32_t>(materialIds_.size());
+	materialIds_.emplace(material, id);
+	return id;
+}
+
+uint32_t RenderQueue::GetRendererId(const InstancedModelRenderer* renderer) {
+	auto it = std::find(renderers_.begin(), renderers_.end(), renderer);
+	if (it == renderers_.end()) {
+		renderers_.push_back(renderer);
+		it = renderers_.end() - 1;
+	}
+	return static_cast<uint32_t>(it - renderers_.begin()) + 1;
+}
+
+uint32_t RenderQueue::QuantizeDepth(const Vector3& position) {
+	if (!camera_) {
+		return 0;
+	}
+
+	// ビュー空間の z（手前ほど小さい）を 0～1 にして量子化する。同じパイプライン・マテリアルの中では手前から描く
+	const Matrix4x4& view = camera_->matView;
+	const float viewZ = position.x * view.m[0][2] + position.y * view.m[1][2] + position.z * view.m[2][2] + view.m[3][2];
+	const float t = std::clamp(viewZ / camera_->farZ, 0.0f, 1.0f);
+	return static_cast<uint32_t>(t * static_cast<float>(RenderPacketSorter::kDepthMask));
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include "InstancedModelRenderer.h"
+#include "KamataEngine.h"
+#include "RenderPacketSorter.h"
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// 描画を積んで、フレームに1回キーで並べ替えてから実行する
+/// エンジンのオブジェクトから描画の情報とキーを作り、並べ替えと実行は RenderPacketSorter に任せる
+/// </summary>
+class RenderQueue {
+public:
+	// 直近の Execute の統計
+	using Stats = RenderPacketSorter::Stats;
+
+	/// <summary>
+	/// フレームの始め（積んだ描画を捨てて、深度の計算に使うカメラを決める）
+	/// </summary>
+	/// <param name="camera">カメラ</param>
+	void Begin(const KamataEngine::Camera& camera);
+
+	/// <summary>
+	/// モデルの描画を積む
+	/// </summary>
+	/// <param name="model">モデル</param>
+	/// <param name="worldTransform">ワールド変換（Execute まで行列を書き換えないこと）</param>
+	/// <param name="layer">層</param>
+	/// <param name="pipelineKey">エンジンのパイプライン</param>
+	void SubmitModel(
+	    KamataEngine::Model& model, const KamataEngine::WorldTransform& worldTransform, RenderLayer layer = RenderLayer::kOpaque,
+	    const KamataEngine::ModelCommon::PipelineSetKey& pipelineKey = kOpaquePipelineKey);
+
+	/// <summary>
+	/// インスタンス描画を積む（行列は GPU アドレスで渡す）
+	/// </summary>
+	/// <param name="renderer">レンダラー</param>
+	/// <param name="model">モデル</param>
+	/// <param name="instances">インスタンスごとのワールド行列の GPU アドレス</param>
+	/// <param name="instanceCount">インスタンス数</param>
+	/// <param name="center">深度の計算に使う位置</param>
+	void SubmitInstanced(
+	    InstancedModelRenderer& renderer, KamataEngine::Model& model, D3D12_GPU_VIRTUAL_ADDRESS instances, uint32_t instanceCount, const KamataEngine::Vector3& center);
+
+	/// <summary>
+	/// 頂点・インデックスバッファを直接指定したインスタンス描画を積む
+	/// </summary>
+	/// <param name="renderer">レンダラー</param>
+	/// <param name="vbView">頂点バッファ（参照で積むので、Execute まで書き換えないこと）</param>
+	/// <param name="ibView">インデックスバッファ（同上）</param>
+	/// <param name="indexCount">インデックス数</param>
+	/// <param name="material">マテリアル</param>
+	/// <param name="matrices">シェーダーに渡す行列の配列</param>
+	/// <param name="instanceCount">インスタンス数</param>
+	/// <param name="center">深度の計算に使う位置</param>
+	void SubmitInstancedIndexed(
+	    InstancedModelRenderer& renderer, const D3D12_VERTEX_BUFFER_VIEW& vbView, const D3D12_INDEX_BUFFER_VIEW& ibView, uint32_t indexCount, KamataEngine::Material& material,
+	    const ModelInstanceBuffer& matrices, uint32_t instanceCount, const KamataEngine::Vector3& center);
+
+	/// <summary>
+	/// 並べ替えて実行する
+	/// </summary>
+	/// <param name="backend">実行先</param>
+	void Execute(RenderBackend& backend);
+
+	// 積まれた描画の getter（Execute の後は並べ替え済み）
+	const std::vector<RenderPacket>& GetPackets() const { return sorter_.GetPackets(); }
+
+	// 統計の getter
+	const Stats& GetStats() const { return sorter_.GetStats(); }
+
+	/// <summary>
+	/// エンジンのパイプラインの組を描画の情報に入れる形にする
+	/// </summary>
+	static RenderPipelineKey ToRenderPipelineKey(const KamataEngine::ModelCommon::PipelineSetKey& pipelineKey);
+
+	/// <summary>
+	/// 描画の情報のパイプラインの組をエンジンの形に戻す
+	/// </summary>
+	static KamataEngine::ModelCommon::PipelineSetKey ToPipelineSetKey(const RenderPipelineKey& pipelineKey);
+
+	// 不透明なものを描くパイプライン（バックカリング・ブレンドなし・深度テストあり）
+	static inline const KamataEngine::ModelCommon::PipelineSetKey kOpaquePipelineKey = {
+	    KamataEngine::ModelCommon::CullingMode::kBack, KamataEngine::ModelCommon::BlendMode::kNone, KamataEngine::ModelCommon::DepthTestMode::kOn};
+
+private:
+	// 描画を積む
+	void Push(RenderPacket& packet, RenderLayer layer, uint32_t rendererId, const void* material, const KamataEngine::Vector3& position);
+
+	// マテリアル（モデル）の番号
+	uint32_t GetMaterialId(const void* material);
+
+	// レンダラーの番号（0 はエンジンの Model::Draw）
+	uint32_t GetRendererId(const InstancedModelRenderer* renderer);
+
+	// 位置をカメラからの距離で量子化する
+	uint32_t QuantizeDepth(const KamataEngine::Vector3& position);
+
+	// 深度の計算に使うカメラ
+	const KamataEngine::Camera* camera_ = nullptr;
+
+	// 積まれた描画の並べ替えと実行
+	RenderPacketSorter sorter_;
+
+	// マテリアルの番号（最初に積まれた順に振る）
+	std::unordered_map<const void*, uint32_t> materialIds_;
+
+	// レンダラーの番号（最初に積まれた順に 1 から振る）
+	std::vector<const InstancedModelRenderer*> renderers_;
+};
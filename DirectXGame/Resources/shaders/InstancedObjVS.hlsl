@@ -0,0 +1,26 @@
+#include "Obj.hlsli"
+
+// インスタンスごとのデータ
+struct InstanceData {
+	row_major matrix world;
+};
+
+StructuredBuffer<InstanceData> gInstances : register(t1);
+
+VSOutput main(float4 pos : POSITION, float3 normal : NORMAL, float2 uv : TEXCOORD, uint instanceId : SV_InstanceID) {
+	matrix instanceWorld = gInstances[instanceId].world;
+
+	// 法線にワールド行列によるスケーリング・回転を適用
+	// ※スケーリングが一様な場合のみ正しい
+	float4 worldNormal = normalize(mul(float4(normal, 0), instanceWorld));
+	float4 worldPos = mul(pos, instanceWorld);
+
+	VSOutput output; // ピクセルシェーダーに渡す値
+	output.svpos = mul(worldPos, mul(view, projection));
+
+	output.worldpos = worldPos;
+	output.normal = worldNormal.xyz;
+	output.uv = uv;
+
+	return output;
+}
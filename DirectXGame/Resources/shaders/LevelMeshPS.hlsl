@@ -0,0 +1,45 @@
+#include "ObjShading.hlsli"
+
+// 面ごとの「ブロック内の座標 → UV」の変換（+X, -X, +Y, -Y, +Z, -Z の順）
+struct FaceUV {
+	row_major matrix transform;
+};
+
+StructuredBuffer<FaceUV> gFaceUVs : register(t1);
+
+Texture2D<float4> tex : register(t0); // 0番スロットに設定されたテクスチャ
+SamplerState smp : register(s0);      // 0番スロットに設定されたサンプラー
+
+// ブロックの大きさ（MapChipField::kBlockWidth / kBlockHeight と同じ）
+static const float kBlockSize = 2.0f;
+
+// 法線から面の番号を求める
+uint FaceIndex(float3 normal) {
+	float3 a = abs(normal);
+	if (a.x >= a.y && a.x >= a.z) {
+		return normal.x > 0 ? 0 : 1;
+	}
+	if (a.y >= a.z) {
+		return normal.y > 0 ? 2 : 3;
+	}
+	return normal.z > 0 ? 4 : 5;
+}
+
+float4 main(VSOutput input) : SV_TARGET {
+	// まとめた面でもブロック1つ分ずつ元のモデルと同じテクスチャが貼られるように、
+	// ピクセルのブロック内の座標から UV を求める（面に垂直な軸は変換行列で使われない）
+	matrix faceUV = gFaceUVs[FaceIndex(input.normal)].transform;
+	float3 local = input.worldpos.xyz - kBlockSize * round(input.worldpos.xyz / kBlockSize);
+	float2 uv = mul(float4(local, 1), faceUV).xy;
+
+	// ブロックの境目で UV が飛んでもミップが乱れないように、飛ばない座標の微分を使う
+	float2 uvDdx = mul(float4(ddx(input.worldpos.xyz), 0), faceUV).xy;
+	float2 uvDdy = mul(float4(ddy(input.worldpos.xyz), 0), faceUV).xy;
+
+	// UV変換
+	uv = uv * m_uv_scale.xy + m_uv_offset.xy;
+	// テクスチャマッピング
+	float4 texcolor = tex.SampleGrad(smp, uv, uvDdx * m_uv_scale.xy, uvDdy * m_uv_scale.xy);
+
+	return Shade(input, texcolor);
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#include "Obj.hlsli"
+
+// マップのメッシュは頂点をワールド座標で持っているので、ワールド行列は掛けない
+VSOutput main(float4 pos : POSITION, float3 normal : NORMAL, float2 uv : TEXCOORD) {
+	VSOutput output; // ピクセルシェーダーに渡す値
+	output.svpos = mul(pos, mul(view, projection));
+
+	output.worldpos = pos;
+	output.normal = normal;
+	output.uv = uv;
+
+	return output;
+}
\ No newline at end of file
@@ -38,4 +38,10 @@ void Skydome::Draw() {
 
 	// 3Dモデルの後処理
 	Model::PostDraw();
+}
+
+void Skydome::Draw(RenderQueue& queue) {
+
+	// 他のものをすべて描いた後に描き、隠れている部分は深度テストで省く
+	queue.SubmitModel(*model_, worldTransformSkydome_, RenderLayer::kSky);
 }
\ No newline at end of file
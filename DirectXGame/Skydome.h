@@ -1,6 +1,7 @@
 #pragma once
 #include "Math.h"
 #include "KamataEngine.h"
+#include "RenderQueue.h"
 
 class Skydome {
 public:
@@ -19,6 +20,15 @@ public:
 	/// </summary>
 	void Draw();
 
+	/// <summary>
+	/// スカイドームの描画（描画キューの最後の層に積む）
+	/// </summary>
+	/// <param name="queue">描画キュー</param>
+	void Draw(RenderQueue& queue);
+
+	// ワールド変換データの getter
+	KamataEngine::WorldTransform& GetWorldTransform() { return worldTransformSkydome_; }
+
 private:
 	// ワールド変換データ
 	KamataEngine::WorldTransform worldTransformSkydome_;
@@ -0,0 +1,78 @@
+#include "SlotMap.h"
+#include <cassert>
+#include <cstddef>
+
+void SlotMap::Initialize(uint32_t capacity) {
+
+	// 以前に配ったハンドルが一致しないように、世代は引き継いで進める
+	const size_t oldSize = slots_.size();
+	slots_.resize(capacity);
+	for (size_t i = 0; i < slots_.size(); ++i) {
+		Slot& slot = slots_[i];
+		slot.dense = kInvalid;
+		if (i < oldSize) {
+			slot.generation = (slot.generation + 1 == 0) ? 1 : slot.generation + 1;
+		}
+	}
+
+	denseToSlot_.assign(capacity, 0);
+
+	// 若い番号から取り出されるように、末尾に小さい番号を置く
+	freeSlots_.clear();
+	freeSlots_.reserve(capacity);
+	for (uint32_t i = capacity; i > 0; --i) {
+		freeSlots_.push_back(i - 1);
+	}
+
+	count_ = 0;
+}
+
+SlotHandle SlotMap::Allocate() {
+
+	if (freeSlots_.empty()) {
+		return {};
+	}
+
+	const uint32_t index = freeSlots_.back();
+	freeSlots_.pop_back();
+
+	const uint32_t dense = count_++;
+	denseToSlot_[dense] = index;
+	slots_[index].dense = dense;
+
+	return {index, slots_[index].generation};
+}
+
+uint32_t SlotMap::Release(uint32_t dense) {
+	assert(dense < count_);
+
+	const uint32_t index = denseToSlot_[dense];
+	const uint32_t last = --count_;
+
+	// 末尾のスロットを空いた位置に移して詰める
+	if (dense != last) {
+		const uint32_t moved = denseToSlot_[last];
+		denseToSlot_[dense] = moved;
+		slots_[moved].dense = dense;
+	}
+
+	// 世代を進めて、配ったハンドルを無効にする（0 は無効なハンドル用に飛ばす）
+	Slot& slot = slots_[index];
+	slot.dense = kInvalid;
+	slot.generation = (slot.generation + 1 == 0) ? 1 : slot.generation + 1;
+
+	freeSlots_.push_back(index);
+
+	return last;
+}
+
+void SlotMap::Swap(uint32_t a, uint32_t b) {
+	assert(a < count_ && b < count_);
+
+	const uint32_t indexA = denseToSlot_[a];
+	const uint32_t indexB = denseToSlot_[b];
+	denseToSlot_[a] = indexB;
+	denseToSlot_[b] = indexA;
+	slots_[indexA].dense = b;
+	slots_[indexB].dense = a;
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// スロット番号と世代の組（世代 0 はどのスロットにも一致しない）
+struct SlotHandle {
+	uint32_t index = 0;
+	uint32_t generation = 0;
+
+	bool operator==(const SlotHandle& other) const = default;
+};
+
+/// <summary>
+/// 世代付きのスロットの割り当て（中身は持たず、スロットと詰めて並べた位置の対応だけを管理する）
+/// スロットは返すたびに世代を進めるので、返した後のハンドルは同じスロットが使い回されても O(1) で無効と分かる
+/// 呼び出し側は成分ごとの配列を並びの位置で持ち、Release で返された位置から中身を移して詰める
+/// </summary>
+class SlotMap {
+public:
+	// 使っていないことを表す並びの位置
+	static inline const uint32_t kInvalid = UINT32_MAX;
+
+	/// <summary>
+	/// 初期化（以前のハンドルはすべて無効になる）
+	/// </summary>
+	/// <param name="capacity">容量</param>
+	void Initialize(uint32_t capacity);
+
+	/// <summary>
+	/// スロットを割り当てて、並びの末尾（GetCount() - 1）に置く（O(1)）
+	/// </summary>
+	/// <returns>空きが無ければ世代 0 のハンドル</returns>
+	SlotHandle Allocate();
+
+	/// <summary>
+	/// 並びの位置 dense のスロットを返す（O(1)）
+	/// 末尾のスロットが dense に移るので、呼び出し側は戻り値の位置から dense に中身を移すこと（同じ位置なら移さない）
+	/// </summary>
+	/// <param name="dense">並びの位置</param>
+	/// <returns>dense に移ってきた元の位置（返す前の末尾）</returns>
+	uint32_t Release(uint32_t dense);
+
+	/// <summary>
+	/// 並びの位置 a と b のスロットを入れ替える（ハンドルはそのまま。呼び出し側も中身を入れ替えること）
+	/// </summary>
+	void Swap(uint32_t a, uint32_t b);
+
+	// ハンドルの並びの位置（返されたスロット、別の世代のハンドルなら kInvalid）
+	uint32_t Find(const SlotHandle& handle) const {
+		if (handle.index >= slots_.size()) {
+			return kInvalid;
+		}
+		const Slot& slot = slots_[handle.index];
+		return (slot.generation == handle.generation) ? slot.dense : kInvalid;
+	}
+
+	// 並びの位置 dense のハンドル
+	SlotHandle GetHandle(uint32_t dense) const {
+		const uint32_t index = denseToSlot_[dense];
+		return {index, slots_[index].generation};
+	}
+
+	// 使用中のスロットの数
+	uint32_t GetCount() const { return count_; }
+
+	// 容量
+	uint32_t GetCapacity() const { return static_cast<uint32_t>(slots_.size()); }
+
+private:
+	// スロットの状態（使っていなければ dense は kInvalid）
+	struct Slot {
+		uint32_t dense = kInvalid;
+		uint32_t generation = 1;
+	};
+
+	std::vector<Slot> slots_;
+
+	// 並びの位置からスロット番号
+	std::vector<uint32_t> denseToSlot_;
+
+	// 空きスロットの番号（末尾から取り出す）
+	std::vector<uint32_t> freeSlots_;
+
+	// 使用中のスロットの数
+	uint32_t count_ = 0;
+};
@@ -0,0 +1,78 @@
+#include "SpatialHashGrid.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+void SpatialHashGrid::Initialize(float cellSize, uint32_t bucketCount) {
+	assert(cellSize > 0.0f);
+	assert(bucketCount > 0);
+
+	invCellSize_ = 1.0f / cellSize;
+
+	// 箱の番号をマスクで求められるように 2 のべき乗にする
+	bucketCount = std::bit_ceil(bucketCount);
+	bucketMask_ = bucketCount - 1;
+	bucketStart_.assign(bucketCount + 1, 0);
+
+	Clear();
+}
+
+void SpatialHashGrid::Clear() {
+	objects_.clear();
+	entries_.clear();
+	sortedObjects_.clear();
+	std::fill(bucketStart_.begin(), bucketStart_.end(), 0);
+	stats_ = {};
+}
+
+void SpatialHashGrid::Insert(uint32_t id, const AABB& box) {
+	const uint32_t index = static_cast<uint32_t>(objects_.size());
+	objects_.push_back({id, box});
+
+	const int32_t cellX0 = GetCell(box.min.x);
+	const int32_t cellX1 = GetCell(box.max.x);
+	const int32_t cellY0 = GetCell(box.min.y);
+	const int32_t cellY1 = GetCell(box.max.y);
+
+	// 重なるセルすべてに登録する（別のセルが同じ箱に入るときは1回だけ）
+	const size_t first = entries_.size();
+	for (int32_t cellY = cellY0; cellY <= cellY1; ++cellY) {
+		for (int32_t cellX = cellX0; cellX <= cellX1; ++cellX) {
+			const uint32_t bucket = GetBucket(cellX, cellY);
+
+			bool found = false;
+			for (size_t i = first; i < entries_.size(); ++i) {
+				if (entries_[i].first == bucket) {
+					found = true;
+					break;
+				}
+			}
+			if (!found) {
+				entries_.emplace_back(bucket, index);
+			}
+		}
+	}
+}
+
+void SpatialHashGrid::Build() {
+
+	// 箱ごとの数を数えて、開始位置にする
+	std::fill(bucketStart_.begin(), bucketStart_.end(), 0);
+	for (const auto& entry : entries_) {
+		++bucketStart_[entry.first + 1];
+	}
+	for (size_t i = 1; i < bucketStart_.size(); ++i) {
+		bucketStart_[i] += bucketStart_[i - 1];
+	}
+
+	// 箱の順に並べる（同じ箱の中は登録順）
+	sortedObjects_.resize(entries_.size());
+	cursor_.assign(bucketStart_.begin(), bucketStart_.end() - 1);
+	for (const auto& entry : entries_) {
+		sortedObjects_[cursor_[entry.first]++] = entry.second;
+	}
+
+	stats_ = {};
+	stats_.objects = static_cast<uint32_t>(objects_.size());
+	stats_.cellEntries = static_cast<uint32_t>(entries_.size());
+}
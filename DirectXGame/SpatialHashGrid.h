@@ -0,0 +1,109 @@
+#pragma once
+#include "Math.h"
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// 当たり判定の候補を絞るための空間ハッシュ（セルはマップのタイルと同じ並び）
+/// フレームごとに Clear → Insert → Build で作り直し、点が入っているセルに重なる AABB だけを返す
+/// AABB は重なるセルすべてに登録するので、点の問い合わせは1セルを見るだけで済む
+/// </summary>
+class SpatialHashGrid {
+public:
+	// 直近の Build 以降の統計
+	struct Stats {
+		uint32_t objects = 0;     // 登録した AABB の数
+		uint32_t cellEntries = 0; // セルへの登録数（1つの AABB が複数セルに入る）
+		uint32_t queries = 0;     // 問い合わせの回数
+		uint32_t candidates = 0;  // 問い合わせで返した候補の数（= 細かい判定の回数）
+	};
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="cellSize">セルの大きさ（タイルの大きさ）</param>
+	/// <param name="bucketCount">ハッシュの箱の数（2 のべき乗に切り上げる）</param>
+	void Initialize(float cellSize, uint32_t bucketCount);
+
+	/// <summary>
+	/// 登録をすべて消す
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// AABB を登録する（Build までは問い合わせに出てこない）
+	/// </summary>
+	/// <param name="id">呼び出し側の番号</param>
+	/// <param name="box">AABB（XY 平面で見る）</param>
+	void Insert(uint32_t id, const AABB& box);
+
+	/// <summary>
+	/// 登録を箱ごとに並べ直す（O(登録数 + 箱の数)）
+	/// </summary>
+	void Build();
+
+	/// <summary>
+	/// 点が入っているセルに重なる AABB を列挙する（ハッシュの衝突で別のセルのものも混ざるので、呼び出し側で AABB と点を比べること）
+	/// </summary>
+	/// <param name="point">点</param>
+	/// <param name="func">func(id, box)。false を返すと列挙をやめる</param>
+	template <typename Func> void QueryPoint(const KamataEngine::Vector3& point, Func&& func) {
+		++stats_.queries;
+		if (bucketStart_.empty()) {
+			return;
+		}
+
+		const uint32_t bucket = GetBucket(GetCell(point.x), GetCell(point.y));
+		for (uint32_t i = bucketStart_[bucket]; i < bucketStart_[bucket + 1]; ++i) {
+			const Object& object = objects_[sortedObjects_[i]];
+			++stats_.candidates;
+			if (!func(object.id, object.box)) {
+				return;
+			}
+		}
+	}
+
+	// 統計の getter
+	const Stats& GetStats() const { return stats_; }
+
+private:
+	// 登録した AABB
+	struct Object {
+		uint32_t id;
+		AABB box;
+	};
+
+	// 座標からセル番号（タイルの中心がセルの中心になるようにずらす）
+	int32_t GetCell(float v) const { return static_cast<int32_t>(std::floor(v * invCellSize_ + 0.5f)); }
+
+	// セルの箱
+	uint32_t GetBucket(int32_t cellX, int32_t cellY) const {
+		return ((static_cast<uint32_t>(cellX) * 73856093u) ^ (static_cast<uint32_t>(cellY) * 19349663u)) & bucketMask_;
+	}
+
+	// セルの大きさの逆数
+	float invCellSize_ = 1.0f;
+
+	// 箱の数 - 1
+	uint32_t bucketMask_ = 0;
+
+	// 登録した AABB
+	std::vector<Object> objects_;
+
+	// セルへの登録（箱, objects_ の番号）。Build で箱ごとに並べる
+	std::vector<std::pair<uint32_t, uint32_t>> entries_;
+
+	// 箱ごとの sortedObjects_ の開始位置（箱の数 + 1 個）
+	std::vector<uint32_t> bucketStart_;
+
+	// 箱の順に並べた objects_ の番号
+	std::vector<uint32_t> sortedObjects_;
+
+	// Build の作業用（箱ごとの書き込み位置）
+	std::vector<uint32_t> cursor_;
+
+	// 統計
+	Stats stats_;
+};
@@ -0,0 +1,17 @@
+#pragma once
+// テキストのデータファイル（マップの CSV、敵の種類の表など）を読むときの小さな関数
+#include <string_view>
+
+// 空白文字か（std::isspace と違いロケールを参照しない）
+inline bool IsSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f'; }
+
+// 前後の改行やスペース、CR を取り除く簡易トリム（文字列はコピーせずビューを縮めるだけ）
+inline std::string_view TrimToken(std::string_view s) {
+	while (!s.empty() && IsSpace(s.back())) {
+		s.remove_suffix(1);
+	}
+	while (!s.empty() && IsSpace(s.front())) {
+		s.remove_prefix(1);
+	}
+	return s;
+}
@@ -0,0 +1,92 @@
+#include "WireRenderer.h"
+#include <cassert>
+#include <cmath>
+
+using namespace KamataEngine;
+
+void WireRenderer::Initialize(uint32_t capacity) {
+	assert(capacity > 0);
+
+	segments_.assign(capacity, Vector3{0.0f, 0.0f, 0.0f});
+	matrices_.clear();
+	matrices_.reserve(capacity);
+	head_ = 0;
+	count_ = 0;
+
+	stats_ = {};
+	stats_.capacity = capacity;
+}
+
+void WireRenderer::Build(const Vector3& start, const Vector3& end, float spacing) {
+	Clear();
+
+	const Vector3 to = {end.x - start.x, end.y - start.y, end.z - start.z};
+	const float totalDist = std::sqrt(to.x * to.x + to.y * to.y + to.z * to.z);
+	if (totalDist <= 0.001f || spacing <= 0.0f) {
+		return;
+	}
+
+	// セグメント数は start から end まで spacing 毎（両端は除く）
+	const Vector3 dir = {to.x / totalDist, to.y / totalDist, to.z / totalDist};
+	const uint32_t segCount = static_cast<uint32_t>(std::floor(totalDist / spacing));
+	for (uint32_t i = 1; i < segCount; ++i) {
+		if (count_ == segments_.size()) {
+			// 容量を超える分は並べない（フック側が欠ける）
+			stats_.truncatedSegments += segCount - i;
+			break;
+		}
+		const float d = static_cast<float>(i) * spacing;
+		segments_[count_++] = {start.x + dir.x * d, start.y + dir.y * d, start.z + dir.z * d};
+	}
+
+	stats_.segmentCount = count_;
+}
+
+void WireRenderer::PopFront() {
+	if (count_ == 0) {
+		return;
+	}
+
+	head_ = (head_ + 1) % static_cast<uint32_t>(segments_.size());
+	--count_;
+	stats_.segmentCount = count_;
+}
+
+void WireRenderer::Clear() {
+	head_ = 0;
+	count_ = 0;
+	stats_.segmentCount = 0;
+}
+
+void WireRenderer::Draw(RenderQueue& queue, InstancedModelRenderer& renderer, FrameRingBuffer& frameRing, Model& model, const RangeRect& visibleRect) {
+	matrices_.clear();
+	stats_.drawnSegments = 0;
+
+	for (uint32_t i = 0; i < count_; ++i) {
+		const Vector3& position = GetSegment(i);
+		if (position.x < visibleRect.left || position.x > visibleRect.right || position.y < visibleRect.bottom || position.y > visibleRect.top) {
+			continue;
+		}
+
+		// 拡大縮小と平行移動だけの行列（回転はしない）
+		matrices_.push_back({
+		    {{kSegmentScale.x, 0.0f, 0.0f, 0.0f}, {0.0f, kSegmentScale.y, 0.0f, 0.0f}, {0.0f, 0.0f, kSegmentScale.z, 0.0f}, {position.x, position.y, position.z, 1.0f}}
+        });
+	}
+
+	if (matrices_.empty()) {
+		return;
+	}
+
+	FrameRingBuffer::Allocation allocation;
+	if (!frameRing.Write(matrices_.data(), matrices_.size(), allocation)) {
+		// リングバッファが足りないフレームは描画しない（失敗回数はリングバッファの統計に残る）
+		return;
+	}
+
+	stats_.drawnSegments = static_cast<uint32_t>(matrices_.size());
+
+	// 深度は先頭のセグメントの位置で代表する
+	const Matrix4x4& front = matrices_.front();
+	queue.SubmitInstanced(renderer, model, allocation.gpuAddress, stats_.drawnSegments, {front.m[3][0], front.m[3][1], front.m[3][2]});
+}
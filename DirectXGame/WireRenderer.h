@@ -0,0 +1,85 @@
+#pragma once
+#include "FrameRingBuffer.h"
+#include "InstancedModelRenderer.h"
+#include "KamataEngine.h"
+#include "MapChipField.h"
+#include "RenderQueue.h"
+#include <vector>
+
+/// <summary>
+/// ワイヤーの鎖（プレイヤーからフックまで等間隔に並べたセグメント）
+/// セグメントの位置は容量固定のリングバッファに持ち、引っ張り中はプレイヤー側から O(1) で外す
+/// セグメントごとのオブジェクトや Update は無く、描画は鎖のモデルを1回のインスタンス描画で行う
+/// </summary>
+class WireRenderer {
+public:
+	// 使用状況
+	struct Stats {
+		uint32_t capacity = 0;          // 容量
+		uint32_t segmentCount = 0;      // 並んでいるセグメントの数
+		uint32_t drawnSegments = 0;     // 直近の描画で描いたセグメントの数
+		uint32_t truncatedSegments = 0; // 容量が足りず並べなかったセグメントの数（累計）
+	};
+
+	/// <summary>
+	/// 初期化（リングバッファを確保し、並んでいるセグメントは捨てる）
+	/// </summary>
+	/// <param name="capacity">セグメントの最大数</param>
+	void Initialize(uint32_t capacity);
+
+	/// <summary>
+	/// start から end まで spacing ごとにセグメントを並べ直す（両端の点には置かない。並びは start 側から）
+	/// </summary>
+	/// <param name="start">始点（プレイヤー）</param>
+	/// <param name="end">終点（フック）</param>
+	/// <param name="spacing">間隔</param>
+	void Build(const KamataEngine::Vector3& start, const KamataEngine::Vector3& end, float spacing);
+
+	/// <summary>
+	/// 始点側のセグメントを1つ外す（O(1)）
+	/// </summary>
+	void PopFront();
+
+	/// <summary>
+	/// すべてのセグメントを外す
+	/// </summary>
+	void Clear();
+
+	// 並んでいるセグメントの数の getter
+	uint32_t GetSegmentCount() const { return count_; }
+
+	// 始点側から i 番目のセグメントの位置
+	const KamataEngine::Vector3& GetSegment(uint32_t i) const { return segments_[(head_ + i) % segments_.size()]; }
+
+	/// <summary>
+	/// 描画を積む（カメラに映る範囲のセグメントの行列をフレームのリングバッファに書き、1回のインスタンス描画にする）
+	/// </summary>
+	/// <param name="queue">描画キュー</param>
+	/// <param name="renderer">インスタンス描画</param>
+	/// <param name="frameRing">フレームのリングバッファ</param>
+	/// <param name="model">鎖のモデル</param>
+	/// <param name="visibleRect">カメラに映る範囲</param>
+	void Draw(RenderQueue& queue, InstancedModelRenderer& renderer, FrameRingBuffer& frameRing, KamataEngine::Model& model, const RangeRect& visibleRect);
+
+	// 使用状況の getter
+	const Stats& GetStats() const { return stats_; }
+
+	// セグメントの大きさ（弾と同じ）
+	static inline const KamataEngine::Vector3 kSegmentScale = {0.2f, 0.2f, 0.2f};
+
+private:
+	// セグメントの位置（head_ から count_ 個。容量は Initialize で決めて変えない）
+	std::vector<KamataEngine::Vector3> segments_;
+
+	// 始点側のセグメントの位置
+	uint32_t head_ = 0;
+
+	// 並んでいるセグメントの数
+	uint32_t count_ = 0;
+
+	// 描画する行列の作業用（容量分を確保して使い回す）
+	std::vector<KamataEngine::Matrix4x4> matrices_;
+
+	// 使用状況
+	Stats stats_;
+};
@@ -0,0 +1,107 @@
+#include "WorldTransformSystem.h"
+#include <cstring>
+
+using namespace KamataEngine;
+
+namespace {
+
+bool IsSameVector(const Vector3& a, const Vector3& b) { return a.x == b.x && a.y == b.y && a.z == b.z; }
+
+bool IsSameMatrix(const Matrix4x4& a, const Matrix4x4& b) { return std::memcmp(&a, &b, sizeof(Matrix4x4)) == 0; }
+
+} // namespace
+
+void WorldTransformSystem::Register(WorldTransform& worldTransform) {
+	if (indices_.contains(&worldTransform)) {
+		MarkDirty(worldTransform);
+		return;
+	}
+
+	Entry entry;
+	entry.worldTransform = &worldTransform;
+	indices_[&worldTransform] = entries_.size();
+	entries_.push_back(entry);
+}
+
+void WorldTransformSystem::Unregister(const WorldTransform& worldTransform) {
+	auto it = indices_.find(&worldTransform);
+	if (it == indices_.end()) {
+		return;
+	}
+
+	// 末尾と入れ替えて消す
+	const size_t index = it->second;
+	indices_.erase(it);
+	if (index != entries_.size() - 1) {
+		entries_[index] = entries_.back();
+		indices_[entries_[index].worldTransform] = index;
+	}
+	entries_.pop_back();
+}
+
+void WorldTransformSystem::MarkDirty(const WorldTransform& worldTransform) {
+	auto it = indices_.find(&worldTransform);
+	if (it != indices_.end()) {
+		entries_[it->second].dirty = true;
+	}
+}
+
+void WorldTransformSystem::Update() {
+	++frame_;
+	stats_ = {};
+	stats_.registeredTransforms = static_cast<uint32_t>(entries_.size());
+
+	for (size_t i = 0; i < entries_.size(); ++i) {
+		UpdateEntry(i);
+	}
+}
+
+bool WorldTransformSystem::UpdateEntry(size_t index) {
+	Entry& entry = entries_[index];
+	if (entry.visitedFrame == frame_) {
+		return entry.rebuiltFrame == frame_;
+	}
+	entry.visitedFrame = frame_;
+
+	WorldTransform& worldTransform = *entry.worldTransform;
+
+	bool dirty = entry.dirty;
+	dirty = dirty || !IsSameVector(worldTransform.scale_, entry.scale);
+	dirty = dirty || !IsSameVector(worldTransform.rotation_, entry.rotation);
+	dirty = dirty || !IsSameVector(worldTransform.translation_, entry.translation);
+
+	// 親が登録されていれば先に親の行列を確定させてから、親の行列が変わったかを見る
+	const WorldTransform* parent = worldTransform.parent_;
+	if (parent) {
+		auto it = indices_.find(parent);
+		if (it != indices_.end()) {
+			UpdateEntry(it->second);
+		}
+		dirty = dirty || !IsSameMatrix(parent->matWorld_, entry.parentMatrix);
+	}
+
+	if (!dirty) {
+		return false;
+	}
+
+	// スケール、回転、平行移動を合成して変換
+	worldTransform.matWorld_ = math.MakeAffineMatrix(worldTransform.scale_, worldTransform.rotation_, worldTransform.translation_);
+	if (parent) {
+		worldTransform.matWorld_ = math.Multiply(worldTransform.matWorld_, parent->matWorld_);
+		entry.parentMatrix = parent->matWorld_;
+	}
+
+	// 定数バッファに転送
+	worldTransform.TransferMatrix();
+
+	entry.scale = worldTransform.scale_;
+	entry.rotation = worldTransform.rotation_;
+	entry.translation = worldTransform.translation_;
+	entry.dirty = false;
+	entry.rebuiltFrame = frame_;
+
+	++stats_.rebuiltMatrices;
+	stats_.uploadedBytes += sizeof(ConstBufferDataWorldTransform);
+
+	return true;
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include "KamataEngine.h"
+#include "Math.h"
+#include <unordered_map>
+#include <vector>
+
+// 1フレーム分の行列更新の統計
+struct WorldTransformStats {
+	uint32_t registeredTransforms = 0; // 登録されているワールド変換の数
+	uint32_t rebuiltMatrices = 0;      // 行列を作り直した数
+	uint32_t uploadedBytes = 0;        // 定数バッファに転送したバイト数
+};
+
+/// <summary>
+/// 登録したワールド変換のうち、変化したものだけ行列を作り直して転送する
+/// </summary>
+class WorldTransformSystem {
+public:
+	/// <summary>
+	/// ワールド変換の登録（登録直後の更新では必ず行列を作る）
+	/// </summary>
+	void Register(KamataEngine::WorldTransform& worldTransform);
+
+	/// <summary>
+	/// ワールド変換の登録解除
+	/// </summary>
+	void Unregister(const KamataEngine::WorldTransform& worldTransform);
+
+	/// <summary>
+	/// 次の更新で必ず行列を作り直す（スケール・回転・座標以外を変えたとき用）
+	/// </summary>
+	void MarkDirty(const KamataEngine::WorldTransform& worldTransform);
+
+	/// <summary>
+	/// 更新（1フレームに1回、全てのオブジェクトの更新の後に呼ぶ）
+	/// スケール・回転・座標が前回の転送時から変わったもの、または親の行列が変わったものだけを作り直す
+	/// </summary>
+	void Update();
+
+	// 直近の更新の統計の getter
+	const WorldTransformStats& GetStats() const { return stats_; }
+
+private:
+	// 登録されたワールド変換と、前回転送したときの値
+	struct Entry {
+		KamataEngine::WorldTransform* worldTransform = nullptr;
+		KamataEngine::Vector3 scale{};
+		KamataEngine::Vector3 rotation{};
+		KamataEngine::Vector3 translation{};
+		KamataEngine::Matrix4x4 parentMatrix{};
+		bool dirty = true;
+		uint64_t visitedFrame = 0;
+		uint64_t rebuiltFrame = 0;
+	};
+
+	// 1つ分の更新（親が登録されていれば先に親を更新する）。このフレームで行列を作り直したら true
+	bool UpdateEntry(size_t index);
+
+	std::vector<Entry> entries_;
+
+	// ワールド変換から entries_ の番号を引く
+	std::unordered_map<const KamataEngine::WorldTransform*, size_t> indices_;
+
+	// 更新回数（このフレームで処理済みかどうかの判定に使う）
+	uint64_t frame_ = 0;
+
+	WorldTransformStats stats_;
+
+	Math math;
+};
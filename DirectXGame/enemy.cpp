@@ -1,132 +1,44 @@
-#include "Enemy.h"
+#include "enemy.h"
+#include "EnemySystem.h"
 #include <cassert>
-#include <numbers>
 
-using namespace KamataEngine;
+// 中身はすべて EnemySystem の配列にある。ハンドルから並びの位置を引いて読み書きする
 
-void Enemy::Initialize(KamataEngine::Model* model, KamataEngine::Camera* camera, const KamataEngine::Vector3& position) {
-	// NUllチェック
-	assert(model);
-
-	// 初期化
-	model_ = model;
-	camera_ = camera;
-	worldTransformEnemy_.Initialize();
-	worldTransformEnemy_.translation_ = position;
-
-
-	// 速度設定
-	velocity_ = {-kWalkSpeed, 0.0f, 0.0f};
-}
-
-void Enemy::Update() {
-
-	if (behaviorRequest_ != Behavior::kUnknown) {
-
-		// 振るまいを変更する
-		behavior_ = behaviorRequest_;
-
-		// 各振るまいごとの初期化
-		switch (behavior_) {
-		case Behavior::kDefeated:
-		default:
-			counter_ = 0;
-			break;
-		}
-
-		// 振るまいリクエストをリセット
-		behaviorRequest_ = Behavior::kUnknown;
-	}
-
-	switch (behavior_) {
-	case Enemy::Behavior::kWalk:
-		/*---　歩き　---*/
-
-		// 移動
-		/*worldTransformEnemy_.translation_ += velocity_;*/
-
-		// タイマーの加算
-		walkTimer += 1.0f / 60.0f;
-
-		worldTransformEnemy_.rotation_.y += 0.1f /*std::sin(std::numbers::pi_v<float> * 2.0f * walkTimer / kWalkMotionTime)*/;
-
-		// 行列の変換と転送
-		math.worldTransformUpdate(worldTransformEnemy_);
-
-		break;
-	case Enemy::Behavior::kDefeated:
-		/*---　やられ状態　---*/
-		// タイマー
-		counter_ += 1.0f / 60.0f;
-
-		worldTransformEnemy_.rotation_.y += 0.3f;
-		worldTransformEnemy_.rotation_.x = math.EaseOut(counter_ / kDefeatedTime, kDefeatedMotionAngleStart, kDefeatedMotionAngleEnd);
-
-		// スケールを徐々に小さくして消す
-		{
-			float t = counter_ / kDefeatedTime;
-			if (t > 1.0f) t = 1.0f;
-			// イージングで自然に縮む
-			float s = math.EaseOut(t, 1.0f, 0.0f);
-			worldTransformEnemy_.scale_ = {s, s, s};
-		}
-
-		// 行列の変換と転送
-		math.worldTransformUpdate(worldTransformEnemy_);
-
-		if (counter_ >= kDefeatedTime) {
-			isDead_ = true;
-		}
-		break;
-	}
-}
-
-void Enemy::Draw() {
-
-	if (!isDead_) {
-		// モデルの描画
-		model_->Draw(worldTransformEnemy_, *camera_);
-	}
-}
+bool Enemy::IsValid() const { return system_ && system_->Find(handle_) != SlotMap::kInvalid; }
 
 void Enemy::OnCollision(const Player* player) {
 
 	(void)player;
 
-	// 既にやられているなら何もしない
-	if (behavior_ == Behavior::kDefeated) {
+	if (!IsValid()) {
 		return;
 	}
 
-	// プレイヤーの弾が当たった場合：非表示にする
-	// （描画を止め、衝突を無効化する）
-	isVisible_ = false;
-	isCollisionDisabled_ = true;
-
-	// 必要ならやられ演出を続けて最終的に isDead_ にするためのリクエストを出す
-	behaviorRequest_ = Behavior::kDefeated;
+	// プレイヤーの弾が当たった場合：倒す（既にやられているなら何もしない）
+	system_->Defeat(system_->Find(handle_));
 }
 
-KamataEngine::Vector3 Enemy::GetWorldPosition() {
-	// ワールド座標を入れる変数
-	Vector3 worldPos;
-
-	// ワールド行列の平行移動成分を取得（ワールド座標）
-	worldPos.x = worldTransformEnemy_.matWorld_.m[3][0];
-	worldPos.y = worldTransformEnemy_.matWorld_.m[3][1];
-	worldPos.z = worldTransformEnemy_.matWorld_.m[3][2];
-
-	return worldPos;
+KamataEngine::Vector3 Enemy::GetWorldPosition() const {
+	assert(IsValid());
+	const uint32_t i = system_->Find(handle_);
+	return {system_->posX_[i], system_->posY_[i], system_->posZ_[i]};
 }
 
-AABB Enemy::GetAABB() {
-
-	Vector3 worldPos = GetWorldPosition();
-
-	AABB aabb;
+AABB Enemy::GetAABB() const {
+	assert(IsValid());
+	return system_->GetActiveAABB(system_->Find(handle_));
+}
 
-	aabb.min = {worldPos.x - kWidth / 2.0f, worldPos.y - kHeight / 2.0f, worldPos.z - kWidth / 2.0f};
-	aabb.max = {worldPos.x + kWidth / 2.0f, worldPos.y + kHeight / 2.0f, worldPos.z + kWidth / 2.0f};
+bool Enemy::IsDead() const {
+	if (!IsValid()) {
+		return true;
+	}
+	return system_->flags_[system_->Find(handle_)] & EnemySystem::kDead;
+}
 
-	return aabb;
+bool Enemy::IsCollisionDisabled() const {
+	if (!IsValid()) {
+		return true;
+	}
+	return system_->flags_[system_->Find(handle_)] & EnemySystem::kCollisionDisabled;
 }
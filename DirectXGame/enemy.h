@@ -1,10 +1,16 @@
 #pragma once
-#include "math.h"
 #include "KamataEngine.h"
-#include "Player.h"
+#include "SlotMap.h"
+#include "Math.h"
+#include <cstdint>
 
+class EnemySystem;
 class Player;
 
+/// <summary>
+/// 敵のハンドル（中身は EnemySystem の配列にあり、ここにはスロット番号と世代だけを持つ）
+/// 敵が返されると無効になる（スロットが別の敵に使い回されても世代が違うので、前の敵のハンドルは無効のまま）
+/// </summary>
 class Enemy {
 public:
 	enum class Behavior {
@@ -16,96 +22,34 @@ public:
 	};
 
 public:
-	/// <summary>
-	/// 敵の初期化
-	/// </summary>
-	/// <param name="model">モデル</param>
-	/// <param name="camera">カメラ</param>
-	/// <param name="camera">位置</param>
-	void Initialize(KamataEngine::Model* model, KamataEngine::Camera* camera, const KamataEngine::Vector3& position);
+	Enemy() = default;
+	Enemy(EnemySystem* system, const SlotHandle& handle) : system_(system), handle_(handle) {}
 
-	/// <summary>
-	/// 敵の更新
-	/// </summary>
-	void Update();
+	// 敵を指しているか（空きが無くて出せなかったとき、敵が返された後は false）
+	bool IsValid() const;
 
-	/// <summary>
-	/// 敵の描画
-	/// </summary>
-	void Draw();
+	bool operator==(const Enemy& other) const = default;
+
+	// スロット番号と世代の getter（EnemySystem::Release に渡す）
+	const SlotHandle& GetHandle() const { return handle_; }
 
 	// 衝突応答
 	void OnCollision(const Player* player);
 
-	KamataEngine::Vector3 GetWorldPosition();
+	KamataEngine::Vector3 GetWorldPosition() const;
 
 	// AABBの取得
-	AABB GetAABB();
+	AABB GetAABB() const;
 
-	bool IsDead() const { return isDead_; }
+	// 返された敵は死んでいる扱い
+	bool IsDead() const;
 
-	bool IsCollisionDisabled() const { return isCollisionDisabled_; }
+	bool IsCollisionDisabled() const;
 
 private:
-	// ワールド変換データ
-	KamataEngine::WorldTransform worldTransformEnemy_;
-
-	// モデル
-	KamataEngine::Model* model_ = nullptr;
-
-	// カメラ
-	KamataEngine::Camera* camera_ = nullptr;
-
-	// 歩行速度
-	static inline const float kWalkSpeed = 0.02f;
-
-	// 速度
-	KamataEngine::Vector3 velocity_ = {};
-
-	// キャラクターの当たり判定サイズ
-	static inline const float kWidth = 1.6f;
-
-	static inline const float kHeight = 1.5f;
-
-	// デスフラグ
-	bool isDead_ = false;
-
-	// 振る舞い
-	Behavior behavior_ = Behavior::kWalk;
-
-	Behavior behaviorRequest_ = Behavior::kUnknown;
-
-	/*-------------- やられ演出のあれやこれや --------------*/
-
-	// 演出時間
-	static inline const float kDefeatedTime = 0.6f;
-	static inline const float kDefeatedMotionAngleStart = 0.0f;
-	static inline const float kDefeatedMotionAngleEnd = -60.0f;
-
-	// タイマー
-	float counter_ = 0.0f;
-
-	// 無効化フラグ
-	bool isCollisionDisabled_ = false;
-
-	// 表示フラグ（弾に当たったら false にして描画を止める）
-	bool isVisible_ = true;
-
-	/*-------------- アニメーションの設定 --------------*/
-
-	// 最初の角度
-	static inline const float kWalkMotionAngleStart = 0.0f;
-
-	// 最後の角度
-	static inline const float kWalkMotionAngleEnd = 30.0f;
-
-	// アニメーションの周期となる時間(秒)
-	static inline const float kWalkMotionTime = 1.0f;
-
-	// 時間
-	float walkTimer = 0.0f;
-
-	/*-------------- 関数 --------------*/
+	// 中身を持っているシステム
+	EnemySystem* system_ = nullptr;
 
-	Math math;
+	// スロット番号と世代
+	SlotHandle handle_;
 };
@@ -1,7 +1,9 @@
 #include "GameScene.h"
 #include "KamataEngine.h"
+#include "MapChipField.h"
 #include "TitleScene.h"
 #include <Windows.h>
+#include <sstream>
 
 using namespace KamataEngine;
 
@@ -82,8 +84,43 @@ void DrawScene() {
 }
 
 
+// マップのベイク（オフライン変換）
+// 使い方: DirectXGame.exe -bake <入力CSV> <出力バイナリ>
+// コマンドラインがベイク指定でなければ false を返し、通常どおりゲームを起動する
+bool BakeMapFromCommandLine(const char* commandLine, int& exitCode) {
+
+	std::istringstream args(commandLine ? commandLine : "");
+	std::string option;
+	if (!(args >> option) || option != "-bake") {
+		return false;
+	}
+
+	std::string csvPath;
+	std::string binaryPath;
+	if (!(args >> csvPath >> binaryPath)) {
+		OutputDebugStringA("usage: -bake <input.csv> <output.mapbin>\n");
+		exitCode = 1;
+		return true;
+	}
+
+	if (!MapChipField::BakeMapChipCsv(csvPath, binaryPath)) {
+		OutputDebugStringA(("failed to bake map: " + binaryPath + "\n").c_str());
+		exitCode = 1;
+		return true;
+	}
+
+	exitCode = 0;
+	return true;
+}
+
 // Windowsアプリでのエントリーポイント(main関数)
-int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int) {
+int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR lpCmdLine, _In_ int) {
+
+	// ベイク指定ならエンジンを起動せずに変換だけ行って終了する
+	int bakeExitCode = 0;
+	if (BakeMapFromCommandLine(lpCmdLine, bakeExitCode)) {
+		return bakeExitCode;
+	}
 
 	// エンジンの初期化
 	KamataEngine::Initialize(L"LE2B_04_カトウ_ヒロキ_襲撃");
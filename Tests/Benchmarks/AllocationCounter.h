@@ -0,0 +1,8 @@
+#pragma once
+// ベンチマークの実行ファイル全体で operator new を数える（AllocationCounter.cpp で置き換える）
+#include <cstdint>
+
+/// <summary>
+/// これまでに operator new が呼ばれた回数（全スレッドの合計）
+/// </summary>
+uint64_t GetAllocationCount();
@@ -0,0 +1,127 @@
+#include "EnemySystem.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// 敵の振る舞いの更新。振る舞いごとにまとめて回す今の EnemySystem::Update と、
+// 敵ごとに振る舞いで分岐する元の更新（同じ成分の配列で、倒した敵が並びの中に散らばっている）の比較
+// やられ演出が終わって死亡にならないよう、やられ時間を長くした表を使う（やられ中の割合がフレームごとに変わらない）
+
+namespace {
+
+// やられ演出が終わらない表
+EnemyArchetypeTable EndlessDefeatTable() {
+	EnemyArchetypeTable table;
+	for (EnemyType type : {EnemyType::kSlime, EnemyType::kBat}) {
+		EnemyArchetypeTable::Archetype archetype = table.Get(type);
+		archetype.defeatedTime = 1.0e6f;
+		table.Set(type, archetype);
+	}
+	return table;
+}
+
+// 倒す敵の番号（count 体のうち percent %。並びの中に散らばるよう乱数で選ぶ）
+std::vector<uint32_t> DefeatedIndices(uint32_t count, uint32_t percent) {
+	std::vector<uint32_t> indices(count);
+	std::iota(indices.begin(), indices.end(), 0);
+	std::shuffle(indices.begin(), indices.end(), std::mt19937(25));
+	indices.resize(static_cast<size_t>(count) * percent / 100);
+	return indices;
+}
+
+void BM_EnemyBehaviorBatched(benchmark::State& state) {
+	const uint32_t count = static_cast<uint32_t>(state.range(0));
+
+	KamataEngine::Model model;
+	EnemySystem enemies;
+	enemies.SetArchetypes(EndlessDefeatTable());
+	enemies.Initialize(count);
+	std::vector<Enemy> spawned;
+	for (uint32_t i = 0; i < count; ++i) {
+		spawned.push_back(enemies.Spawn(&model, {static_cast<float>(i) * MapChipField::kBlockWidth, 0.0f, 0.0f}, {i, 0}, i % 2 ? EnemyType::kBat : EnemyType::kSlime));
+	}
+	for (uint32_t i : DefeatedIndices(count, static_cast<uint32_t>(state.range(1)))) {
+		spawned[i].OnCollision(nullptr);
+	}
+	// やられ状態のリクエストを反映しておく（以降は振る舞いごとの並びに分かれている）
+	enemies.Update();
+
+	for (auto _ : state) {
+		enemies.Update();
+		benchmark::ClobberMemory();
+	}
+
+	state.counters["walkers"] = static_cast<double>(enemies.GetWalkerCount());
+}
+// 敵の数と、やられ中の割合（%）
+BENCHMARK(BM_EnemyBehaviorBatched)->ArgNames({"enemies", "defeatedPercent"})->ArgsProduct({{10000, 50000}, {0, 10, 50}});
+
+// 元の更新（敵ごとに振る舞いで分岐する。パラメータは同じ表から引く）
+struct SwitchedEnemies {
+	std::vector<float> rotX;
+	std::vector<float> rotY;
+	std::vector<float> scale;
+	std::vector<Enemy::Behavior> behavior;
+	std::vector<uint8_t> archetype;
+	std::vector<float> counter;
+	std::vector<float> walkTimer;
+	std::vector<uint8_t> flags;
+	EnemyArchetypeTable archetypes = EndlessDefeatTable();
+	Math math;
+
+	explicit SwitchedEnemies(uint32_t count)
+	    : rotX(count, 0.0f), rotY(count, 0.0f), scale(count, 1.0f), behavior(count, Enemy::Behavior::kWalk), archetype(count), counter(count, 0.0f), walkTimer(count, 0.0f), flags(count, 0) {
+		for (uint32_t i = 0; i < count; ++i) {
+			archetype[i] = static_cast<uint8_t>(i % 2 ? EnemyType::kBat : EnemyType::kSlime);
+		}
+	}
+
+	void Update() {
+		for (size_t i = 0; i < behavior.size(); ++i) {
+			const uint8_t id = archetype[i];
+			switch (behavior[i]) {
+			case Enemy::Behavior::kWalk:
+				walkTimer[i] += 1.0f / 60.0f;
+				rotY[i] += archetypes.GetWalkSpin(id);
+				break;
+			case Enemy::Behavior::kDefeated: {
+				if (flags[i] & EnemySystem::kDead) {
+					break;
+				}
+				const float defeatedTime = archetypes.GetDefeatedTime(id);
+				counter[i] += 1.0f / 60.0f;
+				rotY[i] += archetypes.GetDefeatedSpin(id);
+				rotX[i] = math.EaseOut(counter[i] / defeatedTime, archetypes.GetDefeatedAngleStart(id), archetypes.GetDefeatedAngleEnd(id));
+				scale[i] = math.EaseOut(std::min(counter[i] / defeatedTime, 1.0f), 1.0f, 0.0f);
+				if (counter[i] >= defeatedTime) {
+					flags[i] |= EnemySystem::kDead;
+				}
+				break;
+			}
+			default:
+				break;
+			}
+		}
+	}
+};
+
+void BM_EnemyBehaviorSwitched(benchmark::State& state) {
+	const uint32_t count = static_cast<uint32_t>(state.range(0));
+
+	SwitchedEnemies enemies(count);
+	for (uint32_t i : DefeatedIndices(count, static_cast<uint32_t>(state.range(1)))) {
+		enemies.behavior[i] = Enemy::Behavior::kDefeated;
+	}
+
+	for (auto _ : state) {
+		enemies.Update();
+		benchmark::ClobberMemory();
+	}
+
+	state.counters["walkers"] = static_cast<double>(std::count(enemies.behavior.begin(), enemies.behavior.end(), Enemy::Behavior::kWalk));
+}
+BENCHMARK(BM_EnemyBehaviorSwitched)->ArgNames({"enemies", "defeatedPercent"})->ArgsProduct({{10000, 50000}, {0, 10, 50}});
+
+} // namespace
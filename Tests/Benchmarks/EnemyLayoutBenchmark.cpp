@@ -0,0 +1,160 @@
+#include "EnemySystem.h"
+#include "WorldTransformSystem.h"
+#include <benchmark/benchmark.h>
+#include <list>
+#include <vector>
+
+// 敵 50000 体の1フレームの更新。成分ごとの配列（EnemySystem）と、元の std::list<Enemy*>（敵ごとにワールド変換を持つ）の比較
+// どちらも更新とワールド行列を作るところまで（定数バッファへの転送は入れない）。最初に 10 体に 1 体を倒しておく
+
+namespace {
+
+const uint32_t kEnemyCount = 50000;
+
+// 元の Enemy（ヒープに1体ずつ置き、ワールド変換・モデル・カメラ・Math を持つ。更新は振る舞いで分岐する）
+class ListEnemy {
+public:
+	enum class Behavior {
+		kUnknown = -1,
+		kWalk,
+		kDefeated
+	};
+
+	void Initialize(KamataEngine::Model* model, KamataEngine::Camera* camera, const KamataEngine::Vector3& position) {
+		model_ = model;
+		camera_ = camera;
+		worldTransform_.Initialize();
+		worldTransform_.translation_ = position;
+		velocity_ = {-kWalkSpeed, 0.0f, 0.0f};
+	}
+
+	void Update() {
+		if (behaviorRequest_ != Behavior::kUnknown) {
+			behavior_ = behaviorRequest_;
+			counter_ = 0.0f;
+			behaviorRequest_ = Behavior::kUnknown;
+		}
+
+		switch (behavior_) {
+		case Behavior::kWalk:
+			walkTimer_ += 1.0f / 60.0f;
+			worldTransform_.rotation_.y += 0.1f;
+			break;
+		case Behavior::kDefeated:
+			if (isDead_) {
+				break;
+			}
+			counter_ += 1.0f / 60.0f;
+			worldTransform_.rotation_.y += 0.3f;
+			worldTransform_.rotation_.x = math_.EaseOut(counter_ / kDefeatedTime, 0.0f, -60.0f);
+			{
+				float t = counter_ / kDefeatedTime;
+				if (t > 1.0f) {
+					t = 1.0f;
+				}
+				const float s = math_.EaseOut(t, 1.0f, 0.0f);
+				worldTransform_.scale_ = {s, s, s};
+			}
+			if (counter_ >= kDefeatedTime) {
+				isDead_ = true;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	void OnCollision() {
+		if (behavior_ != Behavior::kDefeated) {
+			isCollisionDisabled_ = true;
+			behaviorRequest_ = Behavior::kDefeated;
+		}
+	}
+
+	KamataEngine::WorldTransform& GetWorldTransform() { return worldTransform_; }
+
+private:
+	static inline const float kWalkSpeed = 0.02f;
+	static inline const float kDefeatedTime = 0.6f;
+
+	KamataEngine::WorldTransform worldTransform_;
+	KamataEngine::Model* model_ = nullptr;
+	KamataEngine::Camera* camera_ = nullptr;
+	KamataEngine::Vector3 velocity_ = {};
+	bool isDead_ = false;
+	Behavior behavior_ = Behavior::kWalk;
+	Behavior behaviorRequest_ = Behavior::kUnknown;
+	float counter_ = 0.0f;
+	bool isCollisionDisabled_ = false;
+	float walkTimer_ = 0.0f;
+	Math math_;
+};
+
+// 敵 i の位置（横に並べ、5 段に分ける）
+KamataEngine::Vector3 SpawnPosition(uint32_t i) { return {static_cast<float>(i / 5) * MapChipField::kBlockWidth, static_cast<float>(i % 5) * MapChipField::kBlockHeight, 0.0f}; }
+
+void BM_EnemyUpdateComponentArrays(benchmark::State& state) {
+	KamataEngine::Model model;
+	EnemySystem enemies;
+	enemies.Initialize(kEnemyCount);
+	std::vector<Enemy> spawned;
+	for (uint32_t i = 0; i < kEnemyCount; ++i) {
+		spawned.push_back(enemies.Spawn(&model, SpawnPosition(i), {i / 5, i % 5}, i % 2 ? EnemyType::kBat : EnemyType::kSlime));
+	}
+	for (uint32_t i = 0; i < kEnemyCount; i += 10) {
+		spawned[i].OnCollision(nullptr);
+	}
+
+	// Draw と同じく、起きている敵の行列を配列に書く
+	std::vector<KamataEngine::Matrix4x4> worldMatrices(kEnemyCount);
+	for (auto _ : state) {
+		enemies.Update();
+		for (uint32_t i = 0; i < enemies.GetAwakeCount(); ++i) {
+			worldMatrices[i] = enemies.MakeActiveWorldMatrix(i);
+		}
+		benchmark::DoNotOptimize(worldMatrices.data());
+		benchmark::ClobberMemory();
+	}
+
+	state.counters["enemies"] = static_cast<double>(enemies.GetActiveCount());
+}
+BENCHMARK(BM_EnemyUpdateComponentArrays)->Unit(benchmark::kMicrosecond);
+
+void BM_EnemyUpdatePointerList(benchmark::State& state) {
+	KamataEngine::Model model;
+	KamataEngine::Camera camera;
+	WorldTransformSystem worldTransforms;
+	std::list<ListEnemy*> enemies;
+	for (uint32_t i = 0; i < kEnemyCount; ++i) {
+		ListEnemy* enemy = new ListEnemy();
+		enemy->Initialize(&model, &camera, SpawnPosition(i));
+		worldTransforms.Register(enemy->GetWorldTransform());
+		enemies.push_back(enemy);
+	}
+	uint32_t n = 0;
+	for (ListEnemy* enemy : enemies) {
+		if (n++ % 10 == 0) {
+			enemy->OnCollision();
+		}
+	}
+
+	uint64_t rebuilt = 0;
+	for (auto _ : state) {
+		for (ListEnemy* enemy : enemies) {
+			enemy->Update();
+		}
+		// 変わった変換の行列を作り直す（元の GameScene と同じ）
+		worldTransforms.Update();
+		benchmark::ClobberMemory();
+		rebuilt += worldTransforms.GetStats().rebuiltMatrices;
+	}
+
+	state.counters["enemies"] = static_cast<double>(enemies.size());
+	state.counters["rebuiltPerFrame"] = benchmark::Counter(static_cast<double>(rebuilt), benchmark::Counter::kAvgIterations);
+	for (ListEnemy* enemy : enemies) {
+		delete enemy;
+	}
+}
+BENCHMARK(BM_EnemyUpdatePointerList)->Unit(benchmark::kMicrosecond);
+
+} // namespace
@@ -0,0 +1,78 @@
+#include "EnemySystem.h"
+#include "TestMapFile.h"
+#include <benchmark/benchmark.h>
+
+// 敵を 10000 体出したマップで、カメラから離れた敵を眠らせた場合と、すべて起こしておく場合の1フレームの比較
+// （起こす範囲の選び直し・更新・描画を積むところまで。カメラは毎フレーム右に進む）
+
+namespace {
+
+// 10000 x 25 のマップの各列に1体（スライムとコウモリを交互に）。下3段は地面
+const uint32_t kMapWidth = 10000;
+const uint32_t kMapHeight = 25;
+
+// カメラに映る範囲の半分の大きさ（CameraController の既定のカメラとほぼ同じ）
+const float kVisibleHalfWidth = 37.0f;
+const float kVisibleHalfHeight = 21.0f;
+
+MapChipField& SpawnMap() {
+	static MapChipField field;
+	if (field.GetNumBlockHorizontal() == 0) {
+		const std::string csv = MakeMapCsv(kMapWidth, kMapHeight, [](uint32_t x, uint32_t y) {
+			if (y >= kMapHeight - 3) {
+				return "1";
+			}
+			if (y == kMapHeight - 4) {
+				return x % 2 ? "E2" : "E1";
+			}
+			return "0";
+		});
+		field.LoadMapChipCsv(WriteTemporaryFile("EnemySystemBenchmark.csv", csv));
+	}
+	return field;
+}
+
+void BM_EnemySystemFrame(benchmark::State& state) {
+	const bool activation = state.range(0) != 0;
+	MapChipField& field = SpawnMap();
+
+	KamataEngine::Model model;
+	EnemySystem enemies;
+	enemies.SetMapChipField(activation ? &field : nullptr);
+	enemies.Initialize(static_cast<uint32_t>(field.GetEnemySpawns().size()));
+	for (const EnemySpawn& spawn : field.GetEnemySpawns()) {
+		enemies.Spawn(&model, field.GetMapChipPositionByIndex(spawn.index.xIndex, spawn.index.yIndex), spawn.index, spawn.type);
+	}
+
+	KamataEngine::Camera camera;
+	RenderQueue queue;
+	InstancedModelRenderer renderer;
+	FrameRingBuffer frameRing;
+	frameRing.Initialize(enemies.GetActiveCount() * sizeof(KamataEngine::Matrix4x4) * 4, 2);
+
+	const float mapRight = static_cast<float>(kMapWidth) * MapChipField::kBlockWidth;
+	float cameraX = kVisibleHalfWidth;
+	uint64_t awake = 0;
+	for (auto _ : state) {
+		const RangeRect visibleRect = {cameraX - kVisibleHalfWidth, cameraX + kVisibleHalfWidth, 24.0f - kVisibleHalfHeight, 24.0f + kVisibleHalfHeight};
+
+		frameRing.BeginFrame();
+		queue.Begin(camera);
+		enemies.UpdateActivation(visibleRect);
+		enemies.Update();
+		enemies.Draw(queue, renderer, frameRing, visibleRect);
+		frameRing.EndFrame();
+
+		awake += enemies.GetAwakeCount();
+		cameraX += 0.5f;
+		if (cameraX > mapRight - kVisibleHalfWidth) {
+			cameraX = kVisibleHalfWidth;
+		}
+	}
+
+	state.counters["enemies"] = static_cast<double>(enemies.GetActiveCount());
+	state.counters["awakePerFrame"] = benchmark::Counter(static_cast<double>(awake), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_EnemySystemFrame)->ArgName("activation")->Arg(0)->Arg(1);
+
+} // namespace
@@ -0,0 +1,74 @@
+#include "AllocationCounter.h"
+#include "MapChipField.h"
+#include "TestMapFile.h"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+
+// 10000 x 1000 の CSV を読み込む速さ（MB/s）と、1回の読み込みで operator new が呼ばれた回数
+// （読み込み先の MapChipField は使い回す。マップの形はブロックだけと、敵を混ぜたものの2通り）
+// 読み込みにはビットボード・占有ピラミッド・距離場を作り直す時間も含まれるので、
+// 同じマップを焼き込んだバイナリの読み込み（パースせずにコピーするだけ）も並べて、その差をパースの時間とみなす
+
+namespace {
+
+const uint32_t kMapWidth = 10000;
+const uint32_t kMapHeight = 1000;
+
+// 敵の数（0 ならブロックと空白だけ）ごとに1回だけ書き出す
+const std::string& SyntheticCsv(uint32_t enemyEvery) {
+	static std::string plainPath;
+	static std::string enemyPath;
+	std::string& path = enemyEvery ? enemyPath : plainPath;
+	if (path.empty()) {
+		const std::string csv = MakeMapCsv(kMapWidth, kMapHeight, [enemyEvery](uint32_t x, uint32_t y) {
+			if (enemyEvery && (x + y * kMapWidth) % enemyEvery == 0) {
+				return x % 2 ? " E2" : "E1";
+			}
+			return ((x * 7 + y * 3) % 5 == 0) ? "1" : "0";
+		});
+		path = WriteTemporaryFile(enemyEvery ? "MapChipCsvBenchmarkEnemies.csv" : "MapChipCsvBenchmark.csv", csv);
+	}
+	return path;
+}
+
+void BM_MapChipLoadCsv(benchmark::State& state) {
+	const uint32_t enemyEvery = static_cast<uint32_t>(state.range(0));
+	const std::string& path = SyntheticCsv(enemyEvery);
+	const uint64_t fileSize = std::filesystem::file_size(path);
+
+	MapChipField field;
+	uint64_t allocations = 0;
+	for (auto _ : state) {
+		const uint64_t before = GetAllocationCount();
+		field.LoadMapChipCsv(path);
+		allocations += GetAllocationCount() - before;
+	}
+
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * fileSize));
+	state.counters["allocationsPerLoad"] = benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+	state.counters["enemies"] = static_cast<double>(field.GetEnemySpawns().size());
+}
+// enemyEvery: この数のタイルごとに敵を1体置く（0 なら置かない）
+BENCHMARK(BM_MapChipLoadCsv)->ArgName("enemyEvery")->Arg(0)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+void BM_MapChipLoadBinary(benchmark::State& state) {
+	const uint32_t enemyEvery = static_cast<uint32_t>(state.range(0));
+	const std::string binaryPath = (std::filesystem::temp_directory_path() / (enemyEvery ? "MapChipCsvBenchmarkEnemies.mapbin" : "MapChipCsvBenchmark.mapbin")).string();
+	MapChipField::BakeMapChipCsv(SyntheticCsv(enemyEvery), binaryPath);
+	const uint64_t fileSize = std::filesystem::file_size(binaryPath);
+
+	MapChipField field;
+	uint64_t allocations = 0;
+	for (auto _ : state) {
+		const uint64_t before = GetAllocationCount();
+		field.LoadMapChipBinary(binaryPath);
+		allocations += GetAllocationCount() - before;
+	}
+
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * fileSize));
+	state.counters["allocationsPerLoad"] = benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+	state.counters["enemies"] = static_cast<double>(field.GetEnemySpawns().size());
+}
+BENCHMARK(BM_MapChipLoadBinary)->ArgName("enemyEvery")->Arg(0)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+} // namespace
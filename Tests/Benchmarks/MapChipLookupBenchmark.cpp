@@ -0,0 +1,97 @@
+#include "MapChipField.h"
+#include "TestMapFile.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+// タイルを引く速さ。100 x 25（元の固定サイズ）と 10000 x 500 のマップで、
+// 1本の配列（範囲チェックあり / なし）と、元の行ごとの vector<vector> を比べる
+
+namespace {
+
+const uint32_t kLookupCount = 4096;
+
+// 幅 width、高さ height のマップ（約 1/4 がブロック）。大きさごとに1回だけ読み込む
+MapChipField& LookupMap(uint32_t width, uint32_t height) {
+	static MapChipField small;
+	static MapChipField large;
+	MapChipField& field = (width <= 100) ? small : large;
+	if (field.GetNumBlockHorizontal() == 0) {
+		const std::string csv = MakeMapCsv(width, height, [](uint32_t x, uint32_t y) { return ((x * 7 + y * 3) % 4 == 0) ? "1" : "0"; });
+		field.LoadMapChipCsv(WriteTemporaryFile("MapChipLookupBenchmark.csv", csv));
+	}
+	return field;
+}
+
+// 引くタイルの番号（ランダム。毎回同じ並び）
+std::vector<IndexSet> RandomIndices(uint32_t width, uint32_t height) {
+	std::mt19937 rng(1);
+	std::uniform_int_distribution<uint32_t> x(0, width - 1);
+	std::uniform_int_distribution<uint32_t> y(0, height - 1);
+	std::vector<IndexSet> indices(kLookupCount);
+	for (IndexSet& index : indices) {
+		index = {x(rng), y(rng)};
+	}
+	return indices;
+}
+
+void BM_MapChipLookup(benchmark::State& state) {
+	const uint32_t width = static_cast<uint32_t>(state.range(0));
+	const uint32_t height = static_cast<uint32_t>(state.range(1));
+	const MapChipField& field = LookupMap(width, height);
+	const std::vector<IndexSet> indices = RandomIndices(width, height);
+
+	for (auto _ : state) {
+		uint32_t blocks = 0;
+		for (const IndexSet& index : indices) {
+			blocks += field.GetMapChipTypeByIndex(index.xIndex, index.yIndex) == MapChipType::kBlock;
+		}
+		benchmark::DoNotOptimize(blocks);
+	}
+	state.SetItemsProcessed(state.iterations() * kLookupCount);
+}
+BENCHMARK(BM_MapChipLookup)->ArgNames({"width", "height"})->Args({100, 25})->Args({10000, 500});
+
+void BM_MapChipLookupUnchecked(benchmark::State& state) {
+	const uint32_t width = static_cast<uint32_t>(state.range(0));
+	const uint32_t height = static_cast<uint32_t>(state.range(1));
+	const MapChipField& field = LookupMap(width, height);
+	const std::vector<IndexSet> indices = RandomIndices(width, height);
+
+	for (auto _ : state) {
+		uint32_t blocks = 0;
+		for (const IndexSet& index : indices) {
+			blocks += field.GetMapChipTypeByIndexUnchecked(index.xIndex, index.yIndex) == MapChipType::kBlock;
+		}
+		benchmark::DoNotOptimize(blocks);
+	}
+	state.SetItemsProcessed(state.iterations() * kLookupCount);
+}
+BENCHMARK(BM_MapChipLookupUnchecked)->ArgNames({"width", "height"})->Args({100, 25})->Args({10000, 500});
+
+void BM_MapChipLookupRowVectors(benchmark::State& state) {
+	const uint32_t width = static_cast<uint32_t>(state.range(0));
+	const uint32_t height = static_cast<uint32_t>(state.range(1));
+	const MapChipField& field = LookupMap(width, height);
+	const std::vector<IndexSet> indices = RandomIndices(width, height);
+
+	// 元の持ち方（行ごとに別の vector）に写す
+	std::vector<std::vector<MapChipType>> rows(height, std::vector<MapChipType>(width));
+	for (uint32_t y = 0; y < height; ++y) {
+		for (uint32_t x = 0; x < width; ++x) {
+			rows[y][x] = field.GetMapChipTypeByIndexUnchecked(x, y);
+		}
+	}
+
+	for (auto _ : state) {
+		uint32_t blocks = 0;
+		for (const IndexSet& index : indices) {
+			blocks += rows[index.yIndex][index.xIndex] == MapChipType::kBlock;
+		}
+		benchmark::DoNotOptimize(blocks);
+	}
+	state.SetItemsProcessed(state.iterations() * kLookupCount);
+}
+BENCHMARK(BM_MapChipLookupRowVectors)->ArgNames({"width", "height"})->Args({100, 25})->Args({10000, 500});
+
+} // namespace
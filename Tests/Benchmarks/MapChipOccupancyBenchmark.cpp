@@ -0,0 +1,92 @@
+#include "MapChipField.h"
+#include "TestMapFile.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+// 「範囲にブロックが無いか」の問い合わせ。占有ピラミッドと、範囲のタイルを1つずつ見るやり方の比較
+// （10000 x 500 のまばらなマップで、ランダムな位置の範囲を問い合わせる。ブロックの密度は 0.01% と 0.3% の2通り）
+
+namespace {
+
+// 10000 x 500 のマップ。下3段は地面、それ以外は 10000 タイルあたり perTenThousand 個のブロック
+const uint32_t kMapWidth = 10000;
+const uint32_t kMapHeight = 500;
+
+MapChipField& SparseMap(uint32_t perTenThousand) {
+	static MapChipField sparse;
+	static MapChipField dense;
+	MapChipField& field = (perTenThousand <= 1) ? sparse : dense;
+	if (field.GetNumBlockHorizontal() == 0) {
+		const std::string csv = MakeMapCsv(kMapWidth, kMapHeight, [perTenThousand](uint32_t x, uint32_t y) {
+			const bool ground = y >= kMapHeight - 3;
+			const bool block = (x * 2654435761u ^ y * 40503u) % 10000 < perTenThousand;
+			return (ground || block) ? "1" : "0";
+		});
+		field.LoadMapChipCsv(WriteTemporaryFile("MapChipOccupancyBenchmark.csv", csv));
+	}
+	return field;
+}
+
+// 問い合わせる範囲（左上と右下。毎回同じ並び）
+struct Region {
+	uint32_t x0, y0, x1, y1;
+};
+
+std::vector<Region> RandomRegions(uint32_t width, uint32_t height) {
+	std::mt19937 rng(7);
+	std::uniform_int_distribution<uint32_t> x(0, kMapWidth - width);
+	std::uniform_int_distribution<uint32_t> y(0, kMapHeight - height);
+	std::vector<Region> regions(1024);
+	for (Region& region : regions) {
+		region.x0 = x(rng);
+		region.y0 = y(rng);
+		region.x1 = region.x0 + width - 1;
+		region.y1 = region.y0 + height - 1;
+	}
+	return regions;
+}
+
+void BM_RegionEmptyPyramid(benchmark::State& state) {
+	const MapChipField& field = SparseMap(static_cast<uint32_t>(state.range(0)));
+	const std::vector<Region> regions = RandomRegions(static_cast<uint32_t>(state.range(1)), static_cast<uint32_t>(state.range(2)));
+
+	size_t n = 0;
+	uint64_t empty = 0;
+	for (auto _ : state) {
+		const Region& r = regions[n++ % regions.size()];
+		empty += field.IsRegionEmpty(r.x0, r.y0, r.x1, r.y1);
+	}
+
+	state.SetItemsProcessed(state.iterations());
+	state.counters["emptyRate"] = benchmark::Counter(static_cast<double>(empty), benchmark::Counter::kAvgIterations);
+}
+// ブロックの密度（10000 タイルあたり）と、範囲の横と縦のタイル数（プレイヤーの通過帯、画面の半分、画面の数枚分）
+BENCHMARK(BM_RegionEmptyPyramid)->ArgNames({"perTenThousand", "width", "height"})->ArgsProduct({{1, 30}, {2}, {6}})->ArgsProduct({{1, 30}, {64}, {32}})->ArgsProduct({{1, 30}, {512}, {128}});
+
+void BM_RegionEmptyFlatScan(benchmark::State& state) {
+	const MapChipField& field = SparseMap(static_cast<uint32_t>(state.range(0)));
+	const std::vector<Region> regions = RandomRegions(static_cast<uint32_t>(state.range(1)), static_cast<uint32_t>(state.range(2)));
+
+	size_t n = 0;
+	uint64_t empty = 0;
+	for (auto _ : state) {
+		const Region& r = regions[n++ % regions.size()];
+		bool found = false;
+		for (uint32_t y = r.y0; y <= r.y1 && !found; ++y) {
+			for (uint32_t x = r.x0; x <= r.x1; ++x) {
+				if (field.GetMapChipTypeByIndexUnchecked(x, y) == MapChipType::kBlock) {
+					found = true;
+					break;
+				}
+			}
+		}
+		empty += !found;
+	}
+
+	state.SetItemsProcessed(state.iterations());
+	state.counters["emptyRate"] = benchmark::Counter(static_cast<double>(empty), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_RegionEmptyFlatScan)->ArgNames({"perTenThousand", "width", "height"})->ArgsProduct({{1, 30}, {2}, {6}})->ArgsProduct({{1, 30}, {64}, {32}})->ArgsProduct({{1, 30}, {512}, {128}});
+
+} // namespace
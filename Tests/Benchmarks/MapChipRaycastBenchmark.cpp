@@ -0,0 +1,89 @@
+#include "MapChipField.h"
+#include "TestMapFile.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+// 1秒あたりに撃てるレイの本数。DDA の Raycast と、タイルの 1/10 ずつ点を進めて1点ずつ調べるやり方の比較
+// （ブロックがまばらなマップで、ランダムな位置と向きから最大 64 のレイを撃つ）
+
+namespace {
+
+// 1000 x 200 のマップ。下3段は地面、それ以外に約 2% のブロック
+const uint32_t kMapWidth = 1000;
+const uint32_t kMapHeight = 200;
+const float kMaxDistance = 64.0f;
+
+MapChipField& RaycastMap() {
+	static MapChipField field;
+	if (field.GetNumBlockHorizontal() == 0) {
+		const std::string csv = MakeMapCsv(kMapWidth, kMapHeight, [](uint32_t x, uint32_t y) { return (y >= kMapHeight - 3 || (x * 131 + y * 71) % 50 == 0) ? "1" : "0"; });
+		field.LoadMapChipCsv(WriteTemporaryFile("MapChipRaycastBenchmark.csv", csv));
+	}
+	return field;
+}
+
+// レイの始点と向き（毎回同じ並び）
+struct Ray {
+	KamataEngine::Vector3 origin;
+	KamataEngine::Vector3 direction;
+};
+
+const std::vector<Ray>& RandomRays() {
+	static std::vector<Ray> rays;
+	if (rays.empty()) {
+		std::mt19937 rng(5);
+		std::uniform_real_distribution<float> x(0.0f, kMapWidth * MapChipField::kBlockWidth);
+		std::uniform_real_distribution<float> y(0.0f, kMapHeight * MapChipField::kBlockHeight);
+		std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+		rays.resize(4096);
+		for (Ray& ray : rays) {
+			const float a = angle(rng);
+			ray = {
+			    {x(rng), y(rng), 0.0f},
+                {std::cos(a), std::sin(a), 0.0f}
+            };
+		}
+	}
+	return rays;
+}
+
+void BM_MapChipRaycast(benchmark::State& state) {
+	const MapChipField& field = RaycastMap();
+	const std::vector<Ray>& rays = RandomRays();
+
+	size_t n = 0;
+	uint64_t hits = 0;
+	for (auto _ : state) {
+		const Ray& ray = rays[n++ % rays.size()];
+		MapChipRaycastHit hit;
+		hits += field.Raycast(ray.origin, ray.direction, kMaxDistance, hit);
+		benchmark::DoNotOptimize(hit);
+	}
+
+	state.SetItemsProcessed(state.iterations());
+	state.counters["hitRate"] = benchmark::Counter(static_cast<double>(hits), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_MapChipRaycast);
+
+void BM_MapChipRaycastFineStep(benchmark::State& state) {
+	const MapChipField& field = RaycastMap();
+	const std::vector<Ray>& rays = RandomRays();
+	const float step = MapChipField::kBlockWidth / 10.0f;
+
+	size_t n = 0;
+	uint64_t hits = 0;
+	for (auto _ : state) {
+		const Ray& ray = rays[n++ % rays.size()];
+		IndexSet index;
+		float distance = 0.0f;
+		hits += MarchToFirstBlock(field, ray.origin, ray.direction, kMaxDistance, step, index, distance);
+		benchmark::DoNotOptimize(distance);
+	}
+
+	state.SetItemsProcessed(state.iterations());
+	state.counters["hitRate"] = benchmark::Counter(static_cast<double>(hits), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_MapChipRaycastFineStep);
+
+} // namespace
@@ -0,0 +1,99 @@
+#include "MapChipField.h"
+#include "TestMapFile.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+// 距離場を使った SphereTrace と、弾と同じ 0.6 ずつ点を進めて1点ずつタイルを調べるやり方の比較
+// （10000 x 256 のまばらなマップで、ランダムな位置と向きから最大 128 のレイを撃つ。
+//  どちらも Raycast と同じタイルに当たったかを数え、点を進めるやり方が角を見落とす分をカウンタで出す）
+
+namespace {
+
+const uint32_t kMapWidth = 10000;
+const uint32_t kMapHeight = 256;
+const float kMaxDistance = 128.0f;
+
+// 下3段は地面、それ以外は 10000 タイルあたり perTenThousand 個のブロック
+MapChipField& TraceMap(uint32_t perTenThousand) {
+	static MapChipField sparse;
+	static MapChipField dense;
+	MapChipField& field = (perTenThousand <= 1) ? sparse : dense;
+	if (field.GetNumBlockHorizontal() == 0) {
+		const std::string csv = MakeMapCsv(kMapWidth, kMapHeight, [perTenThousand](uint32_t x, uint32_t y) {
+			const bool ground = y >= kMapHeight - 3;
+			const bool block = (x * 2654435761u ^ y * 40503u) % 10000 < perTenThousand;
+			return (ground || block) ? "1" : "0";
+		});
+		field.LoadMapChipCsv(WriteTemporaryFile("MapChipSphereTraceBenchmark.csv", csv));
+	}
+	return field;
+}
+
+// レイと、Raycast で求めた正解
+struct TracedRay {
+	KamataEngine::Vector3 origin;
+	KamataEngine::Vector3 direction;
+	bool hit;
+	IndexSet index;
+};
+
+std::vector<TracedRay> RandomRays(const MapChipField& field) {
+	std::mt19937 rng(9);
+	std::uniform_real_distribution<float> x(0.0f, kMapWidth * MapChipField::kBlockWidth);
+	std::uniform_real_distribution<float> y(0.0f, kMapHeight * MapChipField::kBlockHeight);
+	std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+	std::vector<TracedRay> rays(2048);
+	for (TracedRay& ray : rays) {
+		const float a = angle(rng);
+		ray.origin = {x(rng), y(rng), 0.0f};
+		ray.direction = {std::cos(a), std::sin(a), 0.0f};
+		MapChipRaycastHit hit;
+		ray.hit = field.Raycast(ray.origin, ray.direction, kMaxDistance, hit);
+		ray.index = hit.index;
+	}
+	return rays;
+}
+
+// Raycast と当たり外れ、当たったタイルが一致するか
+bool SameHit(const TracedRay& ray, bool hit, const IndexSet& index) { return hit == ray.hit && (!hit || (index.xIndex == ray.index.xIndex && index.yIndex == ray.index.yIndex)); }
+
+void BM_SphereTrace(benchmark::State& state) {
+	const MapChipField& field = TraceMap(static_cast<uint32_t>(state.range(0)));
+	const std::vector<TracedRay> rays = RandomRays(field);
+
+	size_t n = 0;
+	uint64_t mismatches = 0;
+	for (auto _ : state) {
+		const TracedRay& ray = rays[n++ % rays.size()];
+		MapChipRaycastHit hit;
+		const bool found = field.SphereTrace(ray.origin, ray.direction, kMaxDistance, hit);
+		mismatches += !SameHit(ray, found, hit.index);
+	}
+
+	state.SetItemsProcessed(state.iterations());
+	state.counters["mismatchRate"] = benchmark::Counter(static_cast<double>(mismatches), benchmark::Counter::kAvgIterations);
+}
+// ブロックの密度（10000 タイルあたり）
+BENCHMARK(BM_SphereTrace)->ArgName("perTenThousand")->Arg(1)->Arg(30);
+
+void BM_StepSampling(benchmark::State& state) {
+	const MapChipField& field = TraceMap(static_cast<uint32_t>(state.range(0)));
+	const std::vector<TracedRay> rays = RandomRays(field);
+
+	size_t n = 0;
+	uint64_t mismatches = 0;
+	for (auto _ : state) {
+		const TracedRay& ray = rays[n++ % rays.size()];
+		IndexSet index;
+		float distance = 0.0f;
+		const bool found = MarchToFirstBlock(field, ray.origin, ray.direction, kMaxDistance, 0.6f, index, distance);
+		mismatches += !SameHit(ray, found, index);
+	}
+
+	state.SetItemsProcessed(state.iterations());
+	state.counters["mismatchRate"] = benchmark::Counter(static_cast<double>(mismatches), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_StepSampling)->ArgName("perTenThousand")->Arg(1)->Arg(30);
+
+} // namespace
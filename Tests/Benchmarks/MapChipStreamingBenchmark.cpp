@@ -0,0 +1,59 @@
+#include "MapChipField.h"
+#include "TestMapFile.h"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+
+// 10000 x 500 のマップをカメラの注視点が右へ進む想定でストリーミングしたときの1フレーム
+// （常駐チャンク数・読み込み待ち・読み込み時間をカウンタで出す。ImGui が無くても確認できるように）
+
+namespace {
+
+// 10000 x 500 のマップ。下3段は地面、32 列ごとに柱を立てる
+const uint32_t kMapWidth = 10000;
+const uint32_t kMapHeight = 500;
+
+// 焼き込んだバイナリのパス（初回に CSV から焼き込む）
+const std::string& StreamingMapBinary() {
+	static std::string binaryPath;
+	if (binaryPath.empty()) {
+		const std::string csv = MakeMapCsv(kMapWidth, kMapHeight, [](uint32_t x, uint32_t y) { return (y >= kMapHeight - 3 || (x % 32 == 0 && y >= kMapHeight - 8)) ? "1" : "0"; });
+		const std::string csvPath = WriteTemporaryFile("MapChipStreamingBenchmark.csv", csv);
+		binaryPath = (std::filesystem::temp_directory_path() / "MapChipStreamingBenchmark.mapbin").string();
+		MapChipField::BakeMapChipCsv(csvPath, binaryPath);
+	}
+	return binaryPath;
+}
+
+void BM_MapChipStreamingFrame(benchmark::State& state) {
+	const float speed = static_cast<float>(state.range(0)) / 10.0f;
+
+	MapChipField field;
+	field.LoadMapChip(StreamingMapBinary(), "", true);
+
+	// 注視点はマップの下の方を右へ進み、右端まで行ったら左端に戻る
+	const float mapRight = static_cast<float>(kMapWidth) * MapChipField::kBlockWidth;
+	KamataEngine::Vector3 target = field.GetMapChipPositionByIndex(0, kMapHeight - 12);
+	uint64_t resident = 0;
+	uint64_t pending = 0;
+	for (auto _ : state) {
+		field.UpdateStreaming(target);
+		resident += field.GetStreamingStats().residentChunks;
+		pending += field.GetStreamingStats().pendingChunks;
+
+		target.x += speed;
+		if (target.x > mapRight) {
+			target.x = 0.0f;
+		}
+	}
+
+	const MapChipStreamingStats& stats = field.GetStreamingStats();
+	state.counters["residentPerFrame"] = benchmark::Counter(static_cast<double>(resident), benchmark::Counter::kAvgIterations);
+	state.counters["pendingPerFrame"] = benchmark::Counter(static_cast<double>(pending), benchmark::Counter::kAvgIterations);
+	state.counters["loadedChunks"] = static_cast<double>(stats.loadedChunksTotal);
+	state.counters["discardedChunks"] = static_cast<double>(stats.discardedChunksTotal);
+	state.counters["loadLatencyMs"] = stats.averageLoadLatencyMs;
+}
+// 注視点の速さ（1フレームあたり、0.1 単位）
+BENCHMARK(BM_MapChipStreamingFrame)->ArgName("speedx10")->Arg(5)->Arg(50)->Arg(500);
+
+} // namespace
@@ -0,0 +1,183 @@
+#include "MapChipField.h"
+#include "TestMapFile.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+// プレイヤーとマップの当たり。SweepAABB と、元の Player の4方向の角の判定（CollisionDetectionUp/Down/Right/Left）の比較
+// 1フレームに1回の移動を1回の判定とし、タイルへの問い合わせ回数と、移動後にブロックへめり込んだ回数をカウンタで出す
+
+namespace {
+
+// 1000 x 25 のマップ。下3段は地面、ところどころに足場と柱
+const uint32_t kMapWidth = 1000;
+const uint32_t kMapHeight = 25;
+
+// Player と同じ当たり判定の大きさと隙間
+const float kWidth = 1.99f;
+const float kHeight = 1.99f;
+const float kBlank = 0.001f;
+
+MapChipField& SweepMap() {
+	static MapChipField field;
+	if (field.GetNumBlockHorizontal() == 0) {
+		const std::string csv = MakeMapCsv(kMapWidth, kMapHeight, [](uint32_t x, uint32_t y) {
+			const bool ground = y >= kMapHeight - 3;
+			const bool platform = (y == 14 || y == 8) && (x / 6) % 3 == 0;
+			const bool pillar = x % 23 == 0 && y >= 16;
+			return (ground || platform || pillar) ? "1" : "0";
+		});
+		field.LoadMapChipCsv(WriteTemporaryFile("MapChipSweepBenchmark.csv", csv));
+	}
+	return field;
+}
+
+// 移動の始点と移動量（始点はブロックに掛からない位置。毎回同じ並び）
+struct Move {
+	KamataEngine::Vector3 position;
+	KamataEngine::Vector3 velocity;
+};
+
+std::vector<Move> RandomMoves(MapChipField& field, float maxSpeed) {
+	std::mt19937 rng(6);
+	std::uniform_int_distribution<uint32_t> tileX(1, kMapWidth - 2);
+	std::uniform_int_distribution<uint32_t> tileY(1, kMapHeight - 4);
+	std::uniform_real_distribution<float> speed(-maxSpeed, maxSpeed);
+	std::vector<Move> moves;
+	while (moves.size() < 4096) {
+		const uint32_t x = tileX(rng);
+		const uint32_t y = tileY(rng);
+		if (field.GetMapChipTypeByIndex(x, y) == MapChipType::kBlock) {
+			continue;
+		}
+		moves.push_back({field.GetMapChipPositionByIndex(x, y), {speed(rng), speed(rng), 0.0f}});
+	}
+	return moves;
+}
+
+// 中心 center の箱がブロックに掛かっているか
+bool Overlaps(const MapChipField& field, const KamataEngine::Vector3& center) {
+	const int64_t height = field.GetNumBlockVirtical();
+	auto cell = [](float v) { return static_cast<int64_t>(std::floor((v + MapChipField::kBlockWidth / 2.0f) / MapChipField::kBlockWidth)); };
+	for (int64_t cy = cell(center.y - kHeight / 2.0f + 0.01f); cy <= cell(center.y + kHeight / 2.0f - 0.01f); ++cy) {
+		for (int64_t cx = cell(center.x - kWidth / 2.0f + 0.01f); cx <= cell(center.x + kWidth / 2.0f - 0.01f); ++cx) {
+			if (cx >= 0 && cy >= 0 && cy < height && field.GetMapChipTypeByIndex(static_cast<uint32_t>(cx), static_cast<uint32_t>(height - 1 - cy)) == MapChipType::kBlock) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+// 切り詰めた移動量で動かした箱がブロックに掛かった割合（計測の後で調べる。問い合わせ回数には数えない）
+double OverlapRate(const MapChipField& field, const std::vector<Move>& moves, const std::vector<KamataEngine::Vector3>& velocities, size_t count) {
+	uint32_t overlaps = 0;
+	for (size_t i = 0; i < count; ++i) {
+		overlaps += Overlaps(field, moves[i].position + velocities[i]);
+	}
+	return count ? static_cast<double>(overlaps) / static_cast<double>(count) : 0.0;
+}
+
+/// <summary>
+/// 元の Player の角の判定（上・下・右・左の順に、移動後の2つの角とその隣のタイルを見る）
+/// </summary>
+class CornerCollision {
+public:
+	explicit CornerCollision(MapChipField& field) : field_(field) {}
+
+	// 移動量を切り詰めて返す
+	KamataEngine::Vector3 Resolve(const KamataEngine::Vector3& position, KamataEngine::Vector3 velocity) {
+		// 上
+		if (velocity.y >= 0.0f && (CornerHit(position + velocity + KamataEngine::Vector3(-kWidth / 2.0f, kHeight / 2.0f, 0), 0, 1) ||
+		                           CornerHit(position + velocity + KamataEngine::Vector3(kWidth / 2.0f, kHeight / 2.0f, 0), 0, 1))) {
+			const IndexSet next = IndexOf(position + velocity + KamataEngine::Vector3(0, kHeight / 2.0f, 0));
+			const IndexSet now = IndexOf(position + KamataEngine::Vector3(0, kHeight / 2.0f, 0));
+			if (now.yIndex != next.yIndex) {
+				velocity.y = std::max(0.0f, field_.GetRectIndex(next.xIndex, next.yIndex).bottom - position.y - (kHeight / 2.0f + kBlank));
+			}
+		}
+		// 下
+		if (velocity.y < 0.0f && (CornerHit(position + velocity + KamataEngine::Vector3(-kWidth / 2.0f, -kHeight / 2.0f, 0), 0, -1) ||
+		                          CornerHit(position + velocity + KamataEngine::Vector3(kWidth / 2.0f, -kHeight / 2.0f, 0), 0, -1))) {
+			const IndexSet next = IndexOf(position + velocity + KamataEngine::Vector3(0, -kHeight / 2.0f, 0));
+			const IndexSet now = IndexOf(position + KamataEngine::Vector3(0, -kHeight / 2.0f, 0));
+			if (now.yIndex != next.yIndex) {
+				velocity.y = std::min(0.0f, field_.GetRectIndex(next.xIndex, next.yIndex).top - position.y + (kHeight / 2.0f + kBlank));
+			}
+		}
+		// 右
+		if (velocity.x > 0.0f && (CornerHit(position + velocity + KamataEngine::Vector3(kWidth / 2.0f, kHeight / 2.0f, 0), -1, 0) ||
+		                          CornerHit(position + velocity + KamataEngine::Vector3(kWidth / 2.0f, -kHeight / 2.0f, 0), -1, 0))) {
+			const IndexSet next = IndexOf(position + velocity + KamataEngine::Vector3(kWidth / 2.0f, 0, 0));
+			velocity.x = std::max(0.0f, field_.GetRectIndex(next.xIndex, next.yIndex).left - position.x - (kWidth / 2.0f + kBlank));
+		}
+		// 左
+		if (velocity.x < 0.0f && (CornerHit(position + velocity + KamataEngine::Vector3(-kWidth / 2.0f, kHeight / 2.0f, 0), 1, 0) ||
+		                          CornerHit(position + velocity + KamataEngine::Vector3(-kWidth / 2.0f, -kHeight / 2.0f, 0), 1, 0))) {
+			const IndexSet next = IndexOf(position + velocity + KamataEngine::Vector3(-kWidth / 2.0f, 0, 0));
+			velocity.x = std::min(0.0f, field_.GetRectIndex(next.xIndex, next.yIndex).right - position.x + (kWidth / 2.0f + kBlank));
+		}
+		return velocity;
+	}
+
+	// 問い合わせ回数（座標からタイル番号への変換とタイルの読み出しの合計）
+	uint64_t queries = 0;
+
+private:
+	IndexSet IndexOf(const KamataEngine::Vector3& position) {
+		++queries;
+		return field_.GetMapChipIndexSetByPosition(position);
+	}
+
+	// 角のタイルがブロックで、その（めり込みを戻す向きの）隣がブロックでないか
+	bool CornerHit(const KamataEngine::Vector3& corner, int32_t dx, int32_t dy) {
+		const IndexSet index = IndexOf(corner);
+		queries += 2;
+		return field_.GetMapChipTypeByIndex(index.xIndex, index.yIndex) == MapChipType::kBlock &&
+		       field_.GetMapChipTypeByIndex(index.xIndex + dx, index.yIndex - dy) != MapChipType::kBlock;
+	}
+
+	MapChipField& field_;
+};
+
+void BM_PlayerSweepAABB(benchmark::State& state) {
+	MapChipField& field = SweepMap();
+	const std::vector<Move> moves = RandomMoves(field, static_cast<float>(state.range(0)));
+	std::vector<KamataEngine::Vector3> velocities(moves.size());
+
+	size_t n = 0;
+	uint64_t queries = 0;
+	for (auto _ : state) {
+		const size_t i = n++ % moves.size();
+		const Move& move = moves[i];
+		const AABB box = {move.position - KamataEngine::Vector3(kWidth / 2.0f, kHeight / 2.0f, 0.0f), move.position + KamataEngine::Vector3(kWidth / 2.0f, kHeight / 2.0f, 0.0f)};
+		const MapChipSweepResult sweep = field.SweepAABB(box, move.velocity, kBlank);
+		queries += sweep.tileQueries;
+		velocities[i] = sweep.velocity;
+	}
+
+	state.counters["queriesPerFrame"] = benchmark::Counter(static_cast<double>(queries), benchmark::Counter::kAvgIterations);
+	state.counters["overlapRate"] = OverlapRate(field, moves, velocities, std::min(n, moves.size()));
+}
+// maxSpeed: 1フレームの移動量の上限（ワイヤーで引っ張られる速さまで）
+BENCHMARK(BM_PlayerSweepAABB)->ArgName("maxSpeed")->Arg(1)->Arg(10);
+
+void BM_PlayerCornerChecks(benchmark::State& state) {
+	MapChipField& field = SweepMap();
+	const std::vector<Move> moves = RandomMoves(field, static_cast<float>(state.range(0)));
+	std::vector<KamataEngine::Vector3> velocities(moves.size());
+
+	CornerCollision corners(field);
+	size_t n = 0;
+	for (auto _ : state) {
+		const size_t i = n++ % moves.size();
+		velocities[i] = corners.Resolve(moves[i].position, moves[i].velocity);
+	}
+
+	state.counters["queriesPerFrame"] = benchmark::Counter(static_cast<double>(corners.queries), benchmark::Counter::kAvgIterations);
+	state.counters["overlapRate"] = OverlapRate(field, moves, velocities, std::min(n, moves.size()));
+}
+BENCHMARK(BM_PlayerCornerChecks)->ArgName("maxSpeed")->Arg(1)->Arg(10);
+
+} // namespace
@@ -0,0 +1,156 @@
+#include "AllocationCounter.h"
+#include "ProjectileSystem.h"
+#include "WireRenderer.h"
+#include <benchmark/benchmark.h>
+#include <list>
+
+// 撃ち続けながらワイヤーも使うときの、ヒープ確保の回数
+// 60 秒（3600 フレーム）を1回とし、shotInterval フレームごとに1発、90 フレームごとにワイヤーを撃つ
+// （フックは 20 フレーム飛んで刺さり、鎖を並べてから 40 フレームかけて引き寄せる）
+// 弾を ProjectileSystem と WireRenderer に持つ今のやり方と、1発ずつ new して std::list に入れる元のやり方の比較
+
+namespace {
+
+const uint32_t kFramesPerSession = 3600;
+const uint32_t kWireInterval = 90;
+const uint32_t kHookFlightFrames = 20;
+const uint32_t kPullFrames = 40;
+
+// ワイヤーの鎖の長さと間隔（Player の既定の射程と鎖の間隔）
+const float kWireLength = 25.0f;
+const float kWireSegmentSpacing = 0.9f;
+
+// 元のやり方の弾（1発ごとに new していた Bullet の中身に近い大きさ）
+struct HeapBullet {
+	KamataEngine::Vector3 position;
+	KamataEngine::Vector3 velocity;
+	KamataEngine::Vector3 scale;
+	KamataEngine::Matrix4x4 matWorld;
+	float lifeTime = ProjectileSystem::kLifeTime;
+	bool persistent = false;
+	bool dead = false;
+};
+
+void BM_SustainedFireProjectileSystem(benchmark::State& state) {
+	const uint32_t shotInterval = static_cast<uint32_t>(state.range(0));
+
+	KamataEngine::Model model;
+	ProjectileSystem projectiles;
+	// Player と同じ容量
+	projectiles.Initialize(256);
+	WireRenderer chain;
+	chain.Initialize(static_cast<uint32_t>(kWireLength / kWireSegmentSpacing) + 2);
+
+	uint64_t allocations = 0;
+	for (auto _ : state) {
+		const uint64_t before = GetAllocationCount();
+		Bullet hook;
+		for (uint32_t frame = 0; frame < kFramesPerSession; ++frame) {
+			if (frame % shotInterval == 0) {
+				projectiles.Spawn(&model, {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f});
+			}
+
+			// ワイヤー：撃つ → 刺さったら鎖を並べる → 引き寄せながら外す → 消す
+			const uint32_t wireFrame = frame % kWireInterval;
+			if (wireFrame == 0) {
+				hook = projectiles.Spawn(&model, {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f});
+				if (hook.IsValid()) {
+					hook.SetPersistent(true);
+					hook.SetSwept(true);
+				}
+			} else if (wireFrame == kHookFlightFrames && hook.IsValid()) {
+				hook.SetVelocity({0.0f, 0.0f, 0.0f});
+				chain.Build({0.0f, 0.0f, 0.0f}, {kWireLength, 0.0f, 0.0f}, kWireSegmentSpacing);
+			} else if (wireFrame > kHookFlightFrames && wireFrame <= kHookFlightFrames + kPullFrames) {
+				chain.PopFront();
+			} else if (wireFrame == kHookFlightFrames + kPullFrames + 1 && hook.IsValid()) {
+				hook.Kill();
+				hook = {};
+				chain.Clear();
+			}
+
+			projectiles.Update();
+			projectiles.ReleaseDead();
+		}
+		projectiles.ReleaseAll();
+		chain.Clear();
+		allocations += GetAllocationCount() - before;
+	}
+
+	state.counters["allocationsPerSession"] = benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+	state.counters["peakActive"] = static_cast<double>(projectiles.GetStats().peakActiveCount);
+	state.counters["failedSpawnsPerSession"] = benchmark::Counter(static_cast<double>(projectiles.GetStats().failedSpawnCount), benchmark::Counter::kAvgIterations);
+}
+// shotInterval: 何フレームごとに1発撃つか（0.3 秒ごとと、毎フレーム）
+BENCHMARK(BM_SustainedFireProjectileSystem)->ArgName("shotInterval")->Arg(18)->Arg(1)->Unit(benchmark::kMillisecond);
+
+void BM_SustainedFireHeapList(benchmark::State& state) {
+	const uint32_t shotInterval = static_cast<uint32_t>(state.range(0));
+	const uint32_t segmentCount = static_cast<uint32_t>(kWireLength / kWireSegmentSpacing);
+
+	uint64_t allocations = 0;
+	size_t peakActive = 0;
+	for (auto _ : state) {
+		const uint64_t before = GetAllocationCount();
+		std::list<HeapBullet*> bullets;
+		std::list<HeapBullet*> wireBullets;
+		for (uint32_t frame = 0; frame < kFramesPerSession; ++frame) {
+			if (frame % shotInterval == 0) {
+				HeapBullet* bullet = new HeapBullet;
+				bullet->velocity = {ProjectileSystem::kBulletSpeed, 0.0f, 0.0f};
+				bullets.push_back(bullet);
+			}
+
+			// ワイヤー：フックと鎖のセグメントを1つずつ new し、引き寄せながら先頭から消す
+			const uint32_t wireFrame = frame % kWireInterval;
+			if (wireFrame == 0) {
+				HeapBullet* hook = new HeapBullet;
+				hook->persistent = true;
+				wireBullets.push_back(hook);
+			} else if (wireFrame == kHookFlightFrames) {
+				for (uint32_t i = 0; i < segmentCount; ++i) {
+					HeapBullet* segment = new HeapBullet;
+					segment->persistent = true;
+					segment->position = {static_cast<float>(i) * kWireSegmentSpacing, 0.0f, 0.0f};
+					wireBullets.push_front(segment);
+				}
+			} else if (wireFrame > kHookFlightFrames && wireFrame <= kHookFlightFrames + kPullFrames && wireBullets.size() > 1) {
+				delete wireBullets.front();
+				wireBullets.pop_front();
+			} else if (wireFrame == kHookFlightFrames + kPullFrames + 1) {
+				for (HeapBullet* bullet : wireBullets) {
+					delete bullet;
+				}
+				wireBullets.clear();
+			}
+
+			// 更新と、寿命が尽きた弾の削除
+			for (HeapBullet* bullet : bullets) {
+				bullet->position.x += bullet->velocity.x;
+				bullet->lifeTime -= ProjectileSystem::kLifeDecay;
+				bullet->dead = bullet->lifeTime <= 0.0f;
+			}
+			bullets.remove_if([](HeapBullet* bullet) {
+				if (bullet->dead) {
+					delete bullet;
+					return true;
+				}
+				return false;
+			});
+			peakActive = std::max(peakActive, bullets.size() + wireBullets.size());
+		}
+		for (HeapBullet* bullet : bullets) {
+			delete bullet;
+		}
+		for (HeapBullet* bullet : wireBullets) {
+			delete bullet;
+		}
+		allocations += GetAllocationCount() - before;
+	}
+
+	state.counters["allocationsPerSession"] = benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+	state.counters["peakActive"] = static_cast<double>(peakActive);
+}
+BENCHMARK(BM_SustainedFireHeapList)->ArgName("shotInterval")->Arg(18)->Arg(1)->Unit(benchmark::kMillisecond);
+
+} // namespace
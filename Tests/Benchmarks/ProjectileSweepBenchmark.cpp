@@ -0,0 +1,64 @@
+#include "ProjectileSystem.h"
+#include "TestMapFile.h"
+#include <benchmark/benchmark.h>
+#include <random>
+
+// 100k 発の弾の1フレームの更新。終点だけを調べる既定のやり方と、移動した線分を辿る SetSwept の比較
+// （ブロックがまばらなマップにランダムな向きで撃ち、消えた弾はそのフレームのうちに撃ち直して数を保つ）
+
+namespace {
+
+// 2000 x 500 のマップに約 2% のブロック
+const uint32_t kMapWidth = 2000;
+const uint32_t kMapHeight = 500;
+const uint32_t kProjectileCount = 100000;
+
+MapChipField& SweepMap() {
+	static MapChipField field;
+	if (field.GetNumBlockHorizontal() == 0) {
+		const std::string csv = MakeMapCsv(kMapWidth, kMapHeight, [](uint32_t x, uint32_t y) { return ((x * 131 + y * 71) % 50 == 0) ? "1" : "0"; });
+		field.LoadMapChipCsv(WriteTemporaryFile("ProjectileSweepBenchmark.csv", csv));
+	}
+	return field;
+}
+
+void BM_ProjectileUpdate(benchmark::State& state) {
+	const bool swept = state.range(0) != 0;
+	const float speed = static_cast<float>(state.range(1)) / 10.0f;
+
+	ProjectileSystem projectiles;
+	projectiles.Initialize(kProjectileCount);
+	projectiles.SetMapChipField(&SweepMap());
+
+	KamataEngine::Model model;
+	std::mt19937 rng(19);
+	std::uniform_real_distribution<float> x(0.0f, kMapWidth * MapChipField::kBlockWidth);
+	std::uniform_real_distribution<float> y(0.0f, kMapHeight * MapChipField::kBlockHeight);
+	std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+	auto refill = [&]() {
+		while (projectiles.GetActiveCount() < kProjectileCount) {
+			const float a = angle(rng);
+			const KamataEngine::Vector3 direction = {std::cos(a), std::sin(a), 0.0f};
+			Bullet bullet = projectiles.Spawn(&model, {x(rng), y(rng), 0.0f}, direction);
+			bullet.SetVelocity({direction.x * speed, direction.y * speed, 0.0f});
+			bullet.SetSwept(swept);
+		}
+	};
+
+	refill();
+	uint64_t sweptTests = 0;
+	for (auto _ : state) {
+		projectiles.Update();
+		sweptTests += projectiles.GetStats().sweptTests;
+		projectiles.ReleaseDead();
+		refill();
+	}
+
+	state.SetItemsProcessed(state.iterations() * kProjectileCount);
+	state.counters["sweptPerFrame"] = benchmark::Counter(static_cast<double>(sweptTests), benchmark::Counter::kAvgIterations);
+	state.counters["respawnedPerFrame"] = benchmark::Counter(static_cast<double>(projectiles.GetStats().spawnCount - kProjectileCount), benchmark::Counter::kAvgIterations);
+}
+// swept: 0 なら終点だけ、1 なら線分を辿る / speedx10: 1フレームに進む距離（0.1 単位）
+BENCHMARK(BM_ProjectileUpdate)->ArgNames({"swept", "speedx10"})->ArgsProduct({{0, 1}, {6, 100}})->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,115 @@
+#include "SlotMap.h"
+#include <benchmark/benchmark.h>
+#include <list>
+#include <memory>
+#include <random>
+#include <vector>
+
+// スロットマップで詰めて並べた中身の走査と、ハンドル経由の走査、ポインタのリストの走査の比較
+
+namespace {
+
+// 1体分の中身（位置と速度）
+struct Body {
+	float x = 0.0f;
+	float y = 0.0f;
+	float vx = 0.0f;
+	float vy = 0.0f;
+};
+
+// 出し入れを繰り返した後の、詰めた並びとハンドルとポインタのリスト
+struct ChurnedPool {
+	SlotMap slots;
+	std::vector<Body> bodies;
+	std::vector<SlotHandle> handles;
+	std::list<std::unique_ptr<Body>> list;
+
+	explicit ChurnedPool(uint32_t capacity) {
+		slots.Initialize(capacity);
+		bodies.resize(capacity);
+
+		std::mt19937 rng(42);
+		std::vector<SlotHandle> alive;
+		std::vector<std::list<std::unique_ptr<Body>>::iterator> nodes;
+		for (uint32_t step = 0; step < capacity * 4; ++step) {
+			if (alive.empty() || rng() % 5 != 0) {
+				const SlotHandle handle = slots.Allocate();
+				if (handle.generation == 0) {
+					continue;
+				}
+				bodies[slots.GetCount() - 1] = {float(step), 0.0f, 1.0f, 0.5f};
+				alive.push_back(handle);
+				nodes.push_back(list.insert(list.end(), std::make_unique<Body>(bodies[slots.GetCount() - 1])));
+			} else {
+				const size_t k = rng() % alive.size();
+				const uint32_t i = slots.Find(alive[k]);
+				const uint32_t last = slots.Release(i);
+				if (i != last) {
+					bodies[i] = bodies[last];
+				}
+				alive[k] = alive.back();
+				alive.pop_back();
+
+				// リストも途中を消すので、後から作るノードはヒープ上でばらばらになる
+				list.erase(nodes[k]);
+				nodes[k] = nodes.back();
+				nodes.pop_back();
+			}
+		}
+		handles = alive;
+	}
+};
+
+ChurnedPool& GetPool() {
+	static ChurnedPool pool(50000);
+	return pool;
+}
+
+void BM_SlotMapDenseIteration(benchmark::State& state) {
+	ChurnedPool& pool = GetPool();
+	const uint32_t count = pool.slots.GetCount();
+	for (auto _ : state) {
+		for (uint32_t i = 0; i < count; ++i) {
+			pool.bodies[i].x += pool.bodies[i].vx;
+			pool.bodies[i].y += pool.bodies[i].vy;
+		}
+		benchmark::ClobberMemory();
+	}
+	state.counters["entities"] = count;
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_SlotMapDenseIteration)->Unit(benchmark::kMillisecond);
+
+void BM_SlotMapHandleIteration(benchmark::State& state) {
+	ChurnedPool& pool = GetPool();
+	for (auto _ : state) {
+		for (const SlotHandle& handle : pool.handles) {
+			const uint32_t i = pool.slots.Find(handle);
+			if (i == SlotMap::kInvalid) {
+				continue;
+			}
+			pool.bodies[i].x += pool.bodies[i].vx;
+			pool.bodies[i].y += pool.bodies[i].vy;
+		}
+		benchmark::ClobberMemory();
+	}
+	state.counters["entities"] = static_cast<double>(pool.handles.size());
+	state.SetItemsProcessed(state.iterations() * pool.handles.size());
+}
+BENCHMARK(BM_SlotMapHandleIteration)->Unit(benchmark::kMillisecond);
+
+void BM_PointerListIteration(benchmark::State& state) {
+	ChurnedPool& pool = GetPool();
+	for (auto _ : state) {
+		for (const std::unique_ptr<Body>& body : pool.list) {
+			body->x += body->vx;
+			body->y += body->vy;
+		}
+		benchmark::ClobberMemory();
+	}
+	state.counters["entities"] = static_cast<double>(pool.list.size());
+	state.SetItemsProcessed(state.iterations() * pool.list.size());
+}
+BENCHMARK(BM_PointerListIteration)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,134 @@
+#include "MapChipField.h"
+#include "SpatialHashGrid.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// 弾と敵の当たり判定。タイルをセルにした空間ハッシュで候補を絞る今のやり方と、全部の組を調べる元のやり方の比較
+// 400 x 200 の範囲に敵（2 x 2 の AABB）と弾（点。毎フレーム 0.6 進み、範囲の端で折り返す）を置き、
+// 1フレームの判定の時間と、点と AABB を比べた回数（pairTestsPerFrame）を出す
+// どちらも、敵は1フレームに1発まで、弾は1体まで当たる（GameScene::CheckAllCollisions と同じ）
+
+namespace {
+
+const float kWorldWidth = 400.0f;
+const float kWorldHeight = 200.0f;
+const float kEnemyHalfSize = 1.0f;
+
+// 敵と弾の配置
+struct Scene {
+	std::vector<AABB> enemies;
+	std::vector<KamataEngine::Vector3> bullets;
+	std::vector<KamataEngine::Vector3> velocities;
+
+	Scene(uint32_t enemyCount, uint32_t bulletCount) {
+		std::mt19937 rng(18);
+		std::uniform_real_distribution<float> x(0.0f, kWorldWidth);
+		std::uniform_real_distribution<float> y(0.0f, kWorldHeight);
+		std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+		for (uint32_t i = 0; i < enemyCount; ++i) {
+			const KamataEngine::Vector3 center = {x(rng), y(rng), 0.0f};
+			enemies.push_back({
+			    {center.x - kEnemyHalfSize, center.y - kEnemyHalfSize, -kEnemyHalfSize},
+                {center.x + kEnemyHalfSize, center.y + kEnemyHalfSize, kEnemyHalfSize}
+            });
+		}
+		for (uint32_t i = 0; i < bulletCount; ++i) {
+			const float a = angle(rng);
+			bullets.push_back({x(rng), y(rng), 0.0f});
+			velocities.push_back({std::cos(a) * 0.6f, std::sin(a) * 0.6f, 0.0f});
+		}
+	}
+
+	// 弾を進める（範囲の端で折り返す）
+	void Step() {
+		for (size_t i = 0; i < bullets.size(); ++i) {
+			bullets[i].x += velocities[i].x;
+			bullets[i].y += velocities[i].y;
+			if (bullets[i].x < 0.0f || bullets[i].x > kWorldWidth) {
+				velocities[i].x = -velocities[i].x;
+			}
+			if (bullets[i].y < 0.0f || bullets[i].y > kWorldHeight) {
+				velocities[i].y = -velocities[i].y;
+			}
+		}
+	}
+};
+
+bool Contains(const AABB& box, const KamataEngine::Vector3& p) {
+	return p.x >= box.min.x && p.x <= box.max.x && p.y >= box.min.y && p.y <= box.max.y && p.z >= box.min.z && p.z <= box.max.z;
+}
+
+void BM_BulletEnemySpatialHash(benchmark::State& state) {
+	Scene scene(static_cast<uint32_t>(state.range(0)), static_cast<uint32_t>(state.range(1)));
+
+	// GameScene と同じセルの大きさと箱の数
+	SpatialHashGrid grid;
+	grid.Initialize(MapChipField::kBlockWidth, 1024);
+	std::vector<uint8_t> enemyHit(scene.enemies.size());
+
+	uint64_t pairTests = 0;
+	uint64_t hits = 0;
+	for (auto _ : state) {
+		scene.Step();
+		std::fill(enemyHit.begin(), enemyHit.end(), 0);
+
+		grid.Clear();
+		for (uint32_t i = 0; i < scene.enemies.size(); ++i) {
+			grid.Insert(i, scene.enemies[i]);
+		}
+		grid.Build();
+
+		for (const KamataEngine::Vector3& bullet : scene.bullets) {
+			grid.QueryPoint(bullet, [&](uint32_t id, const AABB& box) {
+				if (enemyHit[id] || !Contains(box, bullet)) {
+					return true;
+				}
+				enemyHit[id] = 1;
+				++hits;
+				return false;
+			});
+		}
+		pairTests += grid.GetStats().candidates;
+	}
+
+	state.counters["pairTestsPerFrame"] = benchmark::Counter(static_cast<double>(pairTests), benchmark::Counter::kAvgIterations);
+	state.counters["hitsPerFrame"] = benchmark::Counter(static_cast<double>(hits), benchmark::Counter::kAvgIterations);
+}
+// 敵の数と弾の数（ゲームの規模と、数千ずつ）
+BENCHMARK(BM_BulletEnemySpatialHash)->ArgNames({"enemies", "bullets"})->Args({50, 256})->Args({1000, 1000})->Args({2000, 5000})->Args({5000, 10000});
+
+void BM_BulletEnemyAllPairs(benchmark::State& state) {
+	Scene scene(static_cast<uint32_t>(state.range(0)), static_cast<uint32_t>(state.range(1)));
+	std::vector<uint8_t> bulletHit(scene.bullets.size());
+
+	uint64_t pairTests = 0;
+	uint64_t hits = 0;
+	for (auto _ : state) {
+		scene.Step();
+		std::fill(bulletHit.begin(), bulletHit.end(), 0);
+
+		// 元の CheckAllCollisions（敵ごとに全部の弾を見る）
+		for (const AABB& box : scene.enemies) {
+			for (size_t b = 0; b < scene.bullets.size(); ++b) {
+				if (bulletHit[b]) {
+					continue;
+				}
+				++pairTests;
+				if (Contains(box, scene.bullets[b])) {
+					bulletHit[b] = 1;
+					++hits;
+					break;
+				}
+			}
+		}
+	}
+
+	state.counters["pairTestsPerFrame"] = benchmark::Counter(static_cast<double>(pairTests), benchmark::Counter::kAvgIterations);
+	state.counters["hitsPerFrame"] = benchmark::Counter(static_cast<double>(hits), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_BulletEnemyAllPairs)->ArgNames({"enemies", "bullets"})->Args({50, 256})->Args({1000, 1000})->Args({2000, 5000})->Args({5000, 10000});
+
+} // namespace
@@ -0,0 +1,65 @@
+#include "WireRenderer.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cmath>
+
+// 射程いっぱいに刺さったワイヤーを、フックを並べてからプレイヤーが引き寄せられ終わるまで（1回の発射分）
+// 容量は Player::GetWireChainCapacity と同じ式で決める。wireMaxDistance_ = 200 の長いロープでも欠けないことをカウンタで確かめる
+
+namespace {
+
+// Player の既定値（フックの速度と引っ張り速度）と、長いロープで使う間隔
+const float kWireProjectileSpeed = 0.6f;
+const float kWirePullSpeed = 0.4f;
+const float kWireSegmentSpacing = 0.6f;
+
+void BM_WireChainHookAndPull(benchmark::State& state) {
+	const float wireMaxDistance = static_cast<float>(state.range(0));
+
+	WireRenderer chain;
+	chain.Initialize(static_cast<uint32_t>(std::ceil((wireMaxDistance + kWireProjectileSpeed) / kWireSegmentSpacing)) + 1);
+
+	KamataEngine::Model model;
+	RenderQueue queue;
+	InstancedModelRenderer renderer;
+	FrameRingBuffer frameRing;
+	frameRing.Initialize(chain.GetStats().capacity * sizeof(KamataEngine::Matrix4x4) * 4, 2);
+	KamataEngine::Camera camera;
+
+	// フックは射程いっぱい（射程判定の前に1フレーム進んだ位置）に刺さる
+	const KamataEngine::Vector3 hook = {wireMaxDistance + kWireProjectileSpeed, 0.0f, 0.0f};
+	uint64_t frames = 0;
+	uint64_t maxSegments = 0;
+	for (auto _ : state) {
+		KamataEngine::Vector3 player = {0.0f, 0.0f, 0.0f};
+		chain.Build(player, hook, kWireSegmentSpacing);
+		maxSegments = std::max<uint64_t>(maxSegments, chain.GetSegmentCount());
+
+		// 引き寄せ中は毎フレーム、進んだ距離の分だけプレイヤー側のセグメントを外して描画を積む
+		float accumulated = 0.0f;
+		while (player.x < hook.x) {
+			player.x += kWirePullSpeed;
+			accumulated += kWirePullSpeed;
+			while (accumulated >= kWireSegmentSpacing && chain.GetSegmentCount() > 0) {
+				chain.PopFront();
+				accumulated -= kWireSegmentSpacing;
+			}
+
+			frameRing.BeginFrame();
+			queue.Begin(camera);
+			chain.Draw(queue, renderer, frameRing, model, {player.x - 37.0f, player.x + 37.0f, -21.0f, 21.0f});
+			frameRing.EndFrame();
+			++frames;
+		}
+		chain.Clear();
+	}
+
+	state.counters["capacity"] = static_cast<double>(chain.GetStats().capacity);
+	state.counters["segments"] = static_cast<double>(maxSegments);
+	state.counters["truncated"] = static_cast<double>(chain.GetStats().truncatedSegments);
+	state.counters["framesPerPull"] = benchmark::Counter(static_cast<double>(frames), benchmark::Counter::kAvgIterations);
+}
+// wireMaxDistance_（既定の 25 と長いロープの 200）
+BENCHMARK(BM_WireChainHookAndPull)->ArgName("wireMaxDistance")->Arg(25)->Arg(200);
+
+} // namespace
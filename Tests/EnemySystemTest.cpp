@@ -0,0 +1,185 @@
+#include "EnemySystem.h"
+#include "TestMapFile.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+
+namespace {
+
+// 64 x 8 のマップの左端（x = 2）と右端（x = 60）に1体ずつ。起こす区画は横に 8 つ
+class EnemySystemTest : public testing::Test {
+protected:
+	void SetUp() override {
+		const std::string csv = MakeMapCsv(64, 8, [](uint32_t x, uint32_t y) { return (y == 6 && (x == 2 || x == 60)) ? "E1" : "0"; });
+		field_.LoadMapChipCsv(WriteTemporaryFile("EnemySystemTest.csv", csv));
+
+		enemies_.SetMapChipField(&field_);
+		enemies_.Initialize(static_cast<uint32_t>(field_.GetEnemySpawns().size()));
+		for (const EnemySpawn& spawn : field_.GetEnemySpawns()) {
+			spawned_.push_back(enemies_.Spawn(&model_, field_.GetMapChipPositionByIndex(spawn.index.xIndex, spawn.index.yIndex), spawn.index, spawn.type));
+		}
+	}
+
+	// 1フレーム分（GameScene と同じく、起こす敵を選び直してから更新する）
+	void Step(const RangeRect& visibleRect, uint32_t frames = 1) {
+		for (uint32_t f = 0; f < frames; ++f) {
+			enemies_.UpdateActivation(visibleRect);
+			enemies_.Update();
+		}
+	}
+
+	// 左端の敵だけが映る範囲と、右端の敵だけが映る範囲
+	const RangeRect kLeftView = {0.0f, 10.0f, 0.0f, 16.0f};
+	const RangeRect kRightView = {110.0f, 126.0f, 0.0f, 16.0f};
+
+	// やられ演出が確実に終わるフレーム数（既定のやられ時間は 0.6 秒）
+	static inline const uint32_t kDefeatFrames = 60;
+
+	MapChipField field_;
+	KamataEngine::Model model_;
+	EnemySystem enemies_;
+	std::vector<Enemy> spawned_;
+};
+
+// 使用中の敵をすべて見て、死亡になっていない敵を数える（基準にした元の GameScene の数え方）
+uint32_t CountAliveByScan(EnemySystem& enemies) {
+	uint32_t alive = 0;
+	for (uint32_t i = 0; i < enemies.GetActiveCount(); ++i) {
+		if (!enemies.GetActive(i).IsDead()) {
+			++alive;
+		}
+	}
+	return alive;
+}
+
+} // namespace
+
+TEST_F(EnemySystemTest, OnlyEnemiesNearCameraAreAwake) {
+	ASSERT_EQ(spawned_.size(), 2u);
+	EXPECT_EQ(enemies_.GetAwakeCount(), 0u);
+
+	Step(kLeftView);
+	EXPECT_EQ(enemies_.GetAwakeCount(), 1u);
+	EXPECT_EQ(enemies_.GetStats().asleepCount, 1u);
+
+	Step(kRightView);
+	EXPECT_EQ(enemies_.GetAwakeCount(), 1u);
+	EXPECT_EQ(enemies_.GetStats().wokenCount, 1u);
+	EXPECT_EQ(enemies_.GetStats().sleptCount, 1u);
+}
+
+TEST_F(EnemySystemTest, DefeatedEnemyFinishesOffScreen) {
+	Step(kLeftView);
+	spawned_[0].OnCollision(nullptr);
+	Step(kLeftView);
+	ASSERT_FALSE(spawned_[0].IsDead());
+
+	// やられ演出の途中でカメラが離れても、眠らずに死亡まで進む
+	Step(kRightView, kDefeatFrames);
+	EXPECT_TRUE(spawned_[0].IsDead());
+	EXPECT_FALSE(spawned_[1].IsDead());
+}
+
+TEST_F(EnemySystemTest, PendingDefeatIsNotStrandedBySleep) {
+	Step(kLeftView);
+
+	// 当たった直後（やられ状態のリクエストが反映される前）にカメラが離れても眠らない
+	spawned_[0].OnCollision(nullptr);
+	Step(kRightView, kDefeatFrames);
+	EXPECT_TRUE(spawned_[0].IsDead());
+}
+
+TEST_F(EnemySystemTest, DeadEnemySleepsAgain) {
+	Step(kLeftView);
+	spawned_[0].OnCollision(nullptr);
+	Step(kLeftView, kDefeatFrames);
+	ASSERT_TRUE(spawned_[0].IsDead());
+
+	// 死亡になった敵は区画から外れたら眠る
+	Step(kRightView);
+	EXPECT_EQ(enemies_.GetAwakeCount(), 1u);
+	EXPECT_EQ(enemies_.GetStats().sleptCount, 1u);
+}
+
+TEST(EnemySystemAliveCountTest, MatchesFullScanAcrossRandomKillOrders) {
+	// 512 x 16 のマップに 400 体。カメラを左右に動かしながら、ランダムな順に倒したり返したりする
+	MapChipField field;
+	const std::string csv = MakeMapCsv(512, 16, [](uint32_t x, uint32_t y) { return ((x * 7 + y * 13) % 20 == 0) ? (x % 2 ? "E2" : "E1") : "0"; });
+	field.LoadMapChipCsv(WriteTemporaryFile("EnemySystemAliveCountTest.csv", csv));
+	const std::vector<EnemySpawn>& spawns = field.GetEnemySpawns();
+	ASSERT_GT(spawns.size(), 300u);
+
+	KamataEngine::Model model;
+	for (uint32_t seed = 0; seed < 20; ++seed) {
+		std::mt19937 rng(seed);
+
+		EnemySystem enemies;
+		enemies.SetMapChipField(&field);
+		enemies.Initialize(static_cast<uint32_t>(spawns.size()));
+		std::vector<Enemy> order;
+		for (const EnemySpawn& spawn : spawns) {
+			order.push_back(enemies.Spawn(&model, field.GetMapChipPositionByIndex(spawn.index.xIndex, spawn.index.yIndex), spawn.index, spawn.type));
+		}
+		std::shuffle(order.begin(), order.end(), rng);
+		ASSERT_EQ(enemies.GetAliveCount(), CountAliveByScan(enemies));
+
+		float cameraX = 0.0f;
+		float cameraSpeed = 3.0f;
+		for (size_t next = 0; next < order.size() || enemies.GetAliveCount() > 0;) {
+			// カメラは端で折り返す
+			cameraX += cameraSpeed;
+			if (cameraX < 0.0f || cameraX > 1024.0f) {
+				cameraSpeed = -cameraSpeed;
+			}
+			enemies.UpdateActivation({cameraX - 40.0f, cameraX + 40.0f, 0.0f, 32.0f});
+			enemies.Update();
+
+			// このフレームで倒す・返す敵（映っていない敵にも当たったことにする）
+			for (uint32_t k = rng() % 4; k > 0 && next < order.size(); --k, ++next) {
+				if (rng() % 8 == 0) {
+					enemies.Release(order[next].GetHandle());
+				} else {
+					order[next].OnCollision(nullptr);
+				}
+			}
+
+			ASSERT_EQ(enemies.GetAliveCount(), CountAliveByScan(enemies)) << "seed " << seed;
+		}
+	}
+}
+
+TEST(EnemyArchetypeTableTest, RowsWithNonPositiveSizeOrDefeatTimeAreSkipped) {
+	// やられ時間が 0 のスライム、幅が負のコウモリ、高さが 0 のコウモリは飛ばし、最後の正しいコウモリの行だけを読む
+	const std::string csv = "type,walkSpeed,width,height,walkSpin,defeatedTime,defeatedSpin,defeatedAngleStart,defeatedAngleEnd\n"
+	                        "slime,0.05,1.6,1.5,0.1,0.0,0.3,0.0,-60.0\n"
+	                        "bat,0.05,-1.2,1.0,0.15,0.5,0.4,0.0,-60.0\n"
+	                        "bat,0.05,1.2,0.0,0.15,0.5,0.4,0.0,-60.0\n"
+	                        "bat,0.03,1.2,1.0,0.15,0.5,0.4,0.0,-60.0\n";
+	EnemyArchetypeTable table;
+	table.Load(WriteTemporaryFile("EnemyArchetypeTableTest.csv", csv));
+
+	const EnemyArchetypeTable::Archetype defaults;
+	const EnemyArchetypeTable::Archetype slime = table.Get(EnemyType::kSlime);
+	EXPECT_FLOAT_EQ(slime.walkSpeed, defaults.walkSpeed);
+	EXPECT_FLOAT_EQ(slime.defeatedTime, defaults.defeatedTime);
+	const EnemyArchetypeTable::Archetype bat = table.Get(EnemyType::kBat);
+	EXPECT_FLOAT_EQ(bat.walkSpeed, 0.03f);
+	EXPECT_FLOAT_EQ(bat.width, 1.2f);
+	EXPECT_FLOAT_EQ(bat.height, 1.0f);
+
+	// その表で倒したスライムは、既定のやられ時間で死亡になる（0 で割って止まらない）
+	MapChipField field;
+	field.LoadMapChipCsv(WriteTemporaryFile("EnemyArchetypeTableTestMap.csv", MakeMapCsv(8, 4, [](uint32_t x, uint32_t y) { return (x == 2 && y == 2) ? "E1" : "0"; })));
+	KamataEngine::Model model;
+	EnemySystem enemies;
+	enemies.SetArchetypes(table);
+	enemies.Initialize(1);
+	const EnemySpawn& spawn = field.GetEnemySpawns().front();
+	Enemy enemy = enemies.Spawn(&model, field.GetMapChipPositionByIndex(spawn.index.xIndex, spawn.index.yIndex), spawn.index, spawn.type);
+	enemy.OnCollision(nullptr);
+	for (uint32_t f = 0; f < 60; ++f) {
+		enemies.Update();
+	}
+	EXPECT_TRUE(enemy.IsDead());
+	EXPECT_EQ(enemies.GetAliveCount(), 0u);
+}
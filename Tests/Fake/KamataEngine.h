@@ -0,0 +1,120 @@
+#pragma once
+// テスト用の KamataEngine.h
+// 数学の型はエンジンのヘッダーをそのまま使い、描画デバイスが必要なクラスは中身の無い代わりを置く
+// DirectXCommon::GetDevice は nullptr を返すので、ゲームのコードはデバイスが無いときの道を通る
+#include "d3d12.h"
+#include "wrl.h"
+#include <math/Matrix4x4.h>
+#include <math/Vector2.h>
+#include <math/Vector3.h>
+#include <math/Vector4.h>
+#include <cstdint>
+#include <vector>
+
+namespace KamataEngine {
+
+// ワールド変換の定数バッファの中身（大きさを数えるときだけ使う）
+struct ConstBufferDataWorldTransform {
+	Matrix4x4 matWorld;
+};
+
+/// <summary>
+/// ワールド変換データ（定数バッファは持たない）
+/// </summary>
+class WorldTransform {
+public:
+	Vector3 scale_ = {1, 1, 1};
+	Vector3 rotation_ = {0, 0, 0};
+	Vector3 translation_ = {0, 0, 0};
+	Matrix4x4 matWorld_ = {};
+	const WorldTransform* parent_ = nullptr;
+
+	WorldTransform() = default;
+	WorldTransform(const WorldTransform&) = delete;
+	WorldTransform& operator=(const WorldTransform&) = delete;
+
+	void Initialize() {}
+	void TransferMatrix() {}
+};
+
+/// <summary>
+/// カメラ（行列は呼び出し側で設定する）
+/// </summary>
+class Camera {
+public:
+	Vector3 rotation_ = {0, 0, 0};
+	Vector3 translation_ = {0, 0, -50};
+	float fovAngleY = 45.0f * 3.141592654f / 180.0f;
+	float aspectRatio = 16.0f / 9.0f;
+	float nearZ = 0.1f;
+	float farZ = 1000.0f;
+	Matrix4x4 matView = {};
+	Matrix4x4 matProjection = {};
+
+	void Initialize() {}
+	void UpdateMatrix() {}
+	void TransferMatrix() {}
+};
+
+class Material;
+
+/// <summary>
+/// メッシュ（頂点とインデックスだけを持つ）
+/// </summary>
+class Mesh {
+public:
+	struct VertexPosNormalUv {
+		Vector3 pos;
+		Vector3 normal;
+		Vector2 uv;
+	};
+
+	const std::vector<VertexPosNormalUv>& GetVertices() { return vertices_; }
+	const std::vector<uint32_t>& GetIndices() { return indices_; }
+
+private:
+	std::vector<VertexPosNormalUv> vertices_;
+	std::vector<uint32_t> indices_;
+};
+
+/// <summary>
+/// モデルの共通部分（パイプラインの組の型だけ）
+/// </summary>
+class ModelCommon {
+public:
+	enum class CullingMode { kBack = 0, kFront, kNone, kCount };
+	enum class BlendMode { kNormal = 0, kNone, kAdd, kSubtract, kMultiply, kScreen, kCount };
+	enum class DepthTestMode { kOn = 0, kOff, kAlwaysPass, kReadOnly, kCount };
+
+	struct PipelineSetKey {
+		CullingMode cullingMode = CullingMode::kBack;
+		BlendMode blendMode = BlendMode::kNormal;
+		DepthTestMode depthTestMode = DepthTestMode::kOn;
+	};
+};
+
+/// <summary>
+/// モデル（アドレスで区別するだけで、中身は持たない）
+/// </summary>
+class Model {
+public:
+	using CullingMode = ModelCommon::CullingMode;
+	using BlendMode = ModelCommon::BlendMode;
+	using DepthTestMode = ModelCommon::DepthTestMode;
+};
+
+/// <summary>
+/// DirectX 基盤（デバイスは無い）
+/// </summary>
+class DirectXCommon {
+public:
+	static DirectXCommon* GetInstance() {
+		static DirectXCommon instance;
+		return &instance;
+	}
+
+	ID3D12Device* GetDevice() const { return nullptr; }
+	ID3D12GraphicsCommandList* GetCommandList() const { return nullptr; }
+};
+
+} // namespace KamataEngine
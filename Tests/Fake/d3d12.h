@@ -0,0 +1,74 @@
+#pragma once
+// テスト用の d3d12.h
+// デバイスは常に無い（DirectXCommon::GetDevice が nullptr を返す）ので、ゲームのコードがコンパイルできるだけの型と宣言を置く
+#include <cstddef>
+#include <cstdint>
+
+typedef long HRESULT;
+typedef unsigned int UINT;
+typedef uint64_t UINT64;
+typedef uint64_t D3D12_GPU_VIRTUAL_ADDRESS;
+
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+#define FAILED(hr) (((HRESULT)(hr)) < 0)
+#define IID_PPV_ARGS(pp) reinterpret_cast<void**>(pp)
+
+#define D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT 256
+
+enum DXGI_FORMAT {
+	DXGI_FORMAT_UNKNOWN,
+	DXGI_FORMAT_R32_UINT,
+	DXGI_FORMAT_R8G8B8A8_UNORM_SRGB,
+	DXGI_FORMAT_D32_FLOAT,
+};
+enum D3D12_HEAP_TYPE { D3D12_HEAP_TYPE_DEFAULT, D3D12_HEAP_TYPE_UPLOAD };
+enum D3D12_HEAP_FLAGS { D3D12_HEAP_FLAG_NONE };
+enum D3D12_RESOURCE_DIMENSION { D3D12_RESOURCE_DIMENSION_BUFFER };
+enum D3D12_TEXTURE_LAYOUT { D3D12_TEXTURE_LAYOUT_ROW_MAJOR };
+enum D3D12_RESOURCE_STATES { D3D12_RESOURCE_STATE_GENERIC_READ };
+
+struct D3D12_HEAP_PROPERTIES {
+	D3D12_HEAP_TYPE Type;
+};
+struct DXGI_SAMPLE_DESC {
+	UINT Count;
+	UINT Quality;
+};
+struct D3D12_RESOURCE_DESC {
+	D3D12_RESOURCE_DIMENSION Dimension;
+	UINT64 Width;
+	UINT Height;
+	uint16_t DepthOrArraySize;
+	uint16_t MipLevels;
+	DXGI_FORMAT Format;
+	DXGI_SAMPLE_DESC SampleDesc;
+	D3D12_TEXTURE_LAYOUT Layout;
+};
+struct D3D12_RANGE {
+	size_t Begin;
+	size_t End;
+};
+struct D3D12_VERTEX_BUFFER_VIEW {
+	D3D12_GPU_VIRTUAL_ADDRESS BufferLocation;
+	UINT SizeInBytes;
+	UINT StrideInBytes;
+};
+struct D3D12_INDEX_BUFFER_VIEW {
+	D3D12_GPU_VIRTUAL_ADDRESS BufferLocation;
+	UINT SizeInBytes;
+	DXGI_FORMAT Format;
+};
+
+struct ID3D12Resource {
+	HRESULT Map(UINT, const D3D12_RANGE*, void**) { return -1; }
+	void Unmap(UINT, const D3D12_RANGE*) {}
+	D3D12_GPU_VIRTUAL_ADDRESS GetGPUVirtualAddress() { return 0; }
+};
+struct ID3D12Device {
+	HRESULT CreateCommittedResource(const D3D12_HEAP_PROPERTIES*, D3D12_HEAP_FLAGS, const D3D12_RESOURCE_DESC*, D3D12_RESOURCE_STATES, const void*, void**) { return -1; }
+};
+struct ID3D12GraphicsCommandList;
+struct ID3D12RootSignature;
+struct ID3D12PipelineState;
+struct ID3D10Blob;
+typedef ID3D10Blob ID3DBlob;
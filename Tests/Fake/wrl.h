@@ -0,0 +1,24 @@
+#pragma once
+// テスト用の wrl.h（ComPtr は参照カウントを持たず、ポインタを1つ持つだけ）
+#include <cstddef>
+
+namespace Microsoft::WRL {
+
+template<class T> class ComPtr {
+public:
+	ComPtr() = default;
+	ComPtr(std::nullptr_t) {}
+
+	T* Get() const { return ptr_; }
+	T* operator->() const { return ptr_; }
+	T** operator&() { return &ptr_; }
+	T** GetAddressOf() { return &ptr_; }
+	T** ReleaseAndGetAddressOf() { return &ptr_; }
+	explicit operator bool() const { return ptr_ != nullptr; }
+	void Reset() { ptr_ = nullptr; }
+
+private:
+	T* ptr_ = nullptr;
+};
+
+} // namespace Microsoft::WRL
@@ -0,0 +1,181 @@
+#include "LinearRingAllocator.h"
+#include <deque>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+// GPU の代わり。提出したフレームを latency フレーム遅れで完了させる
+class FakeGpuQueue {
+public:
+	explicit FakeGpuQueue(uint32_t latency) : latency_(latency) {}
+
+	// フレームを提出して、そのフレームのフェンス値を返す
+	uint64_t Submit() {
+		++submitted_;
+		if (submitted_ > latency_) {
+			completed_ = submitted_ - latency_;
+		}
+		return submitted_;
+	}
+
+	// 完了したフェンス値
+	uint64_t GetCompletedValue() const { return completed_; }
+
+	// すべて完了させる
+	void Flush() { completed_ = submitted_; }
+
+private:
+	uint32_t latency_ = 0;
+	uint64_t submitted_ = 0;
+	uint64_t completed_ = 0;
+};
+
+// 使用中の領域（[begin, end)）とフェンス値
+struct LiveRange {
+	size_t begin;
+	size_t end;
+	uint64_t fenceValue;
+};
+
+bool Overlaps(const LiveRange& a, size_t begin, size_t end) { return begin < a.end && a.begin < end; }
+
+} // namespace
+
+TEST(LinearRingAllocatorTest, AllocationsAreAligned) {
+	LinearRingAllocator allocator;
+	allocator.Initialize(4096);
+
+	EXPECT_EQ(allocator.Allocate(10, 256), 0u);
+	EXPECT_EQ(allocator.Allocate(10, 256), 256u);
+	EXPECT_EQ(allocator.Allocate(1, 16), 272u);
+
+	// 詰め物も使用量に数える
+	EXPECT_EQ(allocator.GetStats().usedBytes, 273u);
+	EXPECT_EQ(allocator.GetStats().frameAllocations, 3u);
+}
+
+TEST(LinearRingAllocatorTest, FailsWhileFrameIsInFlightAndSucceedsAfterRetire) {
+	LinearRingAllocator allocator;
+	allocator.Initialize(1024);
+
+	EXPECT_EQ(allocator.Allocate(1024, 256), 0u);
+	allocator.FinishFrame(1);
+
+	// GPU がフレーム 1 を終えるまでは空きが無い
+	EXPECT_EQ(allocator.Allocate(256, 256), LinearRingAllocator::kInvalidOffset);
+	EXPECT_EQ(allocator.GetStats().failedAllocations, 1u);
+
+	allocator.Retire(0);
+	EXPECT_EQ(allocator.Allocate(256, 256), LinearRingAllocator::kInvalidOffset);
+
+	allocator.Retire(1);
+	EXPECT_EQ(allocator.GetStats().usedBytes, 0u);
+	EXPECT_EQ(allocator.Allocate(256, 256), 0u);
+}
+
+TEST(LinearRingAllocatorTest, WrapsToStartAndCountsSkippedTail) {
+	LinearRingAllocator allocator;
+	allocator.Initialize(1024);
+
+	// フレーム 1 が [0, 512)、フレーム 2 が [512, 768)
+	EXPECT_EQ(allocator.Allocate(512, 256), 0u);
+	allocator.FinishFrame(1);
+	EXPECT_EQ(allocator.Allocate(256, 256), 512u);
+	allocator.FinishFrame(2);
+
+	// フレーム 1 だけ完了。末尾の [768, 1024) に 512 は入らないので先頭に折り返す
+	allocator.Retire(1);
+	EXPECT_EQ(allocator.Allocate(512, 256), 0u);
+
+	// 飛ばした末尾 256 バイトはこのフレームの使用量に入る
+	EXPECT_EQ(allocator.GetStats().frameBytes, 256u + 512u);
+	EXPECT_EQ(allocator.GetStats().usedBytes, 256u + 256u + 512u);
+
+	// 先頭側はフレーム 2 の手前まで
+	EXPECT_EQ(allocator.Allocate(256, 256), LinearRingAllocator::kInvalidOffset);
+
+	allocator.FinishFrame(3);
+	allocator.Retire(3);
+	EXPECT_EQ(allocator.GetStats().usedBytes, 0u);
+	EXPECT_EQ(allocator.GetStats().framesInFlight, 0u);
+}
+
+TEST(LinearRingAllocatorTest, EmptyFrameIsNotQueued) {
+	LinearRingAllocator allocator;
+	allocator.Initialize(1024);
+
+	allocator.FinishFrame(1);
+	EXPECT_EQ(allocator.GetStats().framesInFlight, 0u);
+
+	allocator.Allocate(16, 16);
+	allocator.FinishFrame(2);
+	EXPECT_EQ(allocator.GetStats().framesInFlight, 1u);
+}
+
+TEST(LinearRingAllocatorTest, OversizedRequestFails) {
+	LinearRingAllocator allocator;
+	allocator.Initialize(1024);
+
+	EXPECT_EQ(allocator.Allocate(2048, 16), LinearRingAllocator::kInvalidOffset);
+	EXPECT_EQ(allocator.Allocate(0, 16), LinearRingAllocator::kInvalidOffset);
+	EXPECT_EQ(allocator.GetStats().usedBytes, 0u);
+}
+
+TEST(LinearRingAllocatorTest, NeverHandsOutMemoryTheGpuIsStillReading) {
+	const size_t capacity = 64 * 1024;
+	LinearRingAllocator allocator;
+	allocator.Initialize(capacity);
+
+	// GPU は 2 フレーム遅れで追いかける
+	FakeGpuQueue gpu(2);
+	std::deque<LiveRange> live;
+	std::mt19937 rng(7);
+	uint32_t wraps = 0;
+
+	for (int frame = 0; frame < 5000; ++frame) {
+		// フレームの始めに、完了したフレームの領域を解放する
+		allocator.Retire(gpu.GetCompletedValue());
+		while (!live.empty() && live.front().fenceValue <= gpu.GetCompletedValue()) {
+			live.pop_front();
+		}
+
+		// 次に提出するフレームのフェンス値
+		const uint64_t fenceValue = static_cast<uint64_t>(frame) + 1;
+		size_t previous = 0;
+		const int allocations = static_cast<int>(rng() % 24);
+		for (int a = 0; a < allocations; ++a) {
+			const size_t size = 1 + rng() % 2048;
+			const size_t alignment = size_t(1) << (rng() % 9);
+			const size_t offset = allocator.Allocate(size, alignment);
+			if (offset == LinearRingAllocator::kInvalidOffset) {
+				continue;
+			}
+
+			ASSERT_EQ(offset % alignment, 0u);
+			ASSERT_LE(offset + size, capacity);
+			if (offset < previous) {
+				++wraps;
+			}
+			previous = offset + size;
+
+			// GPU がまだ読んでいる領域とは重ならない
+			for (const LiveRange& range : live) {
+				ASSERT_FALSE(Overlaps(range, offset, offset + size)) << "frame " << frame;
+			}
+			live.push_back({offset, offset + size, fenceValue});
+		}
+
+		allocator.FinishFrame(fenceValue);
+		ASSERT_EQ(gpu.Submit(), fenceValue);
+		ASSERT_LE(allocator.GetStats().usedBytes, capacity);
+	}
+
+	// 折り返しを実際に通っている
+	EXPECT_GT(wraps, 0u);
+
+	gpu.Flush();
+	allocator.Retire(gpu.GetCompletedValue());
+	EXPECT_EQ(allocator.GetStats().usedBytes, 0u);
+}
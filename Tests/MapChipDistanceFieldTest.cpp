@@ -0,0 +1,130 @@
+#include "MapChipDistanceField.h"
+#include "TestMapFile.h"
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+
+namespace {
+
+// 密度 density（0～1）でブロックを散らしたマップ
+MapChipData MakeRandomData(uint32_t width, uint32_t height, float density, uint32_t seed) {
+	std::mt19937 rng(seed);
+	std::bernoulli_distribution isBlock(density);
+	MapChipData data;
+	data.width = width;
+	data.height = height;
+	data.Data.resize(static_cast<size_t>(width) * height);
+	for (MapChipType& tile : data.Data) {
+		tile = isBlock(rng) ? MapChipType::kBlock : MapChipType::kBlank;
+	}
+	return data;
+}
+
+// 2つの距離場がすべてのタイルで一致するか
+void ExpectSameDistances(const MapChipDistanceField& actual, const MapChipDistanceField& expected, const MapChipData& data) {
+	for (uint32_t y = 0; y < data.height; ++y) {
+		for (uint32_t x = 0; x < data.width; ++x) {
+			ASSERT_FLOAT_EQ(actual.GetDistance(x, y), expected.GetDistance(x, y)) << x << "," << y;
+		}
+	}
+}
+
+} // namespace
+
+TEST(MapChipDistanceFieldTest, BuildMatchesBruteForce) {
+	const MapChipData data = MakeRandomData(40, 30, 0.01f, 1);
+	MapChipDistanceField field;
+	field.Build(data);
+
+	for (uint32_t y = 0; y < data.height; ++y) {
+		for (uint32_t x = 0; x < data.width; ++x) {
+			// 全部のブロックとの距離の最小値（kMaxDistance で打ち切り）
+			float nearest = MapChipDistanceField::kMaxDistance;
+			for (uint32_t by = 0; by < data.height; ++by) {
+				for (uint32_t bx = 0; bx < data.width; ++bx) {
+					if (data.Data[static_cast<size_t>(by) * data.width + bx] == MapChipType::kBlock) {
+						nearest = std::min(nearest, std::hypot(static_cast<float>(bx) - x, static_cast<float>(by) - y));
+					}
+				}
+			}
+			ASSERT_FLOAT_EQ(field.GetDistance(x, y), nearest) << x << "," << y;
+		}
+	}
+}
+
+TEST(MapChipDistanceFieldTest, UpdateRegionMatchesFullBuildAfterRandomEdits) {
+	for (uint32_t seed = 0; seed < 10; ++seed) {
+		std::mt19937 rng(seed);
+		MapChipData data = MakeRandomData(96, 64, 0.02f, seed + 100);
+		MapChipDistanceField updated;
+		updated.Build(data);
+
+		// 1タイルの変更と、小さな矩形の変更を混ぜる
+		for (uint32_t edit = 0; edit < 40; ++edit) {
+			const uint32_t numX = (rng() % 4 == 0) ? 1 + rng() % 6 : 1;
+			const uint32_t numY = (rng() % 4 == 0) ? 1 + rng() % 6 : 1;
+			const uint32_t x0 = rng() % (data.width - numX + 1);
+			const uint32_t y0 = rng() % (data.height - numY + 1);
+			const MapChipType type = (rng() % 2) ? MapChipType::kBlock : MapChipType::kBlank;
+			for (uint32_t y = y0; y < y0 + numY; ++y) {
+				for (uint32_t x = x0; x < x0 + numX; ++x) {
+					data.Data[static_cast<size_t>(y) * data.width + x] = type;
+				}
+			}
+			updated.UpdateRegion(data, x0, y0, numX, numY);
+		}
+
+		MapChipDistanceField rebuilt;
+		rebuilt.Build(data);
+		ExpectSameDistances(updated, rebuilt, data);
+		if (HasFatalFailure()) {
+			FAIL() << "seed " << seed;
+		}
+	}
+}
+
+TEST(MapChipDistanceFieldTest, SphereTraceAgreesWithRaycast) {
+	// 128 x 64 のマップにまばらなブロック。タイルを書き換えた後も（距離場は部分的に作り直される）一致する
+	const uint32_t width = 128;
+	const uint32_t height = 64;
+	MapChipField field;
+	field.LoadMapChipCsv(WriteTemporaryFile("MapChipDistanceFieldTest.csv", MakeMapCsv(width, height, [](uint32_t x, uint32_t y) { return ((x * 37 + y * 11) % 53 == 0) ? "1" : "0"; })));
+
+	std::mt19937 rng(9);
+	std::uniform_real_distribution<float> px(0.0f, (width - 1) * MapChipField::kBlockWidth);
+	std::uniform_real_distribution<float> py(0.0f, (height - 1) * MapChipField::kBlockHeight);
+	std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+
+	for (uint32_t round = 0; round < 2; ++round) {
+		uint32_t hits = 0;
+		for (uint32_t i = 0; i < 2000; ++i) {
+			const KamataEngine::Vector3 origin = {px(rng), py(rng), 0.0f};
+			const float a = angle(rng);
+			const KamataEngine::Vector3 direction = {std::cos(a), std::sin(a), 0.0f};
+
+			// 始点がブロックの中のレイは比べない（Raycast は距離 0 で当たる）
+			const IndexSet start = field.GetMapChipIndexSetByPosition(origin);
+			if (field.GetMapChipTypeByIndex(start.xIndex, start.yIndex) == MapChipType::kBlock) {
+				continue;
+			}
+
+			MapChipRaycastHit expected;
+			MapChipRaycastHit actual;
+			const bool expectedHit = field.Raycast(origin, direction, 60.0f, expected);
+			ASSERT_EQ(field.SphereTrace(origin, direction, 60.0f, actual), expectedHit) << "round " << round << " ray " << i;
+			if (expectedHit) {
+				++hits;
+				EXPECT_EQ(actual.index.xIndex, expected.index.xIndex) << "round " << round << " ray " << i;
+				EXPECT_EQ(actual.index.yIndex, expected.index.yIndex) << "round " << round << " ray " << i;
+				EXPECT_NEAR(actual.distance, expected.distance, 1.0e-3f) << "round " << round << " ray " << i;
+			}
+		}
+		EXPECT_GT(hits, 100u);
+
+		// 2周目はタイルを書き換えてから
+		for (uint32_t edit = 0; edit < 200; ++edit) {
+			field.SetMapChipType(rng() % width, rng() % height, (rng() % 2) ? MapChipType::kBlock : MapChipType::kBlank);
+		}
+	}
+}
@@ -0,0 +1,167 @@
+#include "MapChipField.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+// 4x3 のマップにスライムとコウモリが1匹ずつ
+const char kCsv[] = "1,0,E1,1\n"
+                    "0,0,0,0\n"
+                    "1,E2,1,1\n";
+
+// テストごとの一時ファイル（終わったら消す）
+class MapChipFieldBinaryTest : public testing::Test {
+protected:
+	void SetUp() override {
+		const std::string name = testing::UnitTest::GetInstance()->current_test_info()->name();
+		directory_ = std::filesystem::temp_directory_path() / ("MapChipFieldBinaryTest_" + name);
+		std::filesystem::create_directories(directory_);
+		csvPath_ = (directory_ / "map.csv").string();
+		binaryPath_ = (directory_ / "map.mapbin").string();
+
+		std::ofstream(csvPath_, std::ios::binary) << kCsv;
+		ASSERT_TRUE(MapChipField::BakeMapChipCsv(csvPath_, binaryPath_));
+
+		// CSV より新しいベイク済みマップとして扱われるようにする
+		std::filesystem::last_write_time(binaryPath_, std::filesystem::last_write_time(csvPath_) + std::chrono::seconds(1));
+	}
+
+	void TearDown() override {
+		std::error_code ec;
+		std::filesystem::remove_all(directory_, ec);
+	}
+
+	// ベイク済みマップの i 番目の敵スポーンを書き換える
+	void PatchEnemySpawn(uint32_t i, const MapChipBinaryEnemySpawn& record) {
+		std::fstream file(binaryPath_, std::ios::binary | std::ios::in | std::ios::out);
+		MapChipBinaryHeader header;
+		file.read(reinterpret_cast<char*>(&header), sizeof(header));
+		ASSERT_LT(i, header.enemySpawnCount);
+		file.seekp(header.enemySpawnOffset + i * sizeof(MapChipBinaryEnemySpawn));
+		file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+		ASSERT_TRUE(file.good());
+
+		// 書き換えで CSV より古くならないようにする
+		file.close();
+		std::filesystem::last_write_time(binaryPath_, std::filesystem::last_write_time(csvPath_) + std::chrono::seconds(1));
+	}
+
+	// ベイク済みマップのタイル (x, y) のバイトを書き換える
+	void PatchTile(uint32_t x, uint32_t y, uint8_t value) {
+		std::fstream file(binaryPath_, std::ios::binary | std::ios::in | std::ios::out);
+		MapChipBinaryHeader header;
+		file.read(reinterpret_cast<char*>(&header), sizeof(header));
+		ASSERT_LT(x, header.width);
+		ASSERT_LT(y, header.height);
+		file.seekp(header.tileOffset + y * header.width + x);
+		file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+		ASSERT_TRUE(file.good());
+
+		file.close();
+		std::filesystem::last_write_time(binaryPath_, std::filesystem::last_write_time(csvPath_) + std::chrono::seconds(1));
+	}
+
+	std::filesystem::path directory_;
+	std::string csvPath_;
+	std::string binaryPath_;
+};
+
+} // namespace
+
+TEST_F(MapChipFieldBinaryTest, BakedMapRoundTrips) {
+	MapChipField csv;
+	csv.LoadMapChipCsv(csvPath_);
+
+	MapChipField binary;
+	ASSERT_TRUE(binary.LoadMapChipBinary(binaryPath_));
+
+	ASSERT_EQ(binary.GetNumBlockHorizontal(), 4u);
+	ASSERT_EQ(binary.GetNumBlockVirtical(), 3u);
+	for (uint32_t y = 0; y < 3; ++y) {
+		for (uint32_t x = 0; x < 4; ++x) {
+			EXPECT_EQ(binary.GetMapChipTypeByIndex(x, y), csv.GetMapChipTypeByIndex(x, y)) << x << "," << y;
+		}
+	}
+
+	const std::vector<EnemySpawn>& spawns = binary.GetEnemySpawns();
+	ASSERT_EQ(spawns.size(), 2u);
+	EXPECT_EQ(spawns[0].type, EnemyType::kSlime);
+	EXPECT_EQ(spawns[0].index.xIndex, 2u);
+	EXPECT_EQ(spawns[0].index.yIndex, 0u);
+	EXPECT_EQ(spawns[1].type, EnemyType::kBat);
+	EXPECT_EQ(spawns[1].index.xIndex, 1u);
+	EXPECT_EQ(spawns[1].index.yIndex, 2u);
+}
+
+TEST_F(MapChipFieldBinaryTest, RejectsUnknownEnemyType) {
+	PatchEnemySpawn(1, {static_cast<uint32_t>(EnemyType::kBat) + 1, 1, 2});
+
+	MapChipField field;
+	EXPECT_FALSE(field.LoadMapChipBinary(binaryPath_));
+}
+
+TEST_F(MapChipFieldBinaryTest, RejectsUnknownTileType) {
+	PatchTile(3, 2, static_cast<uint8_t>(MapChipType::kBlock) + 1);
+
+	MapChipField field;
+	EXPECT_FALSE(field.LoadMapChipBinary(binaryPath_));
+	EXPECT_FALSE(field.OpenMapChipStream(binaryPath_));
+}
+
+TEST_F(MapChipFieldBinaryTest, LoadMapChipFallsBackToCsvOnBadTile) {
+	PatchTile(0, 0, 0xFF);
+
+	// どちらの読み方でも CSV から読み直すので、タイルは正しい
+	MapChipField field;
+	field.LoadMapChip(binaryPath_, csvPath_);
+	EXPECT_EQ(field.GetMapChipTypeByIndex(0, 0), MapChipType::kBlock);
+
+	MapChipField streamed;
+	streamed.LoadMapChip(binaryPath_, csvPath_, true);
+	ASSERT_TRUE(streamed.IsStreaming());
+	streamed.UpdateStreaming(streamed.GetMapChipPositionByIndex(0, 0), true);
+	EXPECT_EQ(streamed.GetMapChipTypeByIndex(0, 0), MapChipType::kBlock);
+}
+
+TEST_F(MapChipFieldBinaryTest, RejectsEnemyOutsideMapWidth) {
+	PatchEnemySpawn(0, {static_cast<uint32_t>(EnemyType::kSlime), 4, 0});
+
+	MapChipField field;
+	EXPECT_FALSE(field.LoadMapChipBinary(binaryPath_));
+}
+
+TEST_F(MapChipFieldBinaryTest, RejectsEnemyOutsideMapHeight) {
+	PatchEnemySpawn(0, {static_cast<uint32_t>(EnemyType::kSlime), 2, 3});
+
+	MapChipField field;
+	EXPECT_FALSE(field.LoadMapChipBinary(binaryPath_));
+	EXPECT_FALSE(field.OpenMapChipStream(binaryPath_));
+}
+
+TEST_F(MapChipFieldBinaryTest, RejectedFileKeepsCurrentMap) {
+	MapChipField field;
+	ASSERT_TRUE(field.LoadMapChipBinary(binaryPath_));
+
+	PatchEnemySpawn(0, {static_cast<uint32_t>(EnemyType::kSlime), 0xFFFFFFFF, 0});
+	EXPECT_FALSE(field.LoadMapChipBinary(binaryPath_));
+
+	// 失敗しても前のマップと敵はそのまま
+	EXPECT_EQ(field.GetNumBlockHorizontal(), 4u);
+	EXPECT_EQ(field.GetEnemySpawns().size(), 2u);
+}
+
+TEST_F(MapChipFieldBinaryTest, LoadMapChipFallsBackToCsvOnBadRecord) {
+	PatchEnemySpawn(1, {7, 1, 2});
+
+	MapChipField field;
+	field.LoadMapChip(binaryPath_, csvPath_);
+
+	// CSV から読み直しているので、敵の種別は正しい
+	ASSERT_EQ(field.GetEnemySpawns().size(), 2u);
+	EXPECT_EQ(field.GetEnemySpawns()[1].type, EnemyType::kBat);
+	EXPECT_FALSE(field.IsStreaming());
+}
@@ -0,0 +1,126 @@
+#include "MapChipField.h"
+#include "TestMapFile.h"
+#include <gtest/gtest.h>
+#include <random>
+
+namespace {
+
+// 64 x 32 のマップ。右半分にまばらなブロック、左半分は空き（空き領域の読み飛ばしも通る）、x = 20 に縦の壁
+const uint32_t kMapWidth = 64;
+const uint32_t kMapHeight = 32;
+const uint32_t kWallX = 20;
+
+class MapChipFieldRaycastTest : public testing::Test {
+protected:
+	void SetUp() override {
+		const std::string csv = MakeMapCsv(kMapWidth, kMapHeight, [](uint32_t x, uint32_t y) {
+			if (x == kWallX && y >= 8) {
+				return "1";
+			}
+			return (x > kWallX && (x * 31 + y * 17) % 11 == 0) ? "1" : "0";
+		});
+		field_.LoadMapChipCsv(WriteTemporaryFile("MapChipFieldRaycastTest.csv", csv));
+	}
+
+	// タイルの中心のワールド座標
+	KamataEngine::Vector3 TileCenter(uint32_t x, uint32_t y) { return field_.GetMapChipPositionByIndex(x, y); }
+
+	MapChipField field_;
+};
+
+} // namespace
+
+TEST_F(MapChipFieldRaycastTest, HitsWallFaceWithNormalAndDistance) {
+	const KamataEngine::Vector3 origin = TileCenter(5, 20);
+	MapChipRaycastHit hit;
+	ASSERT_TRUE(field_.Raycast(origin, {1.0f, 0.0f, 0.0f}, 100.0f, hit));
+
+	const float wallLeft = TileCenter(kWallX, 20).x - MapChipField::kBlockWidth / 2.0f;
+	EXPECT_EQ(hit.index.xIndex, kWallX);
+	EXPECT_EQ(hit.index.yIndex, 20u);
+	EXPECT_FLOAT_EQ(hit.point.x, wallLeft);
+	EXPECT_FLOAT_EQ(hit.point.y, origin.y);
+	EXPECT_FLOAT_EQ(hit.normal.x, -1.0f);
+	EXPECT_FLOAT_EQ(hit.normal.y, 0.0f);
+	EXPECT_FLOAT_EQ(hit.distance, wallLeft - origin.x);
+}
+
+TEST_F(MapChipFieldRaycastTest, DirectionNeedNotBeNormalized) {
+	MapChipRaycastHit unit;
+	MapChipRaycastHit scaled;
+	ASSERT_TRUE(field_.Raycast(TileCenter(5, 20), {1.0f, 0.0f, 0.0f}, 100.0f, unit));
+	ASSERT_TRUE(field_.Raycast(TileCenter(5, 20), {7.5f, 0.0f, 3.0f}, 100.0f, scaled));
+	EXPECT_FLOAT_EQ(unit.distance, scaled.distance);
+}
+
+TEST_F(MapChipFieldRaycastTest, StopsAtMaxDistance) {
+	const KamataEngine::Vector3 origin = TileCenter(5, 20);
+	const float toWall = TileCenter(kWallX, 20).x - MapChipField::kBlockWidth / 2.0f - origin.x;
+	MapChipRaycastHit hit;
+	EXPECT_FALSE(field_.Raycast(origin, {1.0f, 0.0f, 0.0f}, toWall - 0.01f, hit));
+	EXPECT_TRUE(field_.Raycast(origin, {1.0f, 0.0f, 0.0f}, toWall + 0.01f, hit));
+}
+
+TEST_F(MapChipFieldRaycastTest, OriginInsideBlockHitsAtZero) {
+	MapChipRaycastHit hit;
+	ASSERT_TRUE(field_.Raycast(TileCenter(kWallX, 20), {-1.0f, 0.0f, 0.0f}, 10.0f, hit));
+	EXPECT_EQ(hit.index.xIndex, kWallX);
+	EXPECT_FLOAT_EQ(hit.distance, 0.0f);
+	EXPECT_FLOAT_EQ(hit.normal.x, 0.0f);
+	EXPECT_FLOAT_EQ(hit.normal.y, 0.0f);
+}
+
+TEST_F(MapChipFieldRaycastTest, MissesWhenLeavingMapOrZeroDirection) {
+	MapChipRaycastHit hit;
+	// 左の空き領域からマップの外へ
+	EXPECT_FALSE(field_.Raycast(TileCenter(5, 20), {-1.0f, 0.2f, 0.0f}, 1000.0f, hit));
+	// 壁の上（マップの上端より上）を越える
+	EXPECT_FALSE(field_.Raycast(TileCenter(5, 2), {0.0f, 1.0f, 0.0f}, 1000.0f, hit));
+	// XY 平面上の向きが無い
+	EXPECT_FALSE(field_.Raycast(TileCenter(5, 20), {0.0f, 0.0f, 1.0f}, 1000.0f, hit));
+}
+
+TEST_F(MapChipFieldRaycastTest, EntersMapFromOutside) {
+	// マップの左の外から撃っても、マップに入ってから壁に当たる
+	const KamataEngine::Vector3 origin = {-30.0f, TileCenter(0, 20).y, 0.0f};
+	MapChipRaycastHit hit;
+	ASSERT_TRUE(field_.Raycast(origin, {1.0f, 0.0f, 0.0f}, 1000.0f, hit));
+	EXPECT_EQ(hit.index.xIndex, kWallX);
+	EXPECT_FLOAT_EQ(hit.normal.x, -1.0f);
+}
+
+TEST_F(MapChipFieldRaycastTest, MatchesFineStepMarchOnRandomRays) {
+	// 細かい刻みで点を進めたときに最初に入るブロックと、同じタイル・同じ距離で当たる
+	const float kStep = 1.0e-3f;
+	const float kMaxDistance = 60.0f;
+	std::mt19937 rng(1);
+	std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+	std::uniform_int_distribution<uint32_t> tileX(0, kMapWidth - 1);
+	std::uniform_int_distribution<uint32_t> tileY(0, kMapHeight - 1);
+	std::uniform_real_distribution<float> offset(-0.9f, 0.9f);
+
+	uint32_t hits = 0;
+	for (uint32_t n = 0; n < 2000; ++n) {
+		KamataEngine::Vector3 origin = TileCenter(tileX(rng), tileY(rng));
+		origin.x += offset(rng);
+		origin.y += offset(rng);
+		const float a = angle(rng);
+		const KamataEngine::Vector3 direction = {std::cos(a), std::sin(a), 0.0f};
+
+		IndexSet expectedIndex = {};
+		float expectedDistance = 0.0f;
+		const bool expected = MarchToFirstBlock(field_, origin, direction, kMaxDistance, kStep, expectedIndex, expectedDistance);
+
+		MapChipRaycastHit hit;
+		const bool actual = field_.Raycast(origin, direction, kMaxDistance, hit);
+		ASSERT_EQ(actual, expected) << "ray " << n;
+		if (!expected) {
+			continue;
+		}
+		++hits;
+		EXPECT_EQ(hit.index.xIndex, expectedIndex.xIndex) << "ray " << n;
+		EXPECT_EQ(hit.index.yIndex, expectedIndex.yIndex) << "ray " << n;
+		EXPECT_NEAR(hit.distance, expectedDistance, 2.0f * kStep) << "ray " << n;
+	}
+	EXPECT_GT(hits, 1000u);
+}
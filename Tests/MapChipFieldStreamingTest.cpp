@@ -0,0 +1,251 @@
+#include "MapChipField.h"
+#include "TestMapFile.h"
+#include <filesystem>
+#include <gtest/gtest.h>
+
+namespace {
+
+// 256 x 64 のマップ（チャンクは横 8 x 縦 2）。一番下の行が地面、x = 200 の列が壁
+const uint32_t kMapWidth = 256;
+const uint32_t kMapHeight = 64;
+const uint32_t kWallX = 200;
+
+class MapChipFieldStreamingTest : public testing::Test {
+protected:
+	void SetUp() override {
+		const std::string csv = MakeMapCsv(kMapWidth, kMapHeight, [](uint32_t x, uint32_t y) { return (y == kMapHeight - 1 || x == kWallX) ? "1" : "0"; });
+		csvPath_ = WriteTemporaryFile("MapChipFieldStreamingTest.csv", csv);
+		binaryPath_ = (std::filesystem::temp_directory_path() / "MapChipFieldStreamingTest.mapbin").string();
+		std::filesystem::remove(binaryPath_);
+
+		field_.SetStreamingRadius(1);
+		field_.LoadMapChip(binaryPath_, csvPath_, true);
+	}
+
+	void TearDown() override {
+		std::error_code ec;
+		std::filesystem::remove(binaryPath_, ec);
+	}
+
+	// タイルの中心のワールド座標
+	KamataEngine::Vector3 TileCenter(uint32_t x, uint32_t y) { return field_.GetMapChipPositionByIndex(x, y); }
+
+	MapChipField field_;
+	std::string csvPath_;
+	std::string binaryPath_;
+};
+
+} // namespace
+
+TEST_F(MapChipFieldStreamingTest, MissingBinaryIsBakedAndStreamed) {
+	EXPECT_TRUE(field_.IsStreaming());
+	EXPECT_TRUE(std::filesystem::exists(binaryPath_));
+
+	// 読み込む前はどのチャンクも常駐していない
+	EXPECT_FALSE(field_.IsChunkResident(0, 0));
+	EXPECT_EQ(field_.GetStreamingStats().residentChunks, 0u);
+}
+
+TEST_F(MapChipFieldStreamingTest, NonResidentChunksReadAsBlankButCollideAsSolid) {
+	field_.UpdateStreaming(TileCenter(0, 40), true);
+	ASSERT_TRUE(field_.IsChunkResident(1, 1));
+	ASSERT_FALSE(field_.IsChunkResident(2, 1));
+
+	// タイルの読み出しでは、常駐していない壁は空白、常駐している地面はブロック
+	EXPECT_EQ(field_.GetMapChipTypeByIndex(kWallX, 40), MapChipType::kBlank);
+	EXPECT_EQ(field_.GetMapChipTypeByIndex(10, kMapHeight - 1), MapChipType::kBlock);
+
+	// 当たり判定では、常駐していないチャンク（x >= 64）の左端にブロックがあるものとして扱う
+	const uint32_t chunkLeft = 2 * MapChipField::kChunkSize;
+
+	MapChipRaycastHit hit;
+	ASSERT_TRUE(field_.Raycast(TileCenter(10, 40), {1.0f, 0.0f, 0.0f}, 2.0f * kMapWidth, hit));
+	EXPECT_EQ(hit.index.xIndex, chunkLeft);
+	EXPECT_EQ(hit.normal.x, -1.0f);
+
+	MapChipRaycastHit traced;
+	ASSERT_TRUE(field_.SphereTrace(TileCenter(10, 40), {1.0f, 0.0f, 0.0f}, 2.0f * kMapWidth, traced));
+	EXPECT_EQ(traced.index.xIndex, chunkLeft);
+
+	EXPECT_FALSE(field_.AnySolidInRow(40, 10, chunkLeft - 1));
+	EXPECT_TRUE(field_.AnySolidInRow(40, 10, chunkLeft));
+	EXPECT_TRUE(field_.IsRegionEmpty(10, 35, chunkLeft - 1, 40));
+	EXPECT_FALSE(field_.IsRegionEmpty(10, 35, chunkLeft, 40));
+	EXPECT_EQ(field_.FindNextSolidRight(40, 10), static_cast<int64_t>(chunkLeft));
+	EXPECT_EQ(field_.FindNextSolidLeft(40, kWallX), static_cast<int64_t>(kWallX));
+
+	const KamataEngine::Vector3 inside = TileCenter(10, 40);
+	const KamataEngine::Vector3 outside = TileCenter(100, 40);
+	const float xs[2] = {inside.x, outside.x};
+	const float ys[2] = {inside.y, outside.y};
+	uint8_t solid[2] = {};
+	field_.TestSolidPoints(xs, ys, 2, solid);
+	EXPECT_EQ(solid[0], 0);
+	EXPECT_EQ(solid[1], 1);
+
+	// 安全な距離は常駐していないチャンクの境界までに抑えられる
+	const KamataEngine::Vector3 nearEdge = TileCenter(chunkLeft - 3, 40);
+	const float boundary = TileCenter(chunkLeft, 40).x - MapChipField::kBlockWidth / 2.0f;
+	EXPECT_LE(field_.GetSafeDistance(nearEdge), boundary - nearEdge.x);
+	EXPECT_EQ(field_.GetSafeDistance(outside), 0.0f);
+}
+
+TEST_F(MapChipFieldStreamingTest, PlayerSweepTreatsNonResidentChunksAsSolid) {
+	field_.UpdateStreaming(TileCenter(0, 40), true);
+	ASSERT_TRUE(field_.IsChunkResident(1, 1));
+	ASSERT_FALSE(field_.IsChunkResident(2, 1));
+
+	// 常駐しているチャンクの端（x = 60）から右へ大きく動かすと、常駐していないチャンクの手前で止まる
+	const KamataEngine::Vector3 center = TileCenter(60, 40);
+	AABB box = {
+	    {center.x - 0.8f, center.y - 0.8f, 0.0f},
+        {center.x + 0.8f, center.y + 0.8f, 0.0f}
+    };
+	const MapChipSweepResult sweep = field_.SweepAABB(box, {20.0f, 0.0f, 0.0f});
+	EXPECT_TRUE(sweep.hitWall);
+	EXPECT_TRUE(sweep.hitWallRight);
+	const float chunkLeft = TileCenter(2 * MapChipField::kChunkSize, 40).x - MapChipField::kBlockWidth / 2.0f;
+	EXPECT_FLOAT_EQ(box.max.x + sweep.velocity.x, chunkLeft);
+}
+
+TEST_F(MapChipFieldStreamingTest, GroundProbeAgreesWithSweepAtChunkSeam) {
+	// 中心のチャンク (1, 0) だけを常駐させ、その下のチャンク (1, 1) は常駐させない
+	field_.SetStreamingRadius(0);
+	field_.UpdateStreaming(TileCenter(40, 16), true);
+	ASSERT_TRUE(field_.IsChunkResident(1, 0));
+	ASSERT_FALSE(field_.IsChunkResident(1, 1));
+
+	// チャンクの下端の行（yIndex = 31）から落とすと、常駐していないチャンクの上で着地する
+	const KamataEngine::Vector3 center = TileCenter(40, MapChipField::kChunkSize - 1);
+	const AABB box = {
+	    {center.x - 0.8f, center.y - 0.8f, 0.0f},
+        {center.x + 0.8f, center.y + 0.8f, 0.0f}
+    };
+	const float skin = 0.001f;
+	const MapChipSweepResult sweep = field_.SweepAABB(box, {0.0f, -5.0f, 0.0f}, skin);
+	ASSERT_TRUE(sweep.landing);
+
+	// 着地した箱は、足元の判定でも足場があるとみなされる（着地と落下を繰り返さない）
+	const AABB landed = {
+	    {box.min.x, box.min.y + sweep.velocity.y, 0.0f},
+        {box.max.x, box.max.y + sweep.velocity.y, 0.0f}
+    };
+	EXPECT_TRUE(field_.IsGroundBelow(landed, 0.06f));
+
+	// 足場の無い所では落ちる（常駐しているチャンクの中で、下に何も無い位置）
+	const KamataEngine::Vector3 air = TileCenter(40, 10);
+	const AABB floating = {
+	    {air.x - 0.8f, air.y - 0.8f, 0.0f},
+        {air.x + 0.8f, air.y + 0.8f, 0.0f}
+    };
+	EXPECT_FALSE(field_.IsGroundBelow(floating, 0.06f));
+}
+
+TEST_F(MapChipFieldStreamingTest, EditsApplyToResidentChunksUntilTheyAreFreed) {
+	field_.UpdateStreaming(TileCenter(0, 40), true);
+
+	// 常駐しているチャンクの変更は、タイルにも当たり判定にも反映される
+	field_.SetMapChipType(20, 40, MapChipType::kBlock);
+	EXPECT_EQ(field_.GetMapChipTypeByIndex(20, 40), MapChipType::kBlock);
+	EXPECT_TRUE(field_.AnySolidInRow(40, 10, 30));
+	MapChipRaycastHit hit;
+	ASSERT_TRUE(field_.Raycast(TileCenter(10, 40), {1.0f, 0.0f, 0.0f}, 100.0f, hit));
+	EXPECT_EQ(hit.index.xIndex, 20u);
+
+	// 常駐していないチャンクへの変更は無視する
+	field_.SetMapChipType(kWallX - 1, 40, MapChipType::kBlock);
+
+	// 離れて解放されると変更も消え、戻ってくるとファイルの内容で読み込み直す
+	field_.UpdateStreaming(TileCenter(kMapWidth - 1, 40), true);
+	EXPECT_FALSE(field_.IsChunkResident(0, 1));
+	EXPECT_EQ(field_.GetMapChipTypeByIndex(kWallX - 1, 40), MapChipType::kBlank);
+	field_.UpdateStreaming(TileCenter(0, 40), true);
+	EXPECT_EQ(field_.GetMapChipTypeByIndex(20, 40), MapChipType::kBlank);
+	EXPECT_FALSE(field_.AnySolidInRow(40, 10, 30));
+}
+
+TEST_F(MapChipFieldStreamingTest, StreamedMapCannotBeSaved) {
+	// マップ全体のタイルを持っていないので書き出せない
+	field_.UpdateStreaming(TileCenter(0, 40), true);
+	EXPECT_FALSE(field_.SaveMapChipBinary((std::filesystem::temp_directory_path() / "MapChipFieldStreamingTest.saved.mapbin").string()));
+}
+
+TEST_F(MapChipFieldStreamingTest, ResidentWallIsHitOnceLoaded) {
+	field_.UpdateStreaming(TileCenter(kWallX, 40), true);
+	ASSERT_TRUE(field_.IsChunkResident(kWallX / MapChipField::kChunkSize, 1));
+
+	MapChipRaycastHit hit;
+	ASSERT_TRUE(field_.Raycast(TileCenter(kWallX - 20, 40), {1.0f, 0.0f, 0.0f}, 100.0f, hit));
+	EXPECT_EQ(hit.index.xIndex, kWallX);
+}
+
+TEST_F(MapChipFieldStreamingTest, ChunkThatLeftRadiusWhileLoadingIsNotCommitted) {
+	// 左端の周りをリクエストし、読み込みを待たずに右端へ移る
+	field_.UpdateStreaming(TileCenter(0, 40));
+	field_.UpdateStreaming(TileCenter(kMapWidth - 1, 40), true);
+
+	// 左端のチャンクは常駐しておらず、タイルも空白のまま
+	EXPECT_FALSE(field_.IsChunkResident(0, 1));
+	EXPECT_EQ(field_.GetMapChipTypeByIndex(0, kMapHeight - 1), MapChipType::kBlank);
+
+	// 右端の周り（2 x 2 チャンク）だけが常駐する
+	const MapChipStreamingStats& stats = field_.GetStreamingStats();
+	EXPECT_EQ(stats.residentChunks, 4u);
+	EXPECT_EQ(stats.pendingChunks, 0u);
+	EXPECT_EQ(stats.loadedChunksTotal + stats.discardedChunksTotal, 8u);
+
+	// 戻ってくれば読み込み直す
+	field_.UpdateStreaming(TileCenter(0, 40), true);
+	EXPECT_TRUE(field_.IsChunkResident(0, 1));
+	EXPECT_EQ(field_.GetMapChipTypeByIndex(0, kMapHeight - 1), MapChipType::kBlock);
+}
+
+TEST_F(MapChipFieldStreamingTest, SetMapChipTypeReportsModifiedChunks) {
+	field_.UpdateStreaming(TileCenter(0, 40), true);
+	std::vector<MapChipChunkEvent> events;
+	field_.TakeChunkEvents(events);
+
+	// チャンクの内側のタイルは、そのチャンクだけ（同じフレームの変更は1つにまとめる）
+	field_.SetMapChipType(10, 40, MapChipType::kBlock);
+	field_.SetMapChipType(11, 40, MapChipType::kBlock);
+	field_.TakeChunkEvents(events);
+	ASSERT_EQ(events.size(), 1u);
+	EXPECT_EQ(events[0].chunkX, 0u);
+	EXPECT_EQ(events[0].chunkY, 1u);
+	EXPECT_EQ(events[0].type, MapChipChunkEventType::kModified);
+
+	// 種別が変わらなければイベントは出ない
+	field_.SetMapChipType(10, 40, MapChipType::kBlock);
+	field_.TakeChunkEvents(events);
+	EXPECT_TRUE(events.empty());
+
+	// チャンクの端のタイルは、面が出たり隠れたりする隣のチャンクにも出す
+	field_.SetMapChipType(MapChipField::kChunkSize - 1, MapChipField::kChunkSize, MapChipType::kBlock);
+	field_.TakeChunkEvents(events);
+	ASSERT_EQ(events.size(), 3u);
+	EXPECT_EQ(events[0].chunkX, 0u);
+	EXPECT_EQ(events[0].chunkY, 1u);
+	EXPECT_EQ(events[1].chunkX, 1u);
+	EXPECT_EQ(events[1].chunkY, 1u);
+	EXPECT_EQ(events[2].chunkX, 0u);
+	EXPECT_EQ(events[2].chunkY, 0u);
+
+	// 常駐していない隣のチャンク（x = 2）には出さない
+	field_.SetMapChipType(2 * MapChipField::kChunkSize - 1, 40, MapChipType::kBlock);
+	field_.TakeChunkEvents(events);
+	ASSERT_EQ(events.size(), 1u);
+	EXPECT_EQ(events[0].chunkX, 1u);
+}
+
+TEST(MapChipFieldChunkEventTest, SetMapChipTypeReportsModifiedChunkWithoutStreaming) {
+	MapChipField field;
+	field.LoadMapChipCsv(WriteTemporaryFile("MapChipFieldChunkEventTest.csv", MakeMapCsv(64, 64, [](uint32_t, uint32_t) { return "0"; })));
+
+	field.SetMapChipType(40, 5, MapChipType::kBlock);
+	std::vector<MapChipChunkEvent> events;
+	field.TakeChunkEvents(events);
+	ASSERT_EQ(events.size(), 1u);
+	EXPECT_EQ(events[0].chunkX, 1u);
+	EXPECT_EQ(events[0].chunkY, 0u);
+	EXPECT_EQ(events[0].type, MapChipChunkEventType::kModified);
+}
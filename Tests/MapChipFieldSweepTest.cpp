@@ -0,0 +1,178 @@
+#include "MapChipField.h"
+#include "TestMapFile.h"
+#include <gtest/gtest.h>
+
+namespace {
+
+// 24 x 16 の部屋。一番下の行が床、一番上の行が天井、左右の端の列が壁
+// 床の上の x = 12 に高さ 5 の薄い壁、(6, 8) に浮いたブロックが1つ
+const uint32_t kMapWidth = 24;
+const uint32_t kMapHeight = 16;
+const uint32_t kThinWallX = 12;
+const uint32_t kFloatingX = 6;
+const uint32_t kFloatingY = 8;
+
+// プレイヤーと同じくらいの箱の大きさの半分
+const float kHalfSize = 0.8f;
+
+class MapChipFieldSweepTest : public testing::Test {
+protected:
+	void SetUp() override {
+		const std::string csv = MakeMapCsv(kMapWidth, kMapHeight, [](uint32_t x, uint32_t y) {
+			if (y == 0 || y == kMapHeight - 1 || x == 0 || x == kMapWidth - 1) {
+				return "1";
+			}
+			if ((x == kThinWallX && y >= kMapHeight - 6) || (x == kFloatingX && y == kFloatingY)) {
+				return "1";
+			}
+			return "0";
+		});
+		field_.LoadMapChipCsv(WriteTemporaryFile("MapChipFieldSweepTest.csv", csv));
+	}
+
+	// タイルの中心に置いた箱
+	AABB BoxAt(uint32_t x, uint32_t y) {
+		const KamataEngine::Vector3 center = field_.GetMapChipPositionByIndex(x, y);
+		return {
+		    {center.x - kHalfSize, center.y - kHalfSize, 0.0f},
+            {center.x + kHalfSize, center.y + kHalfSize, 0.0f}
+        };
+	}
+
+	// タイルの境界
+	float TileLeft(uint32_t x) { return field_.GetMapChipPositionByIndex(x, 0).x - MapChipField::kBlockWidth / 2.0f; }
+	float TileRight(uint32_t x) { return TileLeft(x) + MapChipField::kBlockWidth; }
+	float TileBottom(uint32_t y) { return field_.GetMapChipPositionByIndex(0, y).y - MapChipField::kBlockHeight / 2.0f; }
+	float TileTop(uint32_t y) { return TileBottom(y) + MapChipField::kBlockHeight; }
+
+	MapChipField field_;
+};
+
+} // namespace
+
+TEST_F(MapChipFieldSweepTest, LandsOnFloor) {
+	const AABB box = BoxAt(4, 12);
+	const MapChipSweepResult sweep = field_.SweepAABB(box, {0.0f, -6.0f, 0.0f});
+	EXPECT_TRUE(sweep.landing);
+	EXPECT_FALSE(sweep.ceilingCollision);
+	EXPECT_FALSE(sweep.hitWall);
+	EXPECT_FLOAT_EQ(box.min.y + sweep.velocity.y, TileTop(kMapHeight - 1));
+}
+
+TEST_F(MapChipFieldSweepTest, FallingShortOfFloorKeepsVelocity) {
+	const MapChipSweepResult sweep = field_.SweepAABB(BoxAt(4, 12), {0.0f, -3.0f, 0.0f});
+	EXPECT_FALSE(sweep.landing);
+	EXPECT_FLOAT_EQ(sweep.velocity.y, -3.0f);
+}
+
+TEST_F(MapChipFieldSweepTest, StandingOnFloorLandsWithoutMoving) {
+	AABB box = BoxAt(4, 12);
+	const float drop = box.min.y - TileTop(kMapHeight - 1);
+	box.min.y -= drop;
+	box.max.y -= drop;
+
+	const MapChipSweepResult sweep = field_.SweepAABB(box, {0.0f, -0.01f, 0.0f});
+	EXPECT_TRUE(sweep.landing);
+	EXPECT_FLOAT_EQ(sweep.velocity.y, 0.0f);
+}
+
+TEST_F(MapChipFieldSweepTest, SlidingAlongFloorIsNotAWall) {
+	AABB box = BoxAt(4, 12);
+	const float drop = box.min.y - TileTop(kMapHeight - 1);
+	box.min.y -= drop;
+	box.max.y -= drop;
+
+	// 床の行とは辺が接しているだけなので、横に動いても壁にはならない
+	const MapChipSweepResult sweep = field_.SweepAABB(box, {3.0f, 0.0f, 0.0f});
+	EXPECT_FALSE(sweep.hitWall);
+	EXPECT_FLOAT_EQ(sweep.velocity.x, 3.0f);
+}
+
+TEST_F(MapChipFieldSweepTest, HitsCeiling) {
+	const AABB box = BoxAt(4, 2);
+	const MapChipSweepResult sweep = field_.SweepAABB(box, {0.0f, 5.0f, 0.0f});
+	EXPECT_TRUE(sweep.ceilingCollision);
+	EXPECT_FALSE(sweep.landing);
+	EXPECT_FLOAT_EQ(box.max.y + sweep.velocity.y, TileBottom(0));
+}
+
+TEST_F(MapChipFieldSweepTest, HitsRightWall) {
+	const AABB box = BoxAt(20, 4);
+	const MapChipSweepResult sweep = field_.SweepAABB(box, {10.0f, 0.0f, 0.0f});
+	EXPECT_TRUE(sweep.hitWall);
+	EXPECT_TRUE(sweep.hitWallRight);
+	EXPECT_FLOAT_EQ(box.max.x + sweep.velocity.x, TileLeft(kMapWidth - 1));
+}
+
+TEST_F(MapChipFieldSweepTest, HitsLeftWall) {
+	const AABB box = BoxAt(3, 4);
+	const MapChipSweepResult sweep = field_.SweepAABB(box, {-10.0f, 0.0f, 0.0f});
+	EXPECT_TRUE(sweep.hitWall);
+	EXPECT_FALSE(sweep.hitWallRight);
+	EXPECT_FLOAT_EQ(box.min.x + sweep.velocity.x, TileRight(0));
+}
+
+TEST_F(MapChipFieldSweepTest, SkinKeepsGapToBlock) {
+	const AABB box = BoxAt(4, 12);
+	const MapChipSweepResult sweep = field_.SweepAABB(box, {0.0f, -6.0f, 0.0f}, 0.1f);
+	EXPECT_TRUE(sweep.landing);
+	EXPECT_NEAR(box.min.y + sweep.velocity.y, TileTop(kMapHeight - 1) + 0.1f, 1.0e-5f);
+}
+
+TEST_F(MapChipFieldSweepTest, FallThenMoveIntoWall) {
+	// 縦に動いた後の箱で横を調べるので、床まで落ちてから薄い壁に当たる（壁は床から5段）
+	const AABB box = BoxAt(4, 3);
+	const MapChipSweepResult sweep = field_.SweepAABB(box, {40.0f, -40.0f, 0.0f});
+	EXPECT_TRUE(sweep.landing);
+	EXPECT_TRUE(sweep.hitWall);
+	EXPECT_TRUE(sweep.hitWallRight);
+	EXPECT_FLOAT_EQ(box.min.y + sweep.velocity.y, TileTop(kMapHeight - 1));
+	EXPECT_FLOAT_EQ(box.max.x + sweep.velocity.x, TileLeft(kThinWallX));
+}
+
+TEST_F(MapChipFieldSweepTest, StartingInsideBlockIgnoresThatBlock) {
+	// 浮いたブロックに重なった箱は、そのブロックには当たらない
+	const AABB box = BoxAt(kFloatingX, kFloatingY);
+	const MapChipSweepResult sideways = field_.SweepAABB(box, {3.0f, 0.0f, 0.0f});
+	EXPECT_FALSE(sideways.hitWall);
+	EXPECT_FLOAT_EQ(sideways.velocity.x, 3.0f);
+
+	// 下へ抜ければ床に着地する
+	const MapChipSweepResult down = field_.SweepAABB(box, {0.0f, -40.0f, 0.0f});
+	EXPECT_TRUE(down.landing);
+	EXPECT_FLOAT_EQ(box.min.y + down.velocity.y, TileTop(kMapHeight - 1));
+}
+
+// 1フレームの移動量が大きくても薄い壁・床を抜けない
+class MapChipFieldSweepSpeedTest : public MapChipFieldSweepTest, public testing::WithParamInterface<float> {};
+
+TEST_P(MapChipFieldSweepSpeedTest, DoesNotTunnelThroughThinWall) {
+	const float speed = GetParam();
+	const AABB box = BoxAt(4, 13);
+	const MapChipSweepResult sweep = field_.SweepAABB(box, {speed, 0.0f, 0.0f});
+
+	const float wallLeft = TileLeft(kThinWallX);
+	if (box.max.x + speed < wallLeft) {
+		EXPECT_FALSE(sweep.hitWall);
+		EXPECT_FLOAT_EQ(sweep.velocity.x, speed);
+	} else {
+		EXPECT_TRUE(sweep.hitWall);
+		EXPECT_FLOAT_EQ(box.max.x + sweep.velocity.x, wallLeft);
+	}
+}
+
+TEST_P(MapChipFieldSweepSpeedTest, DoesNotTunnelThroughFloor) {
+	const float speed = GetParam();
+	const AABB box = BoxAt(4, 2);
+	const MapChipSweepResult sweep = field_.SweepAABB(box, {0.0f, -speed, 0.0f});
+
+	const float floorTop = TileTop(kMapHeight - 1);
+	if (box.min.y - speed > floorTop) {
+		EXPECT_FALSE(sweep.landing);
+	} else {
+		EXPECT_TRUE(sweep.landing);
+		EXPECT_FLOAT_EQ(box.min.y + sweep.velocity.y, floorTop);
+	}
+}
+
+INSTANTIATE_TEST_SUITE_P(Speeds, MapChipFieldSweepSpeedTest, testing::Values(0.5f, 2.0f, 10.0f, 20.0f, 100.0f, 1000.0f));
@@ -0,0 +1,107 @@
+#include "MapChipOccupancyPyramid.h"
+#include "TestMapFile.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+
+namespace {
+
+// 範囲（両端を含む。マップ外は空白）にブロックが無いかをタイルを1つずつ見て調べる
+bool ScanRegionEmpty(const MapChipData& data, uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1) {
+	for (uint32_t y = y0; y <= y1 && y < data.height; ++y) {
+		for (uint32_t x = x0; x <= x1 && x < data.width; ++x) {
+			if (data.Data[static_cast<size_t>(y) * data.width + x] == MapChipType::kBlock) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// 広さのばらばらな範囲（1タイルからマップより大きいものまで）を選ぶ
+void RandomRegion(std::mt19937& rng, uint32_t width, uint32_t height, uint32_t& x0, uint32_t& y0, uint32_t& x1, uint32_t& y1) {
+	const uint32_t sizeX = 1u << (rng() % 8);
+	const uint32_t sizeY = 1u << (rng() % 8);
+	x0 = rng() % width;
+	y0 = rng() % height;
+	x1 = x0 + rng() % sizeX;
+	y1 = y0 + rng() % sizeY;
+}
+
+} // namespace
+
+TEST(MapChipOccupancyPyramidTest, MatchesScanAfterRandomRegionEdits) {
+	// 2 の累乗でない大きさ（端のセルが欠ける）
+	for (uint32_t seed = 0; seed < 10; ++seed) {
+		std::mt19937 rng(seed);
+		MapChipData data;
+		data.width = 100 + rng() % 60;
+		data.height = 37 + rng() % 30;
+		data.Data.assign(static_cast<size_t>(data.width) * data.height, MapChipType::kBlank);
+		for (uint32_t i = 0; i < 20; ++i) {
+			data.Data[rng() % data.Data.size()] = MapChipType::kBlock;
+		}
+
+		MapChipOccupancyPyramid pyramid;
+		pyramid.Build(data);
+
+		for (uint32_t round = 0; round < 200; ++round) {
+			// 矩形を塗る（空白で消すことも多めにして、空になったセルも通す）
+			uint32_t x0, y0, x1, y1;
+			RandomRegion(rng, data.width, data.height, x0, y0, x1, y1);
+			x1 = std::min(x1, x0 + 3);
+			y1 = std::min(y1, y0 + 3);
+			x1 = std::min(x1, data.width - 1);
+			y1 = std::min(y1, data.height - 1);
+			const MapChipType type = (rng() % 3 == 0) ? MapChipType::kBlock : MapChipType::kBlank;
+			for (uint32_t y = y0; y <= y1; ++y) {
+				for (uint32_t x = x0; x <= x1; ++x) {
+					data.Data[static_cast<size_t>(y) * data.width + x] = type;
+				}
+			}
+			pyramid.UpdateRegion(x0, y0, x1 - x0 + 1, y1 - y0 + 1);
+
+			// 問い合わせ
+			for (uint32_t query = 0; query < 20; ++query) {
+				RandomRegion(rng, data.width, data.height, x0, y0, x1, y1);
+				ASSERT_EQ(pyramid.IsRegionEmpty(x0, y0, x1, y1), ScanRegionEmpty(data, x0, y0, x1, y1)) << "seed " << seed << " round " << round << " (" << x0 << "," << y0 << ")-(" << x1 << "," << y1 << ")";
+			}
+
+			// 空のレベルとして返したセルは本当に空
+			const uint32_t x = rng() % data.width;
+			const uint32_t y = rng() % data.height;
+			const uint32_t level = pyramid.GetEmptyLevel(x, y);
+			if (level > 0) {
+				const uint32_t cellX0 = (x >> level) << level;
+				const uint32_t cellY0 = (y >> level) << level;
+				ASSERT_TRUE(ScanRegionEmpty(data, cellX0, cellY0, cellX0 + (1u << level) - 1, cellY0 + (1u << level) - 1)) << "seed " << seed << " round " << round;
+			}
+		}
+	}
+}
+
+TEST(MapChipOccupancyPyramidTest, FieldRegionQueryMatchesScanAfterSetMapChipType) {
+	// MapChipField::SetMapChipType を通した変更（ピラミッドは1タイルずつ作り直される）
+	const uint32_t width = 200;
+	const uint32_t height = 50;
+	MapChipField field;
+	field.LoadMapChipCsv(WriteTemporaryFile("MapChipOccupancyPyramidTest.csv", MakeMapCsv(width, height, [](uint32_t x, uint32_t y) { return ((x * 13 + y * 7) % 97 == 0) ? "1" : "0"; })));
+
+	std::mt19937 rng(7);
+	for (uint32_t round = 0; round < 2000; ++round) {
+		field.SetMapChipType(rng() % width, rng() % height, (rng() % 2) ? MapChipType::kBlock : MapChipType::kBlank);
+
+		uint32_t x0, y0, x1, y1;
+		RandomRegion(rng, width, height, x0, y0, x1, y1);
+		x1 = std::min(x1, width - 1);
+		y1 = std::min(y1, height - 1);
+
+		bool expected = true;
+		for (uint32_t y = y0; y <= y1 && expected; ++y) {
+			for (uint32_t x = x0; x <= x1 && expected; ++x) {
+				expected = field.GetMapChipTypeByIndex(x, y) != MapChipType::kBlock;
+			}
+		}
+		ASSERT_EQ(field.IsRegionEmpty(x0, y0, x1, y1), expected) << "round " << round;
+	}
+}
@@ -0,0 +1,131 @@
+#include "ProjectileSystem.h"
+#include "TestMapFile.h"
+#include <gtest/gtest.h>
+#include <random>
+
+namespace {
+
+// 64 x 24 のマップ。上下の端の行と x = 40 の列（厚さ1タイル）がブロック
+const uint32_t kMapWidth = 64;
+const uint32_t kMapHeight = 24;
+const uint32_t kWallX = 40;
+
+class ProjectileSystemSweptTest : public testing::TestWithParam<float> {
+protected:
+	void SetUp() override {
+		const std::string csv = MakeMapCsv(kMapWidth, kMapHeight, [](uint32_t x, uint32_t y) { return (x == kWallX || y == 0 || y == kMapHeight - 1) ? "1" : "0"; });
+		field_.LoadMapChipCsv(WriteTemporaryFile("ProjectileSystemSweptTest.csv", csv));
+
+		projectiles_.Initialize(64);
+		projectiles_.SetMapChipField(&field_);
+	}
+
+	// 弾を出して速度を設定する（向きは速度と同じ）
+	Bullet Fire(const KamataEngine::Vector3& position, const KamataEngine::Vector3& velocity, bool swept, bool persistent) {
+		Bullet bullet = projectiles_.Spawn(&model_, position, {1.0f, 0.0f, 0.0f});
+		bullet.SetVelocity(velocity);
+		bullet.SetSwept(swept);
+		bullet.SetPersistent(persistent);
+		return bullet;
+	}
+
+	// 壁の左の面の x
+	float WallLeft() { return field_.GetMapChipPositionByIndex(kWallX, 0).x - MapChipField::kBlockWidth / 2.0f; }
+
+	// 壁の右の面の x
+	float WallRight() { return WallLeft() + MapChipField::kBlockWidth; }
+
+	MapChipField field_;
+	KamataEngine::Model model_;
+	ProjectileSystem projectiles_;
+};
+
+// 弾が止まるか、消えるか、壁の右まで抜けるまで進める
+void RunUntilStopped(ProjectileSystem& projectiles, Bullet& bullet, float wallRight) {
+	for (uint32_t frame = 0; frame < 600; ++frame) {
+		projectiles.Update();
+		if (bullet.IsDead() || bullet.IsHooked() || bullet.GetPosition().x > wallRight) {
+			return;
+		}
+	}
+}
+
+} // namespace
+
+// 1フレームに進む距離（既定の弾速から 10 まで）
+INSTANTIATE_TEST_SUITE_P(Speeds, ProjectileSystemSweptTest, testing::Values(ProjectileSystem::kBulletSpeed, 1.0f, 2.0f, 3.7f, 5.0f, 7.5f, 10.0f));
+
+TEST_P(ProjectileSystemSweptTest, WireHookStopsExactlyOnWallFace) {
+	// 壁の手前 5 から撃つ（点で調べると速い弾は壁の中に入る前に抜ける位置）
+	const KamataEngine::Vector3 start = {WallLeft() - 5.0f, field_.GetMapChipPositionByIndex(0, 12).y, 0.0f};
+	Bullet hook = Fire(start, {GetParam(), 0.0f, 0.0f}, true, true);
+	RunUntilStopped(projectiles_, hook, WallRight());
+
+	ASSERT_TRUE(hook.IsValid());
+	ASSERT_TRUE(hook.IsHooked());
+	EXPECT_FALSE(hook.IsDead());
+	EXPECT_FLOAT_EQ(hook.GetPosition().x, WallLeft());
+	EXPECT_FLOAT_EQ(hook.GetPosition().y, start.y);
+	EXPECT_FLOAT_EQ(hook.GetSpeed().x, 0.0f);
+
+	// 刺さった後は動かない
+	projectiles_.Update();
+	EXPECT_FLOAT_EQ(hook.GetPosition().x, WallLeft());
+}
+
+TEST_P(ProjectileSystemSweptTest, SweptBulletDiesAtWallFace) {
+	const KamataEngine::Vector3 start = {WallLeft() - 5.0f, field_.GetMapChipPositionByIndex(0, 12).y, 0.0f};
+	Bullet bullet = Fire(start, {GetParam(), 0.0f, 0.0f}, true, false);
+	RunUntilStopped(projectiles_, bullet, WallRight());
+
+	ASSERT_TRUE(bullet.IsValid());
+	EXPECT_TRUE(bullet.IsDead());
+	EXPECT_FALSE(bullet.IsHooked());
+	EXPECT_FLOAT_EQ(bullet.GetPosition().x, WallLeft());
+}
+
+TEST_P(ProjectileSystemSweptTest, HookPointMatchesFineStepMarchAtRandomAngles) {
+	// 壁に向かってランダムな角度で撃ち、細かい刻みで進めたときに最初にブロックに入る点と比べる
+	const float speed = GetParam();
+	std::mt19937 rng(static_cast<uint32_t>(speed * 100.0f));
+	std::uniform_real_distribution<float> angle(-1.2f, 1.2f);
+	std::uniform_real_distribution<float> startY(4.0f, 40.0f);
+
+	for (uint32_t n = 0; n < 200; ++n) {
+		const float a = angle(rng);
+		const KamataEngine::Vector3 direction = {std::cos(a), std::sin(a), 0.0f};
+		const KamataEngine::Vector3 start = {WallLeft() - 20.0f, startY(rng), 0.0f};
+
+		IndexSet expectedIndex;
+		float expectedDistance;
+		ASSERT_TRUE(MarchToFirstBlock(field_, start, direction, 200.0f, 1.0e-3f, expectedIndex, expectedDistance));
+
+		Bullet hook = Fire(start, {direction.x * speed, direction.y * speed, 0.0f}, true, true);
+		RunUntilStopped(projectiles_, hook, WallRight());
+		ASSERT_TRUE(hook.IsHooked()) << "angle " << a;
+
+		const KamataEngine::Vector3 position = hook.GetPosition();
+		EXPECT_NEAR(position.x, start.x + direction.x * expectedDistance, 2.0e-3f) << "angle " << a;
+		EXPECT_NEAR(position.y, start.y + direction.y * expectedDistance, 2.0e-3f) << "angle " << a;
+		hook.Kill();
+		projectiles_.ReleaseDead();
+	}
+}
+
+TEST(ProjectileSystemPointTest, FastBulletTunnelsWithoutSweep) {
+	// 点で調べる既定のやり方では、1フレームで壁の厚さより進む弾は抜ける（速い弾は SetSwept が必要な理由）
+	MapChipField field;
+	field.LoadMapChipCsv(WriteTemporaryFile("ProjectileSystemPointTest.csv", MakeMapCsv(kMapWidth, kMapHeight, [](uint32_t x, uint32_t) { return x == kWallX ? "1" : "0"; })));
+	ProjectileSystem projectiles;
+	projectiles.Initialize(4);
+	projectiles.SetMapChipField(&field);
+
+	KamataEngine::Model model;
+	const float wallLeft = field.GetMapChipPositionByIndex(kWallX, 0).x - MapChipField::kBlockWidth / 2.0f;
+	Bullet bullet = projectiles.Spawn(&model, {wallLeft - 5.0f, field.GetMapChipPositionByIndex(0, 12).y, 0.0f}, {1.0f, 0.0f, 0.0f});
+	bullet.SetVelocity({10.0f, 0.0f, 0.0f});
+
+	projectiles.Update();
+	EXPECT_FALSE(bullet.IsDead());
+	EXPECT_GT(bullet.GetPosition().x, wallLeft + MapChipField::kBlockWidth);
+}
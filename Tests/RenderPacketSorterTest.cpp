@@ -0,0 +1,275 @@
+#include "MapChipChunkMesh.h"
+#include "MapChipField.h"
+#include "MapChipMeshBuilder.h"
+#include "RecordingRenderBackend.h"
+#include "RenderPacketSorter.h"
+#include "RenderQueue.h"
+#include "TestMapFile.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+using Command = RecordingRenderBackend::Command;
+
+// テスト用のレンダラー（中身は使わず、アドレスで区別するだけ）
+InstancedModelRenderer* FakeRenderer(uintptr_t id) { return reinterpret_cast<InstancedModelRenderer*>(id * 64); }
+
+// パイプラインの組（カリング・ブレンド・深度テスト）
+const RenderPipelineKey kOpaque = {0, 1, 0};
+const RenderPipelineKey kAlpha = {0, 0, 0};
+const RenderPipelineKey kNoCull = {2, 1, 0};
+
+// Model::Draw 1回分
+RenderPacket ModelPacket(const RenderPipelineKey& pipelineKey, uint32_t materialId, uint32_t depth = 0, RenderLayer layer = RenderLayer::kOpaque) {
+	RenderPacket packet;
+	packet.type = RenderPacket::Type::kModel;
+	packet.pipelineKey = pipelineKey;
+	packet.key = RenderPacketSorter::MakeKey(layer, 0, pipelineKey, materialId, depth);
+	return packet;
+}
+
+// インスタンス描画1回分（レンダラーの番号は 1 から）
+RenderPacket InstancedPacket(uint32_t rendererId, uint32_t instanceCount, uint32_t depth = 0) {
+	RenderPacket packet;
+	packet.type = RenderPacket::Type::kInstanced;
+	packet.pipelineKey = kOpaque;
+	packet.renderer = FakeRenderer(rendererId);
+	packet.instanceCount = instanceCount;
+	packet.key = RenderPacketSorter::MakeKey(RenderLayer::kOpaque, rendererId, kOpaque, 0, depth);
+	return packet;
+}
+
+// 記録した描画を順に取り出す
+std::vector<RenderPacket> DrawnPackets(const RecordingRenderBackend& backend) {
+	std::vector<RenderPacket> packets;
+	for (const Command& command : backend.GetCommands()) {
+		if (command.type == Command::Type::kDraw) {
+			packets.push_back(command.packet);
+		}
+	}
+	return packets;
+}
+
+} // namespace
+
+TEST(RenderPacketSorterTest, SortingCollapsesInterleavedPipelines) {
+	RenderPacketSorter sorter;
+	const RenderPipelineKey keys[] = {kOpaque, kAlpha, kNoCull};
+	for (uint32_t i = 0; i < 30; ++i) {
+		sorter.Push(ModelPacket(keys[i % 3], i % 3));
+	}
+
+	RecordingRenderBackend backend;
+	sorter.Execute(backend);
+
+	// 積まれた順なら毎回切り替わるが、並べ替えると組ごとに1回
+	const RenderPacketSorter::Stats& stats = sorter.GetStats();
+	EXPECT_EQ(stats.packets, 30u);
+	EXPECT_EQ(stats.unsortedPipelineSwitches, 30u);
+	EXPECT_EQ(stats.pipelineSwitches, 3u);
+	EXPECT_EQ(stats.passes, 3u);
+	EXPECT_EQ(backend.CountCommands(Command::Type::kBeginPass), 3u);
+	EXPECT_EQ(backend.CountCommands(Command::Type::kEndPass), 3u);
+	EXPECT_EQ(backend.CountCommands(Command::Type::kDraw), 30u);
+}
+
+TEST(RenderPacketSorterTest, InstancedRenderersAreBoundOncePerFrame) {
+	RenderPacketSorter sorter;
+	for (uint32_t i = 0; i < 10; ++i) {
+		sorter.Push(InstancedPacket(1 + i % 2, 4));
+		sorter.Push(ModelPacket(kOpaque, 0));
+	}
+
+	RecordingRenderBackend backend;
+	sorter.Execute(backend);
+
+	// Model::Draw のパスを1つ開き、その後でレンダラーを1つずつ切り替える
+	const RenderPacketSorter::Stats& stats = sorter.GetStats();
+	EXPECT_EQ(stats.passes, 1u);
+	EXPECT_EQ(stats.pipelineSwitches, 3u);
+	EXPECT_GT(stats.unsortedPipelineSwitches, stats.pipelineSwitches);
+	EXPECT_EQ(backend.CountCommands(Command::Type::kBindRenderer), 2u);
+	EXPECT_EQ(backend.CountCommands(Command::Type::kUnbindRenderer), 2u);
+
+	// 切り替えの順番（パス → モデル → レンダラー1 → レンダラー2 → パスの終わり）
+	const std::vector<Command>& commands = backend.GetCommands();
+	ASSERT_FALSE(commands.empty());
+	EXPECT_EQ(commands.front().type, Command::Type::kBeginPass);
+	EXPECT_EQ(commands.back().type, Command::Type::kEndPass);
+	const InstancedModelRenderer* bound = nullptr;
+	for (const Command& command : commands) {
+		if (command.type == Command::Type::kBindRenderer) {
+			EXPECT_EQ(bound, nullptr);
+			bound = command.renderer;
+		} else if (command.type == Command::Type::kUnbindRenderer) {
+			EXPECT_EQ(command.renderer, bound);
+			bound = nullptr;
+		} else if (command.type == Command::Type::kDraw && command.packet.type != RenderPacket::Type::kModel) {
+			EXPECT_EQ(command.packet.renderer, bound);
+		}
+	}
+}
+
+TEST(RenderPacketSorterTest, ModelAfterInstancedReopensPass) {
+	RenderPacketSorter sorter;
+	sorter.Push(InstancedPacket(1, 4));
+	sorter.Push(ModelPacket(kOpaque, 0, 0, RenderLayer::kSky));
+
+	RecordingRenderBackend backend;
+	sorter.Execute(backend);
+
+	// インスタンス描画のパイプラインのままでは Model::Draw できないので、パスを開き直す
+	const std::vector<Command>& commands = backend.GetCommands();
+	std::vector<Command::Type> types;
+	for (const Command& command : commands) {
+		types.push_back(command.type);
+	}
+	const std::vector<Command::Type> expected = {
+	    Command::Type::kBeginPass, Command::Type::kBindRenderer, Command::Type::kDraw,    Command::Type::kUnbindRenderer,
+	    Command::Type::kEndPass,   Command::Type::kBeginPass,    Command::Type::kDraw,    Command::Type::kEndPass,
+	};
+	EXPECT_EQ(types, expected);
+	EXPECT_EQ(sorter.GetStats().passes, 2u);
+}
+
+TEST(RenderPacketSorterTest, SkyLayerIsDrawnLast) {
+	RenderPacketSorter sorter;
+	sorter.Push(ModelPacket(kOpaque, 5, 0, RenderLayer::kSky));
+	sorter.Push(ModelPacket(kAlpha, 1));
+	sorter.Push(InstancedPacket(3, 8));
+	sorter.Push(ModelPacket(kOpaque, 2));
+
+	RecordingRenderBackend backend;
+	sorter.Execute(backend);
+
+	const std::vector<RenderPacket> drawn = DrawnPackets(backend);
+	ASSERT_EQ(drawn.size(), 4u);
+	EXPECT_EQ(drawn.back().sequence, 0u);
+	EXPECT_EQ(drawn.back().key >> RenderPacketSorter::kLayerShift, static_cast<uint64_t>(RenderLayer::kSky));
+}
+
+TEST(RenderPacketSorterTest, NearerPacketsAreDrawnFirstWithinPipeline) {
+	RenderPacketSorter sorter;
+	sorter.Push(ModelPacket(kOpaque, 0, 300));
+	sorter.Push(ModelPacket(kOpaque, 0, 100));
+	sorter.Push(ModelPacket(kOpaque, 0, 200));
+
+	RecordingRenderBackend backend;
+	sorter.Execute(backend);
+
+	const std::vector<RenderPacket> drawn = DrawnPackets(backend);
+	ASSERT_EQ(drawn.size(), 3u);
+	EXPECT_EQ(drawn[0].sequence, 1u);
+	EXPECT_EQ(drawn[1].sequence, 2u);
+	EXPECT_EQ(drawn[2].sequence, 0u);
+}
+
+TEST(RenderPacketSorterTest, EqualKeysKeepSubmissionOrder) {
+	RenderPacketSorter sorter;
+	for (uint32_t i = 0; i < 16; ++i) {
+		sorter.Push(ModelPacket(kOpaque, 0, 0));
+	}
+
+	RecordingRenderBackend backend;
+	sorter.Execute(backend);
+
+	const std::vector<RenderPacket> drawn = DrawnPackets(backend);
+	ASSERT_EQ(drawn.size(), 16u);
+	for (uint32_t i = 0; i < drawn.size(); ++i) {
+		EXPECT_EQ(drawn[i].sequence, i);
+	}
+}
+
+TEST(RenderPacketSorterTest, EmptyFrameEmitsNothing) {
+	RenderPacketSorter sorter;
+	RecordingRenderBackend backend;
+	sorter.Execute(backend);
+
+	EXPECT_TRUE(backend.GetCommands().empty());
+	EXPECT_EQ(sorter.GetStats().pipelineSwitches, 0u);
+
+	// Clear で前のフレームの描画は残らない
+	sorter.Push(ModelPacket(kOpaque, 0));
+	sorter.Clear();
+	sorter.Execute(backend);
+	EXPECT_TRUE(backend.GetCommands().empty());
+}
+
+TEST(RenderPacketSorterTest, VisibleChunkMeshesDrawOncePerChunk) {
+	// 96 x 64 のマップ（チャンクは横 3 x 縦 2）。下 10 段がすべてブロック、左上のチャンクに足場、右上のチャンクに柱、中央上のチャンクは空
+	const uint32_t width = 96;
+	const uint32_t height = 64;
+	MapChipField field;
+	field.LoadMapChipCsv(WriteTemporaryFile("RenderPacketSorterTest.csv", MakeMapCsv(width, height, [&](uint32_t x, uint32_t y) {
+		const bool floor = y >= height - 10;
+		const bool platform = y >= 5 && y <= 6 && x >= 4 && x <= 20;
+		const bool pillar = x == 80 && y >= 10 && y < 32;
+		return (floor || platform || pillar) ? "1" : "0";
+	})));
+
+	// チャンクごとのメッシュを作る（GameScene::GenerateChunkBlocks と同じ）
+	const uint32_t numChunkX = field.GetNumChunkHorizontal();
+	const uint32_t numChunkY = field.GetNumChunkVirtical();
+	ASSERT_EQ(numChunkX, 3u);
+	ASSERT_EQ(numChunkY, 2u);
+	std::vector<MapChipChunkMesh> meshes(numChunkX * numChunkY);
+	MapChipMesh scratch;
+	for (uint32_t chunkY = 0; chunkY < numChunkY; ++chunkY) {
+		for (uint32_t chunkX = 0; chunkX < numChunkX; ++chunkX) {
+			MapChipMeshBuilder::BuildChunk(field, chunkX, chunkY, scratch);
+			meshes[chunkY * numChunkX + chunkX].Create(scratch);
+		}
+	}
+
+	// 左の 2 x 2 チャンクだけが映る矩形で、映っているチャンクを描画キューに積む（GameScene::Draw と同じ）
+	const RangeRect visibleRect = {-1.0f, 2.0f * 64 - 2.0f, -1.0f, 2.0f * height - 2.0f};
+	IndexSet minIndex;
+	IndexSet maxIndex;
+	ASSERT_TRUE(field.GetIndexRangeInRect(visibleRect, minIndex, maxIndex));
+
+	KamataEngine::Camera camera;
+	ModelInstanceBuffer faceUVs;
+	KamataEngine::Material& material = *reinterpret_cast<KamataEngine::Material*>(uintptr_t(64));
+	RenderQueue queue;
+	queue.Begin(camera);
+	for (uint32_t chunkY = minIndex.yIndex / MapChipField::kChunkSize; chunkY <= maxIndex.yIndex / MapChipField::kChunkSize; ++chunkY) {
+		for (uint32_t chunkX = minIndex.xIndex / MapChipField::kChunkSize; chunkX <= maxIndex.xIndex / MapChipField::kChunkSize; ++chunkX) {
+			const MapChipChunkMesh& mesh = meshes[chunkY * numChunkX + chunkX];
+			const KamataEngine::Vector3 center = field.GetMapChipPositionByIndex(chunkX * MapChipField::kChunkSize + MapChipField::kChunkSize / 2, chunkY * MapChipField::kChunkSize + MapChipField::kChunkSize / 2);
+			queue.SubmitInstancedIndexed(*FakeRenderer(1), mesh.GetVBView(), mesh.GetIBView(), mesh.GetIndexCount(), material, faceUVs, 1, center);
+		}
+	}
+
+	RecordingRenderBackend backend;
+	queue.Execute(backend);
+
+	// ブロックが何個あっても、映っていてブロックのあるチャンク（左上・左下・中央下）ごとに1回だけ描く
+	const uint32_t drawnChunks[] = {0 * numChunkX + 0, 1 * numChunkX + 0, 1 * numChunkX + 1};
+	EXPECT_EQ(backend.CountCommands(Command::Type::kDraw), 3u);
+	EXPECT_EQ(backend.CountCommands(Command::Type::kBindRenderer), 1u);
+	EXPECT_EQ(meshes[1].GetIndexCount(), 0u);
+
+	const std::vector<RenderPacket> drawn = DrawnPackets(backend);
+	for (uint32_t chunkIndex : drawnChunks) {
+		const MapChipChunkMesh& mesh = meshes[chunkIndex];
+		EXPECT_GT(mesh.GetBlockCount(), 1u) << "chunk " << chunkIndex;
+
+		uint32_t draws = 0;
+		for (const RenderPacket& packet : drawn) {
+			if (packet.vbView == &mesh.GetVBView()) {
+				++draws;
+				EXPECT_EQ(packet.type, RenderPacket::Type::kInstancedIndexed);
+				EXPECT_EQ(packet.indexCount, mesh.GetIndexCount());
+				EXPECT_EQ(packet.instanceCount, 1u);
+			}
+		}
+		EXPECT_EQ(draws, 1u) << "chunk " << chunkIndex;
+	}
+
+	// 映っていない右のチャンクは描かない
+	for (const RenderPacket& packet : drawn) {
+		EXPECT_NE(packet.vbView, &meshes[2].GetVBView());
+		EXPECT_NE(packet.vbView, &meshes[numChunkX + 2].GetVBView());
+	}
+}
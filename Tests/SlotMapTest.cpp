@@ -0,0 +1,192 @@
+#include "SlotMap.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// SlotMap と同じ並びで中身を持つ（Release で返された位置から詰める）
+struct Pool {
+	SlotMap slots;
+	std::vector<int> values;
+
+	void Initialize(uint32_t capacity) {
+		slots.Initialize(capacity);
+		values.assign(capacity, 0);
+	}
+
+	SlotHandle Add(int value) {
+		const SlotHandle handle = slots.Allocate();
+		if (handle.generation != 0) {
+			values[slots.GetCount() - 1] = value;
+		}
+		return handle;
+	}
+
+	void Remove(const SlotHandle& handle) {
+		const uint32_t i = slots.Find(handle);
+		ASSERT_NE(i, SlotMap::kInvalid);
+		const uint32_t last = slots.Release(i);
+		if (i != last) {
+			values[i] = values[last];
+		}
+	}
+
+	// ハンドルの中身（無効なハンドルなら nullptr）
+	const int* Get(const SlotHandle& handle) const {
+		const uint32_t i = slots.Find(handle);
+		return (i == SlotMap::kInvalid) ? nullptr : &values[i];
+	}
+};
+
+} // namespace
+
+TEST(SlotMapTest, AllocatedHandlesResolveToDenseRange) {
+	Pool pool;
+	pool.Initialize(4);
+
+	const SlotHandle a = pool.Add(10);
+	const SlotHandle b = pool.Add(20);
+
+	EXPECT_EQ(pool.slots.GetCount(), 2u);
+	EXPECT_EQ(pool.slots.Find(a), 0u);
+	EXPECT_EQ(pool.slots.Find(b), 1u);
+	EXPECT_EQ(pool.slots.GetHandle(1), b);
+	EXPECT_EQ(*pool.Get(a), 10);
+	EXPECT_EQ(*pool.Get(b), 20);
+}
+
+TEST(SlotMapTest, DefaultHandleIsNeverValid) {
+	Pool pool;
+	pool.Initialize(4);
+	pool.Add(10);
+
+	// 世代 0 はどのスロットにも一致しない
+	EXPECT_EQ(pool.slots.Find(SlotHandle{}), SlotMap::kInvalid);
+	EXPECT_EQ(pool.slots.Find(SlotHandle{100, 1}), SlotMap::kInvalid);
+}
+
+TEST(SlotMapTest, ReleasedHandleResolvesToInvalid) {
+	Pool pool;
+	pool.Initialize(4);
+
+	const SlotHandle a = pool.Add(10);
+	pool.Remove(a);
+
+	EXPECT_EQ(pool.slots.GetCount(), 0u);
+	EXPECT_EQ(pool.Get(a), nullptr);
+}
+
+TEST(SlotMapTest, ReusedSlotDoesNotRevivePreviousHandle) {
+	Pool pool;
+	pool.Initialize(1);
+
+	const SlotHandle a = pool.Add(10);
+	pool.Remove(a);
+	const SlotHandle b = pool.Add(20);
+
+	// 同じスロットが使い回されても世代が違う
+	EXPECT_EQ(b.index, a.index);
+	EXPECT_NE(b.generation, a.generation);
+	EXPECT_EQ(pool.Get(a), nullptr);
+	ASSERT_NE(pool.Get(b), nullptr);
+	EXPECT_EQ(*pool.Get(b), 20);
+}
+
+TEST(SlotMapTest, ReleaseMovesLastIntoHole) {
+	Pool pool;
+	pool.Initialize(4);
+
+	const SlotHandle a = pool.Add(10);
+	const SlotHandle b = pool.Add(20);
+	const SlotHandle c = pool.Add(30);
+
+	pool.Remove(a);
+
+	// 末尾の c が空いた先頭に移り、ハンドルはそのまま c を指す
+	EXPECT_EQ(pool.slots.Find(c), 0u);
+	EXPECT_EQ(pool.slots.Find(b), 1u);
+	EXPECT_EQ(*pool.Get(c), 30);
+	EXPECT_EQ(*pool.Get(b), 20);
+}
+
+TEST(SlotMapTest, SwapKeepsHandlesPointingAtTheirContents) {
+	Pool pool;
+	pool.Initialize(4);
+
+	const SlotHandle a = pool.Add(10);
+	const SlotHandle b = pool.Add(20);
+
+	pool.slots.Swap(0, 1);
+	std::swap(pool.values[0], pool.values[1]);
+
+	EXPECT_EQ(pool.slots.Find(a), 1u);
+	EXPECT_EQ(pool.slots.Find(b), 0u);
+	EXPECT_EQ(*pool.Get(a), 10);
+	EXPECT_EQ(*pool.Get(b), 20);
+}
+
+TEST(SlotMapTest, FullMapReturnsInvalidHandle) {
+	Pool pool;
+	pool.Initialize(2);
+
+	pool.Add(10);
+	pool.Add(20);
+	const SlotHandle full = pool.Add(30);
+
+	EXPECT_EQ(full.generation, 0u);
+	EXPECT_EQ(pool.slots.Find(full), SlotMap::kInvalid);
+	EXPECT_EQ(pool.slots.GetCount(), 2u);
+}
+
+TEST(SlotMapTest, InitializeInvalidatesPreviousHandles) {
+	Pool pool;
+	pool.Initialize(2);
+	const SlotHandle a = pool.Add(10);
+
+	pool.Initialize(2);
+	const SlotHandle b = pool.Add(20);
+
+	EXPECT_EQ(b.index, a.index);
+	EXPECT_EQ(pool.Get(a), nullptr);
+	EXPECT_EQ(*pool.Get(b), 20);
+}
+
+TEST(SlotMapTest, RandomChurnMatchesReference) {
+	Pool pool;
+	pool.Initialize(64);
+
+	// 生きているハンドルと中身、返したハンドル
+	std::vector<std::pair<SlotHandle, int>> alive;
+	std::vector<SlotHandle> released;
+
+	std::mt19937 rng(1234);
+	int next = 0;
+	for (int step = 0; step < 200000; ++step) {
+		if (alive.empty() || (alive.size() < 64 && rng() % 2 == 0)) {
+			const SlotHandle handle = pool.Add(next);
+			ASSERT_NE(handle.generation, 0u);
+			alive.emplace_back(handle, next++);
+		} else {
+			const size_t k = rng() % alive.size();
+			pool.Remove(alive[k].first);
+			released.push_back(alive[k].first);
+			alive[k] = alive.back();
+			alive.pop_back();
+		}
+
+		if (step % 1000 == 0) {
+			ASSERT_EQ(pool.slots.GetCount(), alive.size());
+			for (const auto& [handle, value] : alive) {
+				const int* found = pool.Get(handle);
+				ASSERT_NE(found, nullptr);
+				ASSERT_EQ(*found, value);
+			}
+			for (const SlotHandle& handle : released) {
+				ASSERT_EQ(pool.Get(handle), nullptr);
+			}
+			released.clear();
+		}
+	}
+}
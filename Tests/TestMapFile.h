@@ -0,0 +1,58 @@
+#pragma once
+// テストとベンチマークで使うマップの CSV を作る
+#include "MapChipField.h"
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+/// <summary>
+/// 幅 width、高さ height のマップの CSV を作る（tokenAt(x, y) がタイルのトークン "0" / "1" / "E1" などを返す）
+/// </summary>
+template<typename TokenAt> std::string MakeMapCsv(uint32_t width, uint32_t height, TokenAt tokenAt) {
+	std::string csv;
+	csv.reserve(static_cast<size_t>(width) * height * 2);
+	for (uint32_t y = 0; y < height; ++y) {
+		for (uint32_t x = 0; x < width; ++x) {
+			csv += tokenAt(x, y);
+			csv += (x + 1 < width) ? ',' : '\n';
+		}
+	}
+	return csv;
+}
+
+/// <summary>
+/// 一時ディレクトリにファイルを書き出してパスを返す
+/// </summary>
+inline std::string WriteTemporaryFile(const std::string& name, const std::string& contents) {
+	const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+	std::ofstream(path, std::ios::binary | std::ios::trunc) << contents;
+	return path.string();
+}
+
+/// <summary>
+/// 始点から step ごとに点を進め、最初にブロックのタイルに入った点を返す（Raycast などの基準にする、タイルを1点ずつ調べるやり方）
+/// </summary>
+/// <returns>maxDistance 以内でブロックに入ったら true</returns>
+inline bool MarchToFirstBlock(const MapChipField& field, const KamataEngine::Vector3& origin, const KamataEngine::Vector3& direction, float maxDistance, float step, IndexSet& index, float& distance) {
+	const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+	const float dirX = direction.x / length;
+	const float dirY = direction.y / length;
+	const int64_t height = field.GetNumBlockVirtical();
+	for (float t = 0.0f; t <= maxDistance; t += step) {
+		const int64_t cellX = static_cast<int64_t>(std::floor((origin.x + dirX * t + MapChipField::kBlockWidth / 2.0f) / MapChipField::kBlockWidth));
+		const int64_t cellY = static_cast<int64_t>(std::floor((origin.y + dirY * t + MapChipField::kBlockHeight / 2.0f) / MapChipField::kBlockHeight));
+		if (cellX < 0 || cellY < 0 || cellY >= height) {
+			continue;
+		}
+		const uint32_t xIndex = static_cast<uint32_t>(cellX);
+		const uint32_t yIndex = static_cast<uint32_t>(height - 1 - cellY);
+		if (field.GetMapChipTypeByIndex(xIndex, yIndex) == MapChipType::kBlock) {
+			index = {xIndex, yIndex};
+			distance = t;
+			return true;
+		}
+	}
+	return false;
+}
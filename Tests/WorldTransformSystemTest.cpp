@@ -0,0 +1,139 @@
+#include "WorldTransformSystem.h"
+#include <gtest/gtest.h>
+
+namespace {
+
+// 行列の平行移動成分
+KamataEngine::Vector3 TranslationOf(const KamataEngine::WorldTransform& worldTransform) {
+	return {worldTransform.matWorld_.m[3][0], worldTransform.matWorld_.m[3][1], worldTransform.matWorld_.m[3][2]};
+}
+
+void ExpectTranslation(const KamataEngine::WorldTransform& worldTransform, float x, float y, float z) {
+	const KamataEngine::Vector3 translation = TranslationOf(worldTransform);
+	EXPECT_FLOAT_EQ(translation.x, x);
+	EXPECT_FLOAT_EQ(translation.y, y);
+	EXPECT_FLOAT_EQ(translation.z, z);
+}
+
+} // namespace
+
+TEST(WorldTransformSystemTest, RebuildsOnlyChangedTransforms) {
+	WorldTransformSystem system;
+	KamataEngine::WorldTransform a;
+	KamataEngine::WorldTransform b;
+	system.Register(a);
+	system.Register(b);
+
+	// 登録直後は必ず作る
+	system.Update();
+	EXPECT_EQ(system.GetStats().registeredTransforms, 2u);
+	EXPECT_EQ(system.GetStats().rebuiltMatrices, 2u);
+	EXPECT_EQ(system.GetStats().uploadedBytes, 2 * sizeof(KamataEngine::ConstBufferDataWorldTransform));
+
+	// 変わっていなければ作らない
+	system.Update();
+	EXPECT_EQ(system.GetStats().rebuiltMatrices, 0u);
+	EXPECT_EQ(system.GetStats().uploadedBytes, 0u);
+
+	// 変えたものだけ作る
+	a.translation_ = {1.0f, 2.0f, 3.0f};
+	system.Update();
+	EXPECT_EQ(system.GetStats().rebuiltMatrices, 1u);
+	ExpectTranslation(a, 1.0f, 2.0f, 3.0f);
+
+	b.scale_ = {2.0f, 2.0f, 2.0f};
+	b.rotation_.y = 0.5f;
+	system.Update();
+	EXPECT_EQ(system.GetStats().rebuiltMatrices, 1u);
+	EXPECT_NE(b.matWorld_.m[0][0], 1.0f);
+}
+
+TEST(WorldTransformSystemTest, MarkDirtyForcesRebuild) {
+	WorldTransformSystem system;
+	KamataEngine::WorldTransform a;
+	system.Register(a);
+	system.Update();
+
+	system.MarkDirty(a);
+	system.Update();
+	EXPECT_EQ(system.GetStats().rebuiltMatrices, 1u);
+
+	// 作り直した後は元に戻る
+	system.Update();
+	EXPECT_EQ(system.GetStats().rebuiltMatrices, 0u);
+
+	// 登録済みのものを登録し直すと作り直す
+	system.Register(a);
+	system.Update();
+	EXPECT_EQ(system.GetStats().registeredTransforms, 1u);
+	EXPECT_EQ(system.GetStats().rebuiltMatrices, 1u);
+}
+
+TEST(WorldTransformSystemTest, ParentChangePropagatesToChildren) {
+	WorldTransformSystem system;
+	KamataEngine::WorldTransform root;
+	KamataEngine::WorldTransform child;
+	KamataEngine::WorldTransform grandchild;
+	child.parent_ = &root;
+	grandchild.parent_ = &child;
+	child.translation_ = {1.0f, 0.0f, 0.0f};
+	grandchild.translation_ = {0.0f, 1.0f, 0.0f};
+
+	// 子を先に登録しても、親を先に確定させてから子を作る
+	system.Register(grandchild);
+	system.Register(child);
+	system.Register(root);
+	system.Update();
+	ExpectTranslation(grandchild, 1.0f, 1.0f, 0.0f);
+
+	// 親だけを動かすと、子と孫も作り直される
+	root.translation_ = {10.0f, 20.0f, 30.0f};
+	system.Update();
+	EXPECT_EQ(system.GetStats().rebuiltMatrices, 3u);
+	ExpectTranslation(root, 10.0f, 20.0f, 30.0f);
+	ExpectTranslation(child, 11.0f, 20.0f, 30.0f);
+	ExpectTranslation(grandchild, 11.0f, 21.0f, 30.0f);
+
+	// 孫だけを動かしても、親は作り直さない
+	grandchild.translation_ = {0.0f, 2.0f, 0.0f};
+	system.Update();
+	EXPECT_EQ(system.GetStats().rebuiltMatrices, 1u);
+	ExpectTranslation(grandchild, 11.0f, 22.0f, 30.0f);
+}
+
+TEST(WorldTransformSystemTest, UnregisteredParentMatrixChangeIsDetected) {
+	// 登録されていない親でも、行列が変われば子を作り直す
+	WorldTransformSystem system;
+	KamataEngine::WorldTransform parent;
+	Math math;
+	parent.matWorld_ = math.MakeAffineMatrix({1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f});
+	KamataEngine::WorldTransform child;
+	child.parent_ = &parent;
+	child.translation_ = {1.0f, 0.0f, 0.0f};
+	system.Register(child);
+	system.Update();
+	ExpectTranslation(child, 1.0f, 0.0f, 0.0f);
+
+	parent.matWorld_ = math.MakeAffineMatrix({1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f}, {5.0f, 0.0f, 0.0f});
+	system.Update();
+	EXPECT_EQ(system.GetStats().rebuiltMatrices, 1u);
+	ExpectTranslation(child, 6.0f, 0.0f, 0.0f);
+}
+
+TEST(WorldTransformSystemTest, UnregisteredTransformIsNoLongerUpdated) {
+	WorldTransformSystem system;
+	KamataEngine::WorldTransform a;
+	KamataEngine::WorldTransform b;
+	system.Register(a);
+	system.Register(b);
+	system.Update();
+
+	system.Unregister(a);
+	a.translation_ = {1.0f, 0.0f, 0.0f};
+	b.translation_ = {2.0f, 0.0f, 0.0f};
+	system.Update();
+	EXPECT_EQ(system.GetStats().registeredTransforms, 1u);
+	EXPECT_EQ(system.GetStats().rebuiltMatrices, 1u);
+	ExpectTranslation(a, 0.0f, 0.0f, 0.0f);
+	ExpectTranslation(b, 2.0f, 0.0f, 0.0f);
+}